@@ -57,11 +57,14 @@
 #include "mfem/general/forall.hpp"
 #include "mechanics_log.hpp"
 #include "system_driver.hpp"
+#include "mechanics_mesh.hpp"
 #include "BCData.hpp"
 #include "BCManager.hpp"
 #include "option_parser.hpp"
 #include <string>
 #include <sstream>
+#include <algorithm>
+#include <vector>
 
 using namespace std;
 using namespace mfem;
@@ -233,6 +236,9 @@ int main(int argc, char *argv[])
    }
    // declare pointer to parallel mesh object
    ParMesh *pmesh = NULL;
+   // The meshes of each of our parallel refinement levels below pmesh ordered from
+   // coarsest to finest, which are only kept around for our geometric multigrid.
+   Array<ParMesh*> coarse_meshes;
    {
       Mesh mesh;
       Vector g_map;
@@ -281,6 +287,14 @@ int main(int argc, char *argv[])
          setElementGrainIDs(&mesh, g_map, 1, 0);
       }
 
+      // Our elements already carry their grain ids as their attributes at this point, so our
+      // grain map, state variables, and outputs all follow our elements when they're reordered.
+      // This is why we can't make use of the space-filling ordering of MakeCartesian3D, as the
+      // grain map is laid out in the lexicographic ordering.
+      if (toml_opt.elem_ordering != ElementOrdering::NONE) {
+         reorderMeshLocality(&mesh, toml_opt.elem_ordering);
+      }
+
       // We need to check to see if our provided mesh has a different order than
       // the order provided. If we see a difference we either increase our order seen
       // in the options file or we increase the mesh ordering. I'm pretty sure this
@@ -311,7 +325,17 @@ int main(int argc, char *argv[])
 
       pmesh = new ParMesh(MPI_COMM_WORLD, mesh);
       for (int lev = 0; lev < toml_opt.par_ref_levels; lev++) {
-         pmesh->UniformRefinement();
+         if (toml_opt.precond == PreconditionerType::GMG) {
+            // Each level is refined from a copy of the one below it, so every mesh in our
+            // hierarchy knows how it was obtained from its parent.
+            ParMesh *fine_mesh = new ParMesh(*pmesh);
+            fine_mesh->UniformRefinement();
+            coarse_meshes.Append(pmesh);
+            pmesh = fine_mesh;
+         }
+         else {
+            pmesh->UniformRefinement();
+         }
       }
 
    } // Mesh related calls
@@ -605,7 +629,7 @@ int main(int argc, char *argv[])
                      toml_opt, matVars0,
                      matVars1, sigma0, sigma1, matGrd,
                      kinVars0, q_vonMises, &elemMatVars, x_ref, x_beg, x_cur,
-                     matProps, matVarsOffset);
+                     matProps, matVarsOffset, coarse_meshes);
 
    if (toml_opt.visit || toml_opt.conduit || toml_opt.paraview || toml_opt.adios2) {
       oper.ProjectVolume(volume);
@@ -969,6 +993,9 @@ int main(int argc, char *argv[])
 
    // Free the used memory.
    delete pmesh;
+   for (int lev = 0; lev < coarse_meshes.Size(); lev++) {
+      delete coarse_meshes[lev];
+   }
    // Now find out how long everything took to run roughly
    double end = MPI_Wtime();
 
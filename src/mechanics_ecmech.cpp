@@ -101,13 +101,12 @@ void kernel_setup(const int npts, const int nstatev,
 
 // Retrieves the stress and reorders it into the desired 6 vec format. A copy of that vector
 // is sent back to the CPU for the time being. It also stores all of the state variables into their
-// appropriate vector. Finally, it saves off the material tangent stiffness vector. In the future,
-// if PA is used then the 4D 3x3x3x3 tensor is saved off rather than the 6x6 2D matrix.
+// appropriate vector. The material tangent stiffness matrix is dealt with separately in
+// kernel_tangent_postprocessing, since it's only needed when our gradient is formed.
 void kernel_postprocessing(const int npts, const int nstatev, const double dt, const double* dEff,
                            const double* stress_svec_p_array, const double* vol_ratio_array,
                            const double* eng_int_array, const double* beg_state_vars_array,
-                           double* state_vars_array, double* stress_array,
-                           double* ddsdde_array, Assembly assembly)
+                           double* state_vars_array, double* stress_array)
 {
    const int ind_int_eng = nstatev - ecmech::ne;
    const int ind_pl_work = ecmech::evptn::iHistA_flowStr;
@@ -150,7 +149,11 @@ void kernel_postprocessing(const int npts, const int nstatev, const double dt, c
          stress[1] += stress_mean;
          stress[2] += stress_mean;
       }); // end of npts loop
+} // end of post-processing func
 
+// Saves off the material tangent stiffness matrix in the column major order our integrators expect.
+void kernel_tangent_postprocessing(const int npts, double* ddsdde_array, Assembly assembly)
+{
    // No need to transpose this if running on the GPU and doing EA
    if ((assembly == Assembly::EA) and mfem::Device::Allows(Backend::DEVICE_MASK)) { return; }
    else
@@ -169,7 +172,7 @@ void kernel_postprocessing(const int npts, const int nstatev, const double dt, c
          }
       });
    }
-} // end of post-processing func
+} // end of tangent post-processing func
 
 // The different CPU, OpenMP, and GPU kernels aren't needed here, since they're
 // defined in ExaCMech itself.
@@ -253,6 +256,13 @@ void ExaCMechModel::ModelSetup(const int nqpts, const int nelems, const int /*sp
    CALI_MARK_BEGIN("ecmech_postprocessing");
    kernel_postprocessing(npts, nstatev, dt, dEff, stress_svec_p_array_data,
                          vol_ratio_array_data, eng_int_array_data, state_vars_beg, state_vars_array,
-                         stress_array, ddsdde_array, assembly);
+                         stress_array);
    CALI_MARK_END("ecmech_postprocessing");
 } // End of ModelSetup function
+
+void ExaCMechModel::FinalizeMatGrad()
+{
+   CALI_CXX_MARK_SCOPE("ecmech_tangent_postprocessing");
+   const int npts = matGrad->Size() / matGrad->GetVDim();
+   kernel_tangent_postprocessing(npts, matGrad->ReadWrite(), assembly);
+}
@@ -99,10 +99,17 @@ class ExaCMechModel : public ExaModel
                               const int nnodes, const mfem::Vector &jacobian,
                               const mfem::Vector &loc_grad, const mfem::Vector &vel);
 
+      /// ExaCMech returns its material tangent stiffness matrix in row major order so we
+      /// transpose it here.
+      virtual void FinalizeMatGrad() override;
+
       /// If we needed to do anything to our state variables once things are solved
       /// for we do that here.
       virtual void UpdateModelVars(){}
 
+      /// The ExaCMech material tangent has both major and minor symmetry
+      virtual bool SymmetricMatGrad() const override { return true; }
+
       virtual void calcDpMat(mfem::QuadratureFunction &DpMat) const = 0;
 };
 
@@ -2,6 +2,7 @@
 #include "mfem.hpp"
 #include "mfem/general/forall.hpp"
 #include "mechanics_integrators.hpp"
+#include "mechanics_kernels.hpp"
 #include "mechanics_log.hpp"
 #include "BCManager.hpp"
 #include <math.h> // log
@@ -155,22 +156,127 @@ void ExaNLFIntegrator::AssembleElementGrad(
    return;
 }
 
+// The integration rule used by our PA and EA kernels
+const IntegrationRule &ExaNLFIntegrator::GetKernelIntRule(const FiniteElement &el) const
+{
+   if (IntRule) {
+      return *IntRule;
+   }
+   return IntRules.Get(el.GetGeomType(), 2 * el.GetOrder() + 1);
+}
+
+// The sum-factorized kernels are only used for tensor-product hexahedral elements
+// where our integration rule is the tensor product of a 1D rule. Our element vectors
+// still live in the NATIVE ordering, so we also keep the lexicographic to native
+// node map around rather than requiring a LEXICOGRAPHIC element restriction.
+void ExaNLFIntegrator::SetupTensorBasis(const FiniteElement &el, const IntegrationRule &ir)
+{
+   tensor_kernels = false;
+   const TensorBasisElement *tel = dynamic_cast<const TensorBasisElement *>(&el);
+   if ((tel == nullptr) || (el.GetGeomType() != Geometry::CUBE)) {
+      return;
+   }
+
+   const DofToQuad &maps = el.GetDofToQuad(ir, DofToQuad::TENSOR);
+   ndofs1d = maps.ndof;
+   nqpts1d = maps.nqpt;
+
+   if ((ndofs1d > exaconstit::kernel::TENSOR_MAX_D1D) ||
+       (nqpts1d > exaconstit::kernel::TENSOR_MAX_Q1D) ||
+       ((ndofs1d * ndofs1d * ndofs1d) != nnodes) ||
+       ((nqpts1d * nqpts1d * nqpts1d) != nqpts)) {
+      return;
+   }
+
+   basis1d.SetSize(nqpts1d * ndofs1d, mfem::Device::GetMemoryType());
+   dbasis1d.SetSize(nqpts1d * ndofs1d, mfem::Device::GetMemoryType());
+   {
+      const double *B = maps.B.HostRead();
+      const double *G = maps.G.HostRead();
+      double *basis = basis1d.HostWrite();
+      double *dbasis = dbasis1d.HostWrite();
+      for (int i = 0; i < nqpts1d * ndofs1d; i++) {
+         basis[i] = B[i];
+         dbasis[i] = G[i];
+      }
+   }
+   basis1d.UseDevice(true);
+   dbasis1d.UseDevice(true);
+
+   // An empty dof map means the native and lexicographic orderings are the same
+   const Array<int> &native_map = tel->GetDofMap();
+   dof_map.SetSize(nnodes, mfem::Device::GetMemoryType());
+   {
+      int *map = dof_map.HostWrite();
+      for (int i = 0; i < nnodes; i++) {
+         map[i] = (native_map.Size() > 0) ? native_map[i] : i;
+      }
+   }
+
+   tensor_kernels = true;
+}
+
+// Forms our jacobian from the mesh geometric factors in the (dim, dim, nqpts, nelems)
+// col. major layout the rest of our kernels expect. If we've been handed a shared
+// jacobian the owner of it is responsible for keeping it up to date instead.
+void ExaNLFIntegrator::SetupJacobian(const FiniteElementSpace &fes, const IntegrationRule &ir)
+{
+   if (shared_jacobian) {
+      return;
+   }
+
+   const int dim = 3;
+   geom = fes.GetMesh()->GetGeometricFactors(ir, GeometricFactors::JACOBIANS);
+
+   // geom->J really isn't going to work for us as of right now. We could just reorder it
+   // to the version that we want it to be in instead...
+   if (jacobian.Size() != (dim * dim * nqpts * nelems)) {
+      jacobian.SetSize(dim * dim * nqpts * nelems, mfem::Device::GetMemoryType());
+      jacobian.UseDevice(true);
+   }
+
+   const int DIM4 = 4;
+   std::array<RAJA::idx_t, DIM4> perm4 {{ 3, 2, 1, 0 } };
+
+   RAJA::Layout<DIM4> layout_jacob = RAJA::make_permuted_layout({{ dim, dim, nqpts, nelems } }, perm4);
+   RAJA::View<double, RAJA::Layout<DIM4, RAJA::Index_type, 0> > J(jacobian.Write(), layout_jacob);
+
+   RAJA::Layout<DIM4> layout_geom = RAJA::make_permuted_layout({{ nqpts, dim, dim, nelems } }, perm4);
+   RAJA::View<const double, RAJA::Layout<DIM4, RAJA::Index_type, 0> > geom_j_view(geom->J.Read(), layout_geom);
+   const int nqpts_ = nqpts;
+   const int dim_ = dim;
+   MFEM_FORALL(i, nelems, {
+      for (int j = 0; j < nqpts_; j++) {
+         for (int k = 0; k < dim_; k++) {
+            for (int l = 0; l < dim_; l++) {
+               J(l, k, j, i) = geom_j_view(j, l, k, i);
+            }
+         }
+      }
+   });
+}
+
+void ExaNLFIntegrator::SetSharedJacobian(mfem::Vector &jac)
+{
+   jacobian.MakeRef(jac, 0, jac.Size());
+   jacobian.UseDevice(true);
+   shared_jacobian = true;
+}
+
 // This performs the assembly step of our RHS side of our system:
 // f_ik =
 void ExaNLFIntegrator::AssemblePA(const FiniteElementSpace &fes)
 {
    CALI_CXX_MARK_SCOPE("enlfi_assemblePA");
-   Mesh *mesh = fes.GetMesh();
    const FiniteElement &el = *fes.GetFE(0);
    space_dims = el.GetDim();
-   const IntegrationRule *ir = &(IntRules.Get(el.GetGeomType(), 2 * el.GetOrder() + 1));
+   const IntegrationRule *ir = &GetKernelIntRule(el);
 
    nqpts = ir->GetNPoints();
    nnodes = el.GetDof();
    nelems = fes.GetNE();
 
    auto W = ir->GetWeights().Read();
-   geom = mesh->GetGeometricFactors(*ir, GeometricFactors::JACOBIANS);
 
    // return a pointer to beginning step stress. This is used for output visualization
    QuadratureFunction *stress_end = model->GetStress1();
@@ -194,14 +300,10 @@ void ExaNLFIntegrator::AssemblePA(const FiniteElementSpace &fes)
             }
          }
          grad.UseDevice(true);
+         SetupTensorBasis(el, *ir);
       }
 
-      // geom->J really isn't going to work for us as of right now. We could just reorder it
-      // to the version that we want it to be in instead...
-      if (jacobian.Size() != (dim * dim * nqpts * nelems)) {
-         jacobian.SetSize(dim * dim * nqpts * nelems, mfem::Device::GetMemoryType());
-         jacobian.UseDevice(true);
-      }
+      SetupJacobian(fes, *ir);
 
       if (dmat.Size() != (dim * dim * nqpts * nelems)) {
          dmat.SetSize(dim * dim * nqpts * nelems, mfem::Device::GetMemoryType());
@@ -215,7 +317,7 @@ void ExaNLFIntegrator::AssemblePA(const FiniteElementSpace &fes)
       std::array<RAJA::idx_t, DIM3> perm3 {{ 2, 1, 0 } };
 
       RAJA::Layout<DIM4> layout_jacob = RAJA::make_permuted_layout({{ dim, dim, nqpts, nelems } }, perm4);
-      RAJA::View<double, RAJA::Layout<DIM4, RAJA::Index_type, 0> > J(jacobian.ReadWrite(), layout_jacob);
+      RAJA::View<const double, RAJA::Layout<DIM4, RAJA::Index_type, 0> > J(jacobian.Read(), layout_jacob);
 
       RAJA::Layout<DIM3> layout_stress = RAJA::make_permuted_layout({{ 2 * dim, nqpts, nelems } }, perm3);
       RAJA::View<const double, RAJA::Layout<DIM3, RAJA::Index_type, 0> > S(stress_end->ReadWrite(),
@@ -223,19 +325,8 @@ void ExaNLFIntegrator::AssemblePA(const FiniteElementSpace &fes)
 
       RAJA::View<double, RAJA::Layout<DIM4, RAJA::Index_type, 0> > D(dmat.ReadWrite(), layout_jacob);
 
-      RAJA::Layout<DIM4> layout_geom = RAJA::make_permuted_layout({{ nqpts, dim, dim, nelems } }, perm4);
-      RAJA::View<const double, RAJA::Layout<DIM4, RAJA::Index_type, 0> > geom_j_view(geom->J.Read(), layout_geom);
       const int nqpts_ = nqpts;
       const int dim_ = dim;
-      MFEM_FORALL(i, nelems, {
-         for (int j = 0; j < nqpts_; j++) {
-            for (int k = 0; k < dim_; k++) {
-               for (int l = 0; l < dim_; l++) {
-                  J(l, k, j, i) = geom_j_view(j, l, k, i);
-               }
-            }
-         }
-      });
 
       MFEM_FORALL(i_elems, nelems, {
          double adj[dim_ * dim_];
@@ -331,10 +422,9 @@ void ExaNLFIntegrator::AssembleGradPA(const mfem::Vector &/* x */, const FiniteE
 void ExaNLFIntegrator::AssembleGradPA(const FiniteElementSpace &fes)
 {
    CALI_CXX_MARK_SCOPE("enlfi_assemblePAG");
-   Mesh *mesh = fes.GetMesh();
    const FiniteElement &el = *fes.GetFE(0);
    space_dims = el.GetDim();
-   const IntegrationRule *ir = &(IntRules.Get(el.GetGeomType(), 2 * el.GetOrder() + 1));
+   const IntegrationRule *ir = &GetKernelIntRule(el);
 
    nqpts = ir->GetNPoints();
    nnodes = el.GetDof();
@@ -360,156 +450,242 @@ void ExaNLFIntegrator::AssembleGradPA(const FiniteElementSpace &fes)
             }
          }
          grad.UseDevice(true);
+         SetupTensorBasis(el, *ir);
       }
 
-      // geom->J really isn't going to work for us as of right now. We could just reorder it
-      // to the version that we want it to be in instead...
+      // Our jacobian normally comes from AssemblePA
       if (jacobian.Size() != (dim * dim * nqpts * nelems)) {
-         jacobian.SetSize(dim * dim * nqpts * nelems, mfem::Device::GetMemoryType());
-         jacobian.UseDevice(true);
-
-         geom = mesh->GetGeometricFactors(*ir, GeometricFactors::JACOBIANS);
-
-         const int DIM4 = 4;
-         std::array<RAJA::idx_t, DIM4> perm4 {{ 3, 2, 1, 0 } };
-
-         RAJA::Layout<DIM4> layout_jacob = RAJA::make_permuted_layout({{ dim, dim, nqpts, nelems } }, perm4);
-         RAJA::View<double, RAJA::Layout<DIM4, RAJA::Index_type, 0> > J(jacobian.ReadWrite(), layout_jacob);
-
-         RAJA::Layout<DIM4> layout_geom = RAJA::make_permuted_layout({{ nqpts, dim, dim, nelems } }, perm4);
-         RAJA::View<const double, RAJA::Layout<DIM4, RAJA::Index_type, 0> > geom_j_view(geom->J.Read(), layout_geom);
-         const int nqpts_ = nqpts;
-	 const int dim_ = dim;
-         MFEM_FORALL(i, nelems, {
-            for (int j = 0; j < nqpts_; j++) {
-               for (int k = 0; k < dim_; k++) {
-                  for (int l = 0; l < dim_; l++) {
-                     J(l, k, j, i) = geom_j_view(j, l, k, i);
-                  }
-               }
-            }
-         });
+         SetupJacobian(fes, *ir);
       }
 
-      if (pa_dmat.Size() != (dim * dim * dim * dim * nqpts * nelems)) {
-         pa_dmat.SetSize(dim * dim * dim * dim * nqpts * nelems, mfem::Device::GetMemoryType());
+      // If our material tangent has major symmetry we only need to store the unique
+      // entries of D as it can then be viewed as a symmetric 9x9 matrix.
+      pa_dmat_sym = model->SymmetricMatGrad();
+      const int dsize = pa_dmat_sym ? exaconstit::kernel::PA_TAN_SYM_SIZE : dim * dim * dim * dim;
+
+      if (pa_dmat.Size() != (dsize * nqpts * nelems)) {
+         pa_dmat.SetSize(dsize * nqpts * nelems, mfem::Device::GetMemoryType());
          pa_dmat.UseDevice(true);
       }
 
-      pa_dmat = 0.0;
-
-      const int DIM2 = 2;
-      const int DIM4 = 4;
-      const int DIM6 = 6;
-      std::array<RAJA::idx_t, DIM6> perm6 {{ 5, 4, 3, 2, 1, 0 } };
-      std::array<RAJA::idx_t, DIM4> perm4 {{ 3, 2, 1, 0 } };
-      std::array<RAJA::idx_t, DIM2> perm2 {{ 1, 0 } };
-
-      // bunch of helper RAJA views to make dealing with data easier down below in our kernel.
-
-      RAJA::Layout<DIM6> layout_4Dtensor = RAJA::make_permuted_layout({{ dim, dim, dim, dim, nqpts, nelems } }, perm6);
-      RAJA::View<const double, RAJA::Layout<DIM6, RAJA::Index_type, 0> > C(model->GetMTanData(), layout_4Dtensor);
-      // Swapped over to row order since it makes sense in later applications...
-      // Should make C row order as well for PA operations
-      RAJA::View<double, RAJA::Layout<DIM6> > D(pa_dmat.ReadWrite(), nelems, nqpts, dim, dim, dim, dim);
-
-      RAJA::Layout<DIM4> layout_jacob = RAJA::make_permuted_layout({{ dim, dim, nqpts, nelems } }, perm4);
-      RAJA::View<double, RAJA::Layout<DIM4, RAJA::Index_type, 0> > J(jacobian.ReadWrite(), layout_jacob);
+      if (pa_diag == nullptr) {
+         AssembleGradPAKernel<false>(W);
+         return;
+      }
+      if (tensor_kernels) {
+         switch ((ndofs1d << 4) | nqpts1d) {
+            case 0x22: AssembleGradPAKernel<true, true, 2, 2>(W); return;
+            case 0x33: AssembleGradPAKernel<true, true, 3, 3>(W); return;
+            case 0x44: AssembleGradPAKernel<true, true, 4, 4>(W); return;
+            default:
+               if (GenericTensorKernels()) {
+                  AssembleGradPAKernel<true, true>(W);
+                  return;
+               }
+               break;
+         }
+      }
+      AssembleGradPAKernel<true>(W);
+   } // End of else statement
+}
 
-      RAJA::Layout<DIM2> layout_adj = RAJA::make_permuted_layout({{ dim, dim } }, perm2);
+// The D_{ijkm} kernel of AssembleGradPA. When T_DIAG is set we also add the diagonal of
+// our gradient into pa_diag while we still have D at the quadrature point on hand.
+// Only the T_TENSOR versions carry the packed quadrature point blocks of the
+// sum-factorized diagonal around with them.
+template<bool T_DIAG, bool T_TENSOR, int T_D1D, int T_Q1D>
+void ExaNLFIntegrator::AssembleGradPAKernel(const double *W)
+{
+   const int dim = 3;
+   const int dsize = pa_dmat_sym ? exaconstit::kernel::PA_TAN_SYM_SIZE : dim * dim * dim * dim;
+   const int DIM2 = 2;
+   const int DIM3 = 3;
+   const int DIM4 = 4;
+   const int DIM6 = 6;
+   std::array<RAJA::idx_t, DIM6> perm6 {{ 5, 4, 3, 2, 1, 0 } };
+   std::array<RAJA::idx_t, DIM4> perm4 {{ 3, 2, 1, 0 } };
+   std::array<RAJA::idx_t, DIM2> perm2 {{ 1, 0 } };
+
+   // bunch of helper RAJA views to make dealing with data easier down below in our kernel.
+
+   RAJA::Layout<DIM6> layout_4Dtensor = RAJA::make_permuted_layout({{ dim, dim, dim, dim, nqpts, nelems } }, perm6);
+   RAJA::View<const double, RAJA::Layout<DIM6, RAJA::Index_type, 0> > C(model->GetMTanData(), layout_4Dtensor);
+   // Swapped over to row order since it makes sense in later applications...
+   // Should make C row order as well for PA operations
+   // Only one of these views is used depending on whether D is stored in its packed form.
+   RAJA::View<double, RAJA::Layout<DIM6> > D(pa_dmat.Write(), nelems, nqpts, dim, dim, dim, dim);
+   RAJA::View<double, RAJA::Layout<DIM3> > Dsym(pa_dmat.Write(), nelems, nqpts, dsize);
+
+   RAJA::Layout<DIM4> layout_jacob = RAJA::make_permuted_layout({{ dim, dim, nqpts, nelems } }, perm4);
+   RAJA::View<double, RAJA::Layout<DIM4, RAJA::Index_type, 0> > J(jacobian.ReadWrite(), layout_jacob);
+
+   RAJA::Layout<DIM2> layout_adj = RAJA::make_permuted_layout({{ dim, dim } }, perm2);
+
+   // Everything needed for our diagonal, which is only touched when T_DIAG is set
+   constexpr bool tensor = T_DIAG && T_TENSOR;
+   const int nnodes_ = nnodes;
+   const int d1d = T_D1D ? T_D1D : ndofs1d;
+   const int q1d = T_Q1D ? T_Q1D : nqpts1d;
+   double *Yd = T_DIAG ? pa_diag->ReadWrite() : nullptr;
+   const double *Gt = (T_DIAG && !tensor) ? grad.Read() : nullptr;
+   const double *B = tensor ? basis1d.Read() : nullptr;
+   const double *G = tensor ? dbasis1d.Read() : nullptr;
+   const int *map = tensor ? dof_map.Read() : nullptr;
 
-      double dt = model->GetModelDt();
-      const int nqpts_ = nqpts;
-      const int dim_ = dim;
-      // This loop we'll want to parallelize the rest are all serial for now.
-      MFEM_FORALL(i_elems, nelems, {
-         double adj[dim_ * dim_];
-         double c_detJ;
-         // So, we're going to say this view is constant however we're going to mutate the values only in
-         // that one scoped section for the quadrature points.
-         RAJA::View<const double, RAJA::Layout<DIM2, RAJA::Index_type, 0> > A(&adj[0], layout_adj);
-         for (int j_qpts = 0; j_qpts < nqpts_; j_qpts++) {
-            // If we scope this then we only need to carry half the number of variables around with us for
-            // the adjugate term.
-            {
-               const double J11 = J(0, 0, j_qpts, i_elems); // 0,0
-               const double J21 = J(1, 0, j_qpts, i_elems); // 1,0
-               const double J31 = J(2, 0, j_qpts, i_elems); // 2,0
-               const double J12 = J(0, 1, j_qpts, i_elems); // 0,1
-               const double J22 = J(1, 1, j_qpts, i_elems); // 1,1
-               const double J32 = J(2, 1, j_qpts, i_elems); // 2,1
-               const double J13 = J(0, 2, j_qpts, i_elems); // 0,2
-               const double J23 = J(1, 2, j_qpts, i_elems); // 1,2
-               const double J33 = J(2, 2, j_qpts, i_elems); // 2,2
-               const double detJ = J11 * (J22 * J33 - J32 * J23) -
-                                   /* */ J21 * (J12 * J33 - J32 * J13) +
-                                   /* */ J31 * (J12 * J23 - J22 * J13);
-               c_detJ = 1.0 / detJ * W[j_qpts] * dt;
-               // adj(J)
-               adj[0] = (J22 * J33) - (J23 * J32); // 0,0
-               adj[1] = (J32 * J13) - (J12 * J33); // 0,1
-               adj[2] = (J12 * J23) - (J22 * J13); // 0,2
-               adj[3] = (J31 * J23) - (J21 * J33); // 1,0
-               adj[4] = (J11 * J33) - (J13 * J31); // 1,1
-               adj[5] = (J21 * J13) - (J11 * J23); // 1,2
-               adj[6] = (J21 * J32) - (J31 * J22); // 2,0
-               adj[7] = (J31 * J12) - (J11 * J32); // 2,1
-               adj[8] = (J11 * J22) - (J12 * J21); // 2,2
+   double dt = model->GetModelDt();
+   const int nqpts_ = nqpts;
+   const int dim_ = dim;
+   const bool sym = pa_dmat_sym;
+   // This loop we'll want to parallelize the rest are all serial for now.
+   MFEM_FORALL(i_elems, nelems, {
+      // The packed M_c blocks of our tensor-product diagonal kernel for every quadrature point
+      constexpr int MQ = T_Q1D ? T_Q1D : exaconstit::kernel::TENSOR_MAX_Q1D;
+      constexpr int MQSIZE = tensor ? MQ * MQ * MQ * 18 : 1;
+      double mq[MQSIZE];
+      double adj[dim_ * dim_];
+      double c_detJ;
+      // Our quadrature point D_{ijkl} term which is then written out in either its
+      // full or packed form
+      double dq[dim_ * dim_ * dim_ * dim_];
+      RAJA::View<double, RAJA::Layout<DIM4> > Dq(&dq[0], dim_, dim_, dim_, dim_);
+      // So, we're going to say this view is constant however we're going to mutate the values only in
+      // that one scoped section for the quadrature points.
+      RAJA::View<const double, RAJA::Layout<DIM2, RAJA::Index_type, 0> > A(&adj[0], layout_adj);
+      for (int j_qpts = 0; j_qpts < nqpts_; j_qpts++) {
+         // If we scope this then we only need to carry half the number of variables around with us for
+         // the adjugate term.
+         {
+            const double J11 = J(0, 0, j_qpts, i_elems); // 0,0
+            const double J21 = J(1, 0, j_qpts, i_elems); // 1,0
+            const double J31 = J(2, 0, j_qpts, i_elems); // 2,0
+            const double J12 = J(0, 1, j_qpts, i_elems); // 0,1
+            const double J22 = J(1, 1, j_qpts, i_elems); // 1,1
+            const double J32 = J(2, 1, j_qpts, i_elems); // 2,1
+            const double J13 = J(0, 2, j_qpts, i_elems); // 0,2
+            const double J23 = J(1, 2, j_qpts, i_elems); // 1,2
+            const double J33 = J(2, 2, j_qpts, i_elems); // 2,2
+            const double detJ = J11 * (J22 * J33 - J32 * J23) -
+                                /* */ J21 * (J12 * J33 - J32 * J13) +
+                                /* */ J31 * (J12 * J23 - J22 * J13);
+            c_detJ = 1.0 / detJ * W[j_qpts] * dt;
+            // adj(J)
+            adj[0] = (J22 * J33) - (J23 * J32); // 0,0
+            adj[1] = (J32 * J13) - (J12 * J33); // 0,1
+            adj[2] = (J12 * J23) - (J22 * J13); // 0,2
+            adj[3] = (J31 * J23) - (J21 * J33); // 1,0
+            adj[4] = (J11 * J33) - (J13 * J31); // 1,1
+            adj[5] = (J21 * J13) - (J11 * J23); // 1,2
+            adj[6] = (J21 * J32) - (J31 * J22); // 2,0
+            adj[7] = (J31 * J12) - (J11 * J32); // 2,1
+            adj[8] = (J11 * J22) - (J12 * J21); // 2,2
+         }
+         for (int i = 0; i < dim_ * dim_ * dim_ * dim_; i++) {
+            dq[i] = 0.0;
+         }
+         // Unrolled part of the loops just so we wouldn't have so many nested ones.
+         // If we were to get really ambitious we could eliminate also the m indexed
+         // loop...
+         for (int n = 0; n < dim_; n++) {
+            for (int m = 0; m < dim_; m++) {
+               for (int l = 0; l < dim_; l++) {
+                  Dq(0, 0, l, n) += (A(0, 0) * C(0, 0, l, m, j_qpts, i_elems) +
+                                     A(1, 0) * C(1, 0, l, m, j_qpts, i_elems) +
+                                     A(2, 0) * C(2, 0, l, m, j_qpts, i_elems)) * A(m, n);
+                  Dq(0, 1, l, n) += (A(0, 0) * C(0, 1, l, m, j_qpts, i_elems) +
+                                     A(1, 0) * C(1, 1, l, m, j_qpts, i_elems) +
+                                     A(2, 0) * C(2, 1, l, m, j_qpts, i_elems)) * A(m, n);
+                  Dq(0, 2, l, n) += (A(0, 0) * C(0, 2, l, m, j_qpts, i_elems) +
+                                     A(1, 0) * C(1, 2, l, m, j_qpts, i_elems) +
+                                     A(2, 0) * C(2, 2, l, m, j_qpts, i_elems)) * A(m, n);
+                  Dq(1, 0, l, n) += (A(0, 1) * C(0, 0, l, m, j_qpts, i_elems) +
+                                     A(1, 1) * C(1, 0, l, m, j_qpts, i_elems) +
+                                     A(2, 1) * C(2, 0, l, m, j_qpts, i_elems)) * A(m, n);
+                  Dq(1, 1, l, n) += (A(0, 1) * C(0, 1, l, m, j_qpts, i_elems) +
+                                     A(1, 1) * C(1, 1, l, m, j_qpts, i_elems) +
+                                     A(2, 1) * C(2, 1, l, m, j_qpts, i_elems)) * A(m, n);
+                  Dq(1, 2, l, n) += (A(0, 1) * C(0, 2, l, m, j_qpts, i_elems) +
+                                     A(1, 1) * C(1, 2, l, m, j_qpts, i_elems) +
+                                     A(2, 1) * C(2, 2, l, m, j_qpts, i_elems)) * A(m, n);
+                  Dq(2, 0, l, n) += (A(0, 2) * C(0, 0, l, m, j_qpts, i_elems) +
+                                     A(1, 2) * C(1, 0, l, m, j_qpts, i_elems) +
+                                     A(2, 2) * C(2, 0, l, m, j_qpts, i_elems)) * A(m, n);
+                  Dq(2, 1, l, n) += (A(0, 2) * C(0, 1, l, m, j_qpts, i_elems) +
+                                     A(1, 2) * C(1, 1, l, m, j_qpts, i_elems) +
+                                     A(2, 2) * C(2, 1, l, m, j_qpts, i_elems)) * A(m, n);
+                  Dq(2, 2, l, n) += (A(0, 2) * C(0, 2, l, m, j_qpts, i_elems) +
+                                     A(1, 2) * C(1, 2, l, m, j_qpts, i_elems) +
+                                     A(2, 2) * C(2, 2, l, m, j_qpts, i_elems)) * A(m, n);
+               }
+            }
+         } // End of Dikln = adj(J)_{ji} C_{jklm} adj(J)_{mn} loop
+
+         if (sym) {
+            // D_{abln} -> N(a + 3b, n + 3l) where we only save the upper triangle of N
+            for (int u = 0; u < 9; u++) {
+               const int row = exaconstit::kernel::sym_tan_row(u);
+               for (int v = u; v < 9; v++) {
+                  Dsym(i_elems, j_qpts, row + v) = c_detJ * Dq(u % 3, u / 3, v / 3, v % 3);
+               }
             }
+         }
+         else {
             // Unrolled part of the loops just so we wouldn't have so many nested ones.
-            // If we were to get really ambitious we could eliminate also the m indexed
-            // loop...
             for (int n = 0; n < dim_; n++) {
-               for (int m = 0; m < dim_; m++) {
-                  for (int l = 0; l < dim_; l++) {
-                     D(i_elems, j_qpts, 0, 0, l, n) += (A(0, 0) * C(0, 0, l, m, j_qpts, i_elems) +
-                                                        A(1, 0) * C(1, 0, l, m, j_qpts, i_elems) +
-                                                        A(2, 0) * C(2, 0, l, m, j_qpts, i_elems)) * A(m, n);
-                     D(i_elems, j_qpts, 0, 1, l, n) += (A(0, 0) * C(0, 1, l, m, j_qpts, i_elems) +
-                                                        A(1, 0) * C(1, 1, l, m, j_qpts, i_elems) +
-                                                        A(2, 0) * C(2, 1, l, m, j_qpts, i_elems)) * A(m, n);
-                     D(i_elems, j_qpts, 0, 2, l, n) += (A(0, 0) * C(0, 2, l, m, j_qpts, i_elems) +
-                                                        A(1, 0) * C(1, 2, l, m, j_qpts, i_elems) +
-                                                        A(2, 0) * C(2, 2, l, m, j_qpts, i_elems)) * A(m, n);
-                     D(i_elems, j_qpts, 1, 0, l, n) += (A(0, 1) * C(0, 0, l, m, j_qpts, i_elems) +
-                                                        A(1, 1) * C(1, 0, l, m, j_qpts, i_elems) +
-                                                        A(2, 1) * C(2, 0, l, m, j_qpts, i_elems)) * A(m, n);
-                     D(i_elems, j_qpts, 1, 1, l, n) += (A(0, 1) * C(0, 1, l, m, j_qpts, i_elems) +
-                                                        A(1, 1) * C(1, 1, l, m, j_qpts, i_elems) +
-                                                        A(2, 1) * C(2, 1, l, m, j_qpts, i_elems)) * A(m, n);
-                     D(i_elems, j_qpts, 1, 2, l, n) += (A(0, 1) * C(0, 2, l, m, j_qpts, i_elems) +
-                                                        A(1, 1) * C(1, 2, l, m, j_qpts, i_elems) +
-                                                        A(2, 1) * C(2, 2, l, m, j_qpts, i_elems)) * A(m, n);
-                     D(i_elems, j_qpts, 2, 0, l, n) += (A(0, 2) * C(0, 0, l, m, j_qpts, i_elems) +
-                                                        A(1, 2) * C(1, 0, l, m, j_qpts, i_elems) +
-                                                        A(2, 2) * C(2, 0, l, m, j_qpts, i_elems)) * A(m, n);
-                     D(i_elems, j_qpts, 2, 1, l, n) += (A(0, 2) * C(0, 1, l, m, j_qpts, i_elems) +
-                                                        A(1, 2) * C(1, 1, l, m, j_qpts, i_elems) +
-                                                        A(2, 2) * C(2, 1, l, m, j_qpts, i_elems)) * A(m, n);
-                     D(i_elems, j_qpts, 2, 2, l, n) += (A(0, 2) * C(0, 2, l, m, j_qpts, i_elems) +
-                                                        A(1, 2) * C(1, 2, l, m, j_qpts, i_elems) +
-                                                        A(2, 2) * C(2, 2, l, m, j_qpts, i_elems)) * A(m, n);
+               for (int l = 0; l < dim_; l++) {
+                  for (int k = 0; k < dim_; k++) {
+                     D(i_elems, j_qpts, l, n, k, 0) = c_detJ * Dq(l, n, k, 0);
+                     D(i_elems, j_qpts, l, n, k, 1) = c_detJ * Dq(l, n, k, 1);
+                     D(i_elems, j_qpts, l, n, k, 2) = c_detJ * Dq(l, n, k, 2);
                   }
                }
-            } // End of Dikln = adj(J)_{ji} C_{jklm} adj(J)_{mn} loop
+            } // End of D_{ijkl} = 1/det(J) * w_{qpt} * D_{ijkl} loop
+         }
 
-            // Unrolled part of the loops just so we wouldn't have so many nested ones.
-            for (int n = 0; n < dim_; n++) {
-               for (int l = 0; l < dim_; l++) {
-                  D(i_elems, j_qpts, l, n, 0, 0) *= c_detJ;
-                  D(i_elems, j_qpts, l, n, 0, 1) *= c_detJ;
-                  D(i_elems, j_qpts, l, n, 0, 2) *= c_detJ;
-                  D(i_elems, j_qpts, l, n, 1, 0) *= c_detJ;
-                  D(i_elems, j_qpts, l, n, 1, 1) *= c_detJ;
-                  D(i_elems, j_qpts, l, n, 1, 2) *= c_detJ;
-                  D(i_elems, j_qpts, l, n, 2, 0) *= c_detJ;
-                  D(i_elems, j_qpts, l, n, 2, 1) *= c_detJ;
-                  D(i_elems, j_qpts, l, n, 2, 2) *= c_detJ;
+         if (T_DIAG) {
+            for (int b = 0; b < dim_; b++) {
+               // M_{aj} = D_{abbj} is the only block of D needed for the diagonal of component b
+               double M[9];
+               for (int j = 0; j < dim_; j++) {
+                  for (int a = 0; a < dim_; a++) {
+                     M[a + 3 * j] = c_detJ * Dq(a, b, b, j);
+                  }
                }
-            } // End of D_{ijkl} *= 1/det(J) * w_{qpt} loop
-         } // End of quadrature loop
-      }); // End of Elements loop
-   } // End of else statement
+               if (tensor) {
+                  double *mqc = &mq[6 * (b + 3 * j_qpts)];
+                  mqc[0] = M[0];
+                  mqc[1] = M[4];
+                  mqc[2] = M[8];
+                  mqc[3] = M[3] + M[1];
+                  mqc[4] = M[6] + M[2];
+                  mqc[5] = M[7] + M[5];
+               }
+               else {
+                  double *Y = &Yd[nnodes_ * (b + dim_ * i_elems)];
+                  const double *Gtq = &Gt[nnodes_ * dim_ * j_qpts];
+                  for (int knodes = 0; knodes < nnodes_; knodes++) {
+                     const double g0 = Gtq[knodes];
+                     const double g1 = Gtq[knodes + nnodes_];
+                     const double g2 = Gtq[knodes + 2 * nnodes_];
+                     Y[knodes] += g0 * (M[0] * g0 + M[3] * g1 + M[6] * g2)
+                                  + g1 * (M[1] * g0 + M[4] * g1 + M[7] * g2)
+                                  + g2 * (M[2] * g0 + M[5] * g1 + M[8] * g2);
+                  }
+               }
+            }
+         }
+      } // End of quadrature loop
+
+      if (tensor) {
+         exaconstit::kernel::tensor_grad_diag_hex<T_D1D, T_Q1D>(d1d, q1d, B, G, map, mq, &Yd[dim_ * nnodes_ * i_elems]);
+      }
+   }); // End of Elements loop
+}
+
+void ExaNLFIntegrator::AssembleGradPADiagonal(const FiniteElementSpace &fes, Vector &diag)
+{
+   pa_diag = &diag;
+   AssembleGradPA(fes);
+   pa_diag = nullptr;
 }
 
 // Here we're applying the following action operation using the assembled "D" 2nd order
@@ -518,6 +694,20 @@ void ExaNLFIntegrator::AssembleGradPA(const FiniteElementSpace &fes)
 void ExaNLFIntegrator::AddMultPA(const mfem::Vector & /*x*/, mfem::Vector &y) const
 {
    CALI_CXX_MARK_SCOPE("enlfi_amPAV");
+   if (tensor_kernels) {
+      // Compile time specialized kernels for our most common element orders
+      switch ((ndofs1d << 4) | nqpts1d) {
+         case 0x22: AddMultPATensor<2, 2>(y); return;
+         case 0x33: AddMultPATensor<3, 3>(y); return;
+         case 0x44: AddMultPATensor<4, 4>(y); return;
+         default:
+            if (GenericTensorKernels()) {
+               AddMultPATensor(y);
+               return;
+            }
+            break;
+      }
+   }
    if ((space_dims == 1) || (space_dims == 2)) {
       MFEM_ABORT("Dimensions of 1 or 2 not supported.");
    }
@@ -562,6 +752,20 @@ void ExaNLFIntegrator::AddMultPA(const mfem::Vector & /*x*/, mfem::Vector &y) co
 void ExaNLFIntegrator::AddMultGradPA(const mfem::Vector &x, mfem::Vector &y) const
 {
    CALI_CXX_MARK_SCOPE("enlfi_amPAG");
+   if (tensor_kernels) {
+      // Compile time specialized kernels for our most common element orders
+      switch ((ndofs1d << 4) | nqpts1d) {
+         case 0x22: AddMultGradPATensor<2, 2>(x, y); return;
+         case 0x33: AddMultGradPATensor<3, 3>(x, y); return;
+         case 0x44: AddMultGradPATensor<4, 4>(x, y); return;
+         default:
+            if (GenericTensorKernels()) {
+               AddMultGradPATensor(x, y);
+               return;
+            }
+            break;
+      }
+   }
    if ((space_dims == 1) || (space_dims == 2)) {
       MFEM_ABORT("Dimensions of 1 or 2 not supported.");
    }
@@ -576,6 +780,9 @@ void ExaNLFIntegrator::AddMultGradPA(const mfem::Vector &x, mfem::Vector &y) con
       // Swapped over to row order since it makes sense in later applications...
       // Should make C row order as well for PA operations
       RAJA::View<const double, RAJA::Layout<DIM6> > D(pa_dmat.Read(), nelems, nqpts, dim, dim, dim, dim);
+      // Packed version of D used when our material tangent is symmetric
+      const int dsize = exaconstit::kernel::PA_TAN_SYM_SIZE;
+      const double *Dsym = pa_dmat.Read();
       // Our field variables that are inputs and outputs
       RAJA::Layout<DIM3> layout_field = RAJA::make_permuted_layout({{ nnodes, dim, nelems } }, perm3);
       RAJA::View<const double, RAJA::Layout<DIM3, RAJA::Index_type, 0> > X(x.Read(), layout_field);
@@ -589,21 +796,39 @@ void ExaNLFIntegrator::AddMultGradPA(const mfem::Vector &x, mfem::Vector &y) con
       const int nqpts_ = nqpts;
       const int dim_ = dim;
       const int nnodes_ = nnodes;
-      MFEM_FORALL(i_elems, nelems, {
+      const bool sym = pa_dmat_sym;
+      // We might only be applying our operator to a subset of our elements
+      const int nsel = pa_elems ? pa_elems->Size() : nelems;
+      const int *sel = pa_elems ? pa_elems->Read() : nullptr;
+      MFEM_FORALL(i_sel, nsel, {
+         const int i_elems = sel ? sel[i_sel] : i_sel;
          for (int j_qpts = 0; j_qpts < nqpts_; j_qpts++) {
-            double T[9] = { 0, 0, 0, 0, 0, 0, 0, 0, 0 };
-            for (int i = 0; i < dim_; i++) {
-               for (int j = 0; j < dim_; j++) {
+            // Our local gradient term gX_{ij} = X_{ki} Gt_{kj}
+            double gX[9] = { 0, 0, 0, 0, 0, 0, 0, 0, 0 };
+            for (int j = 0; j < dim_; j++) {
+               for (int i = 0; i < dim_; i++) {
                   for (int k = 0; k < nnodes_; k++) {
-                     T[0] += D(i_elems, j_qpts, 0, 0, i, j) * Gt(k, j, j_qpts) * X(k, i, i_elems);
-                     T[1] += D(i_elems, j_qpts, 1, 0, i, j) * Gt(k, j, j_qpts) * X(k, i, i_elems);
-                     T[2] += D(i_elems, j_qpts, 2, 0, i, j) * Gt(k, j, j_qpts) * X(k, i, i_elems);
-                     T[3] += D(i_elems, j_qpts, 0, 1, i, j) * Gt(k, j, j_qpts) * X(k, i, i_elems);
-                     T[4] += D(i_elems, j_qpts, 1, 1, i, j) * Gt(k, j, j_qpts) * X(k, i, i_elems);
-                     T[5] += D(i_elems, j_qpts, 2, 1, i, j) * Gt(k, j, j_qpts) * X(k, i, i_elems);
-                     T[6] += D(i_elems, j_qpts, 0, 2, i, j) * Gt(k, j, j_qpts) * X(k, i, i_elems);
-                     T[7] += D(i_elems, j_qpts, 1, 2, i, j) * Gt(k, j, j_qpts) * X(k, i, i_elems);
-                     T[8] += D(i_elems, j_qpts, 2, 2, i, j) * Gt(k, j, j_qpts) * X(k, i, i_elems);
+                     gX[i + dim_ * j] += Gt(k, j, j_qpts) * X(k, i, i_elems);
+                  }
+               }
+            }
+
+            double T[9] = { 0, 0, 0, 0, 0, 0, 0, 0, 0 };
+            if (sym) {
+               exaconstit::kernel::sym_tan_mult(&Dsym[dsize * (j_qpts + nqpts_ * i_elems)], gX, T);
+            }
+            else {
+               for (int i = 0; i < dim_; i++) {
+                  for (int j = 0; j < dim_; j++) {
+                     T[0] += D(i_elems, j_qpts, 0, 0, i, j) * gX[i + dim_ * j];
+                     T[1] += D(i_elems, j_qpts, 1, 0, i, j) * gX[i + dim_ * j];
+                     T[2] += D(i_elems, j_qpts, 2, 0, i, j) * gX[i + dim_ * j];
+                     T[3] += D(i_elems, j_qpts, 0, 1, i, j) * gX[i + dim_ * j];
+                     T[4] += D(i_elems, j_qpts, 1, 1, i, j) * gX[i + dim_ * j];
+                     T[5] += D(i_elems, j_qpts, 2, 1, i, j) * gX[i + dim_ * j];
+                     T[6] += D(i_elems, j_qpts, 0, 2, i, j) * gX[i + dim_ * j];
+                     T[7] += D(i_elems, j_qpts, 1, 2, i, j) * gX[i + dim_ * j];
+                     T[8] += D(i_elems, j_qpts, 2, 2, i, j) * gX[i + dim_ * j];
                   }
                }
             } // End of doing tensor contraction of D_{jkmo}G_{op}X_{pm}
@@ -621,11 +846,110 @@ void ExaNLFIntegrator::AddMultGradPA(const mfem::Vector &x, mfem::Vector &y) con
    } // End of if statement
 }
 
+void ExaNLFIntegrator::AddMultGradPAElements(const mfem::Vector &x, mfem::Vector &y,
+                                             const mfem::Array<int> &elems) const
+{
+   pa_elems = &elems;
+   AddMultGradPA(x, y);
+   pa_elems = nullptr;
+}
+
 // This assembles the diagonal of our LHS which can be used as a preconditioner
 void ExaNLFIntegrator::AssembleGradDiagonalPA(Vector &diag) const
 {
    CALI_CXX_MARK_SCOPE("enlfi_AssembleGradDiagonalPA");
+   if (tensor_kernels) {
+      // Compile time specialized kernels for our most common element orders
+      switch ((ndofs1d << 4) | nqpts1d) {
+         case 0x22: AssembleGradDiagonalPATensor<2, 2>(diag); return;
+         case 0x33: AssembleGradDiagonalPATensor<3, 3>(diag); return;
+         case 0x44: AssembleGradDiagonalPATensor<4, 4>(diag); return;
+         default:
+            if (GenericTensorKernels()) {
+               AssembleGradDiagonalPATensor(diag);
+               return;
+            }
+            break;
+      }
+   }
+
+   if ((space_dims == 1) || (space_dims == 2)) {
+      MFEM_ABORT("Dimensions of 1 or 2 not supported.");
+   }
+   else {
+      const int dim = 3;
+
+      const int DIM3 = 3;
+      const int DIM6 = 6;
+
+      std::array<RAJA::idx_t, DIM3> perm3 {{ 2, 1, 0 } };
+
+      // bunch of helper RAJA views to make dealing with data easier down below in our kernel.
 
+      // Our D_{ijkl} term from AssembleGradPA already contains our 1 / det(J) * w_{qpt} * dt
+      // and adj(J) terms, so we can just make use of it directly rather than recompute it.
+      RAJA::View<const double, RAJA::Layout<DIM6> > D(pa_dmat.Read(), nelems, nqpts, dim, dim, dim, dim);
+      // Packed version of D used when our material tangent is symmetric
+      const int dsize = exaconstit::kernel::PA_TAN_SYM_SIZE;
+      const double *Dsym = pa_dmat.Read();
+
+      // Our field variables that are inputs and outputs
+      RAJA::Layout<DIM3> layout_field = RAJA::make_permuted_layout({{ nnodes, dim, nelems } }, perm3);
+      RAJA::View<double, RAJA::Layout<DIM3, RAJA::Index_type, 0> > Y(diag.ReadWrite(), layout_field);
+
+      RAJA::Layout<DIM3> layout_grads = RAJA::make_permuted_layout({{ nnodes, dim, nqpts } }, perm3);
+      RAJA::View<const double, RAJA::Layout<DIM3, RAJA::Index_type, 0> > Gt(grad.Read(), layout_grads);
+
+      const int nqpts_ = nqpts;
+      const int dim_ = dim;
+      const int nnodes_ = nnodes;
+      const bool sym = pa_dmat_sym;
+      // This loop we'll want to parallelize the rest are all serial for now.
+      MFEM_FORALL(i_elems, nelems, {
+         for (int j_qpts = 0; j_qpts < nqpts_; j_qpts++) {
+            const double *N = &Dsym[dsize * (j_qpts + nqpts_ * i_elems)];
+            for (int b = 0; b < dim_; b++) {
+               // M_{aj} = D_{abbj} is the only block of D needed for the diagonal of component b
+               double M[9];
+               for (int j = 0; j < dim_; j++) {
+                  for (int a = 0; a < dim_; a++) {
+                     if (sym) {
+                        const int u = a + 3 * b;
+                        const int v = j + 3 * b;
+                        M[a + 3 * j] = (u <= v) ? N[exaconstit::kernel::sym_tan_row(u) + v]
+                                       : N[exaconstit::kernel::sym_tan_row(v) + u];
+                     }
+                     else {
+                        M[a + 3 * j] = D(i_elems, j_qpts, a, b, b, j);
+                     }
+                  }
+               }
+               for (int knodes = 0; knodes < nnodes_; knodes++) {
+                  const double g0 = Gt(knodes, 0, j_qpts);
+                  const double g1 = Gt(knodes, 1, j_qpts);
+                  const double g2 = Gt(knodes, 2, j_qpts);
+                  Y(knodes, b, i_elems) += g0 * (M[0] * g0 + M[3] * g1 + M[6] * g2)
+                                           + g1 * (M[1] * g0 + M[4] * g1 + M[7] * g2)
+                                           + g2 * (M[2] * g0 + M[5] * g1 + M[8] * g2);
+               }
+            }
+         }
+      });
+   }
+}
+
+void ExaNLFIntegrator::AssembleGradBlockDiagonalPA(Vector &blk_diag) const
+{
+   CALI_CXX_MARK_SCOPE("enlfi_AssembleGradBlockDiagonalPA");
+   AssembleGradBlockDiagonalKernel(nullptr, blk_diag);
+}
+
+// The nodal block of our element matrix for node k is B_k^T K B_k summed over the
+// quadrature points, where B_k is the 6x3 strain displacement matrix of node k.
+// The full 6x6 material tangent is used here rather than our PA tangent, so the
+// same kernel works for both the standard and Bbar formulations.
+void ExaNLFIntegrator::AssembleGradBlockDiagonalKernel(const double *eds, Vector &blk_diag) const
+{
    const IntegrationRule &ir = model->GetMatGrad()->GetSpace()->GetIntRule(0);
    auto W = ir.GetWeights().Read();
 
@@ -635,116 +959,271 @@ void ExaNLFIntegrator::AssembleGradDiagonalPA(Vector &diag) const
    else {
       const int dim = 3;
 
-      const int DIM2 = 2;
       const int DIM3 = 3;
       const int DIM4 = 4;
 
       std::array<RAJA::idx_t, DIM4> perm4 {{ 3, 2, 1, 0 } };
       std::array<RAJA::idx_t, DIM3> perm3 {{ 2, 1, 0 } };
-      std::array<RAJA::idx_t, DIM2> perm2 {{ 1, 0 } };
 
       // bunch of helper RAJA views to make dealing with data easier down below in our kernel.
-
       RAJA::Layout<DIM4> layout_tensor = RAJA::make_permuted_layout({{ 2 * dim, 2 * dim, nqpts, nelems } }, perm4);
       RAJA::View<const double, RAJA::Layout<DIM4, RAJA::Index_type, 0> > K(model->GetMatGrad()->Read(), layout_tensor);
 
-      // Our field variables that are inputs and outputs
-      RAJA::Layout<DIM3> layout_field = RAJA::make_permuted_layout({{ nnodes, dim, nelems } }, perm3);
-      RAJA::View<double, RAJA::Layout<DIM3, RAJA::Index_type, 0> > Y(diag.ReadWrite(), layout_field);
+      RAJA::Layout<DIM4> layout_blk = RAJA::make_permuted_layout({{ nnodes, dim, nelems, dim } }, perm4);
+      RAJA::View<double, RAJA::Layout<DIM4, RAJA::Index_type, 0> > Y(blk_diag.ReadWrite(), layout_blk);
 
       RAJA::Layout<DIM4> layout_jacob = RAJA::make_permuted_layout({{ dim, dim, nqpts, nelems } }, perm4);
       RAJA::View<const double, RAJA::Layout<DIM4, RAJA::Index_type, 0> > J(jacobian.Read(), layout_jacob);
 
-      RAJA::Layout<DIM2> layout_adj = RAJA::make_permuted_layout({{ dim, dim } }, perm2);
-
       RAJA::Layout<DIM3> layout_grads = RAJA::make_permuted_layout({{ nnodes, dim, nqpts } }, perm3);
       RAJA::View<const double, RAJA::Layout<DIM3, RAJA::Index_type, 0> > Gt(grad.Read(), layout_grads);
 
-      double dt = model->GetModelDt();
+      RAJA::Layout<DIM3> layout_egrads = RAJA::make_permuted_layout({{ nnodes, dim, nelems } }, perm3);
+      RAJA::View<const double, RAJA::Layout<DIM3, RAJA::Index_type, 0> > eDS_view(eds, layout_egrads);
+
+      const bool bbar = (eds != nullptr);
+      const double dt = model->GetModelDt();
+      const double i3 = 1.0 / 3.0;
       const int nqpts_ = nqpts;
       const int dim_ = dim;
       const int nnodes_ = nnodes;
-      // This loop we'll want to parallelize the rest are all serial for now.
       MFEM_FORALL(i_elems, nelems, {
          double adj[dim_ * dim_];
-         double c_detJ;
-         // So, we're going to say this view is constant however we're going to mutate the values only in
-         // that one scoped section for the quadrature points.
-         RAJA::View<const double, RAJA::Layout<DIM2, RAJA::Index_type, 0> > A(&adj[0], layout_adj);
          for (int j_qpts = 0; j_qpts < nqpts_; j_qpts++) {
-            // If we scope this then we only need to carry half the number of variables around with us for
-            // the adjugate term.
-            {
-               const double J11 = J(0, 0, j_qpts, i_elems); // 0,0
-               const double J21 = J(1, 0, j_qpts, i_elems); // 1,0
-               const double J31 = J(2, 0, j_qpts, i_elems); // 2,0
-               const double J12 = J(0, 1, j_qpts, i_elems); // 0,1
-               const double J22 = J(1, 1, j_qpts, i_elems); // 1,1
-               const double J32 = J(2, 1, j_qpts, i_elems); // 2,1
-               const double J13 = J(0, 2, j_qpts, i_elems); // 0,2
-               const double J23 = J(1, 2, j_qpts, i_elems); // 1,2
-               const double J33 = J(2, 2, j_qpts, i_elems); // 2,2
-               const double detJ = J11 * (J22 * J33 - J32 * J23) -
-                                   /* */ J21 * (J12 * J33 - J32 * J13) +
-                                   /* */ J31 * (J12 * J23 - J22 * J13);
-               c_detJ = 1.0 / detJ * W[j_qpts] * dt;
-               // adj(J)
-               adj[0] = (J22 * J33) - (J23 * J32); // 0,0
-               adj[1] = (J32 * J13) - (J12 * J33); // 0,1
-               adj[2] = (J12 * J23) - (J22 * J13); // 0,2
-               adj[3] = (J31 * J23) - (J21 * J33); // 1,0
-               adj[4] = (J11 * J33) - (J13 * J31); // 1,1
-               adj[5] = (J21 * J13) - (J11 * J23); // 1,2
-               adj[6] = (J21 * J32) - (J31 * J22); // 2,0
-               adj[7] = (J31 * J12) - (J11 * J32); // 2,1
-               adj[8] = (J11 * J22) - (J12 * J21); // 2,2
+            const double J11 = J(0, 0, j_qpts, i_elems); // 0,0
+            const double J21 = J(1, 0, j_qpts, i_elems); // 1,0
+            const double J31 = J(2, 0, j_qpts, i_elems); // 2,0
+            const double J12 = J(0, 1, j_qpts, i_elems); // 0,1
+            const double J22 = J(1, 1, j_qpts, i_elems); // 1,1
+            const double J32 = J(2, 1, j_qpts, i_elems); // 2,1
+            const double J13 = J(0, 2, j_qpts, i_elems); // 0,2
+            const double J23 = J(1, 2, j_qpts, i_elems); // 1,2
+            const double J33 = J(2, 2, j_qpts, i_elems); // 2,2
+            const double detJ = J11 * (J22 * J33 - J32 * J23) -
+                                /* */ J21 * (J12 * J33 - J32 * J13) +
+                                /* */ J31 * (J12 * J23 - J22 * J13);
+            const double idetJ = 1.0 / detJ;
+            const double c_detJ = detJ * W[j_qpts] * dt;
+            // adj(J)
+            adj[0] = (J22 * J33) - (J23 * J32); // 0,0
+            adj[1] = (J32 * J13) - (J12 * J33); // 0,1
+            adj[2] = (J12 * J23) - (J22 * J13); // 0,2
+            adj[3] = (J31 * J23) - (J21 * J33); // 1,0
+            adj[4] = (J11 * J33) - (J13 * J31); // 1,1
+            adj[5] = (J21 * J13) - (J11 * J23); // 1,2
+            adj[6] = (J21 * J32) - (J31 * J22); // 2,0
+            adj[7] = (J31 * J12) - (J11 * J32); // 2,1
+            adj[8] = (J11 * J22) - (J12 * J21); // 2,2
+
+            for (int knds = 0; knds < nnodes_; knds++) {
+               // adj is stored row-major so adj[3 * k + i] = adj(J)_{ki}
+               const double bx = idetJ * (Gt(knds, 0, j_qpts) * adj[0]
+                                          + Gt(knds, 1, j_qpts) * adj[3]
+                                          + Gt(knds, 2, j_qpts) * adj[6]);
+
+               const double by = idetJ * (Gt(knds, 0, j_qpts) * adj[1]
+                                          + Gt(knds, 1, j_qpts) * adj[4]
+                                          + Gt(knds, 2, j_qpts) * adj[7]);
+
+               const double bz = idetJ * (Gt(knds, 0, j_qpts) * adj[2]
+                                          + Gt(knds, 1, j_qpts) * adj[5]
+                                          + Gt(knds, 2, j_qpts) * adj[8]);
+               // B[v + 6 * a] is the Voigt strain term v due to displacement component a
+               double B[18];
+               for (int i = 0; i < 18; i++) {
+                  B[i] = 0.0;
+               }
+               if (bbar) {
+                  const double b4 = i3 * (eDS_view(knds, 0, i_elems) - bx);
+                  const double b6 = i3 * (eDS_view(knds, 1, i_elems) - by);
+                  const double b8 = i3 * (eDS_view(knds, 2, i_elems) - bz);
+                  B[0] = b4 + bx; B[1] = b4; B[2] = b4; B[4] = bz; B[5] = by;
+                  B[6] = b6; B[7] = b6 + by; B[8] = b6; B[9] = bz; B[11] = bx;
+                  B[12] = b8; B[13] = b8; B[14] = b8 + bz; B[15] = by; B[16] = bx;
+               }
+               else {
+                  B[0] = bx; B[4] = bz; B[5] = by;
+                  B[7] = by; B[9] = bz; B[11] = bx;
+                  B[14] = bz; B[15] = by; B[16] = bx;
+               }
+
+               for (int b = 0; b < dim_; b++) {
+                  double KB[6];
+                  for (int v = 0; v < 6; v++) {
+                     KB[v] = 0.0;
+                     for (int w = 0; w < 6; w++) {
+                        KB[v] += K(v, w, j_qpts, i_elems) * B[w + 6 * b];
+                     }
+                  }
+                  for (int a = 0; a < dim_; a++) {
+                     double val = 0.0;
+                     for (int v = 0; v < 6; v++) {
+                        val += B[v + 6 * a] * KB[v];
+                     }
+                     Y(knds, a, i_elems, b) += c_detJ * val;
+                  }
+               }
+            }
+         } // End of nQpts
+      }); // End of nelems
+   }
+}
+
+// Sum-factorized version of AddMultPA for tensor-product hexahedral elements.
+// The per quadrature point D_{jk} term plays the role of T in the transposed
+// gradient action y_{ik} = \nabla_{ij}\phi^T_{\epsilon} D_{jk}
+template<int T_D1D, int T_Q1D>
+void ExaNLFIntegrator::AddMultPATensor(mfem::Vector &y) const
+{
+   CALI_CXX_MARK_SCOPE("enlfi_amPAV_tensor");
+   const int dim = 3;
+   const int d1d = T_D1D ? T_D1D : ndofs1d;
+   const int q1d = T_Q1D ? T_Q1D : nqpts1d;
+   const int nqpts_ = q1d * q1d * q1d;
+   const int dim_ = dim;
+   const int nnodes_ = d1d * d1d * d1d;
+
+   const double *B = basis1d.Read();
+   const double *G = dbasis1d.Read();
+   const int *map = dof_map.Read();
+   const double *D = dmat.Read();
+   double *Y = y.ReadWrite();
+
+   MFEM_FORALL(i_elems, nelems, {
+      exaconstit::kernel::tensor_grad_trans_hex<T_D1D, T_Q1D>(d1d, q1d, B, G, map,
+                                                              &D[dim_ * dim_ * nqpts_ * i_elems],
+                                                              &Y[dim_ * nnodes_ * i_elems]);
+   }); // End of nelems
+}
+
+// Sum-factorized version of AddMultGradPA for tensor-product hexahedral elements.
+// The reference gradient of x is formed at all of the quadrature points through
+// 1D contractions, then contracted with D_{jklm}, and finally taken back to the
+// nodes through the transposed 1D contractions.
+template<int T_D1D, int T_Q1D>
+void ExaNLFIntegrator::AddMultGradPATensor(const mfem::Vector &x, mfem::Vector &y) const
+{
+   CALI_CXX_MARK_SCOPE("enlfi_amPAG_tensor");
+   const int dim = 3;
+   const int DIM6 = 6;
+
+   RAJA::View<const double, RAJA::Layout<DIM6> > D(pa_dmat.Read(), nelems, nqpts, dim, dim, dim, dim);
+   // Packed version of D used when our material tangent is symmetric
+   const int dsize = exaconstit::kernel::PA_TAN_SYM_SIZE;
+   const double *Dsym = pa_dmat.Read();
+   const bool sym = pa_dmat_sym;
+
+   const int d1d = T_D1D ? T_D1D : ndofs1d;
+   const int q1d = T_Q1D ? T_Q1D : nqpts1d;
+   const int nqpts_ = q1d * q1d * q1d;
+   const int dim_ = dim;
+   const int nnodes_ = d1d * d1d * d1d;
+
+   const double *B = basis1d.Read();
+   const double *G = dbasis1d.Read();
+   const int *map = dof_map.Read();
+   const double *X = x.Read();
+   double *Y = y.ReadWrite();
+
+   // We might only be applying our operator to a subset of our elements
+   const int nsel = pa_elems ? pa_elems->Size() : nelems;
+   const int *sel = pa_elems ? pa_elems->Read() : nullptr;
+   MFEM_FORALL(i_sel, nsel, {
+      const int i_elems = sel ? sel[i_sel] : i_sel;
+      constexpr int MQ = T_Q1D ? T_Q1D : exaconstit::kernel::TENSOR_MAX_Q1D;
+      // Holds the reference gradient of x and later on our T_{jk} terms
+      double gq[MQ * MQ * MQ * 9];
+      exaconstit::kernel::tensor_grad_hex<T_D1D, T_Q1D>(d1d, q1d, B, G, map, &X[dim_ * nnodes_ * i_elems], gq);
+      for (int j_qpts = 0; j_qpts < nqpts_; j_qpts++) {
+         double *gX = &gq[9 * j_qpts];
+         double T[9] = { 0, 0, 0, 0, 0, 0, 0, 0, 0 };
+         if (sym) {
+            exaconstit::kernel::sym_tan_mult(&Dsym[dsize * (j_qpts + nqpts_ * i_elems)], gX, T);
+         }
+         else {
+            for (int i = 0; i < dim_; i++) {
+               for (int j = 0; j < dim_; j++) {
+                  const double gx = gX[i + 3 * j];
+                  T[0] += D(i_elems, j_qpts, 0, 0, i, j) * gx;
+                  T[1] += D(i_elems, j_qpts, 1, 0, i, j) * gx;
+                  T[2] += D(i_elems, j_qpts, 2, 0, i, j) * gx;
+                  T[3] += D(i_elems, j_qpts, 0, 1, i, j) * gx;
+                  T[4] += D(i_elems, j_qpts, 1, 1, i, j) * gx;
+                  T[5] += D(i_elems, j_qpts, 2, 1, i, j) * gx;
+                  T[6] += D(i_elems, j_qpts, 0, 2, i, j) * gx;
+                  T[7] += D(i_elems, j_qpts, 1, 2, i, j) * gx;
+                  T[8] += D(i_elems, j_qpts, 2, 2, i, j) * gx;
+               }
             }
-            for (int knodes = 0; knodes < nnodes_; knodes++) {
-               const double bx = Gt(knodes, 0, j_qpts) * A(0, 0)
-                                 + Gt(knodes, 1, j_qpts) * A(0, 1)
-                                 + Gt(knodes, 2, j_qpts) * A(0, 2);
-
-               const double by = Gt(knodes, 0, j_qpts) * A(1, 0)
-                                 + Gt(knodes, 1, j_qpts) * A(1, 1)
-                                 + Gt(knodes, 2, j_qpts) * A(1, 2);
-
-               const double bz = Gt(knodes, 0, j_qpts) * A(2, 0)
-                                 + Gt(knodes, 1, j_qpts) * A(2, 1)
-                                 + Gt(knodes, 2, j_qpts) * A(2, 2);
-
-               Y(knodes, 0, i_elems) += c_detJ * (bx * (bx * K(0, 0, j_qpts, i_elems)
-                                                        + by * K(0, 5, j_qpts, i_elems)
-                                                        + bz * K(0, 4, j_qpts, i_elems))
-                                                  + by * (bx * K(5, 0, j_qpts, i_elems)
-                                                          + by * K(5, 5, j_qpts, i_elems)
-                                                          + bz * K(5, 4, j_qpts, i_elems))
-                                                  + bz * (bx * K(4, 0, j_qpts, i_elems)
-                                                          + by * K(4, 5, j_qpts, i_elems)
-                                                          + bz * K(4, 4, j_qpts, i_elems)));
-
-               Y(knodes, 1, i_elems) += c_detJ * (bx * (bx * K(5, 5, j_qpts, i_elems)
-                                                        + by * K(5, 1, j_qpts, i_elems)
-                                                        + bz * K(5, 3, j_qpts, i_elems))
-                                                  + by * (bx * K(1, 5, j_qpts, i_elems)
-                                                          + by * K(1, 1, j_qpts, i_elems)
-                                                          + bz * K(1, 3, j_qpts, i_elems))
-                                                  + bz * (bx * K(3, 5, j_qpts, i_elems)
-                                                          + by * K(3, 1, j_qpts, i_elems)
-                                                          + bz * K(3, 3, j_qpts, i_elems)));
-
-               Y(knodes, 2, i_elems) += c_detJ * (bx * (bx * K(4, 4, j_qpts, i_elems)
-                                                        + by * K(4, 3, j_qpts, i_elems)
-                                                        + bz * K(4, 2, j_qpts, i_elems))
-                                                  + by * (bx * K(3, 4, j_qpts, i_elems)
-                                                          + by * K(3, 3, j_qpts, i_elems)
-                                                          + bz * K(3, 2, j_qpts, i_elems))
-                                                  + bz * (bx * K(2, 4, j_qpts, i_elems)
-                                                          + by * K(2, 3, j_qpts, i_elems)
-                                                          + bz * K(2, 2, j_qpts, i_elems)));
+         } // End of doing tensor contraction of D_{jkmo}G_{op}X_{pm}
+         for (int k = 0; k < 9; k++) {
+            gX[k] = T[k];
+         }
+      } // End of nQpts
+      exaconstit::kernel::tensor_grad_trans_hex<T_D1D, T_Q1D>(d1d, q1d, B, G, map, gq, &Y[dim_ * nnodes_ * i_elems]);
+   }); // End of nelems
+}
+
+// Sum-factorized version of AssembleGradDiagonalPA for tensor-product hexahedral elements.
+// For each output component c we pull out the reference space 3x3 block
+// M_{jl} = D_{jccl} at every quadrature point, and then the diagonal is obtained
+// from 1D contractions of it.
+template<int T_D1D, int T_Q1D>
+void ExaNLFIntegrator::AssembleGradDiagonalPATensor(Vector &diag) const
+{
+   CALI_CXX_MARK_SCOPE("enlfi_AssembleGradDiagonalPA_tensor");
+
+   const int dim = 3;
+   const int DIM6 = 6;
+
+   RAJA::View<const double, RAJA::Layout<DIM6> > D(pa_dmat.Read(), nelems, nqpts, dim, dim, dim, dim);
+   // Packed version of D used when our material tangent is symmetric
+   const int dsize = exaconstit::kernel::PA_TAN_SYM_SIZE;
+   const double *Dsym = pa_dmat.Read();
+   const bool sym = pa_dmat_sym;
+
+   const int d1d = T_D1D ? T_D1D : ndofs1d;
+   const int q1d = T_Q1D ? T_Q1D : nqpts1d;
+   const int nqpts_ = q1d * q1d * q1d;
+   const int dim_ = dim;
+   const int nnodes_ = d1d * d1d * d1d;
+
+   const double *B = basis1d.Read();
+   const double *G = dbasis1d.Read();
+   const int *map = dof_map.Read();
+   double *Y = diag.ReadWrite();
+
+   MFEM_FORALL(i_elems, nelems, {
+      constexpr int MQ = T_Q1D ? T_Q1D : exaconstit::kernel::TENSOR_MAX_Q1D;
+      double mq[MQ * MQ * MQ * 18];
+      for (int j_qpts = 0; j_qpts < nqpts_; j_qpts++) {
+         const double *N = &Dsym[dsize * (j_qpts + nqpts_ * i_elems)];
+         for (int c = 0; c < dim_; c++) {
+            double M[9];
+            for (int l = 0; l < dim_; l++) {
+               for (int j = 0; j < dim_; j++) {
+                  if (sym) {
+                     const int u = j + 3 * c;
+                     const int v = l + 3 * c;
+                     M[j + 3 * l] = (u <= v) ? N[exaconstit::kernel::sym_tan_row(u) + v]
+                                    : N[exaconstit::kernel::sym_tan_row(v) + u];
+                  }
+                  else {
+                     M[j + 3 * l] = D(i_elems, j_qpts, j, c, c, l);
+                  }
+               }
             }
+            double *mqc = &mq[6 * (c + 3 * j_qpts)];
+            mqc[0] = M[0];
+            mqc[1] = M[4];
+            mqc[2] = M[8];
+            mqc[3] = M[3] + M[1];
+            mqc[4] = M[6] + M[2];
+            mqc[5] = M[7] + M[5];
          }
-      });
-   }
+      } // End of nQpts
+      exaconstit::kernel::tensor_grad_diag_hex<T_D1D, T_Q1D>(d1d, q1d, B, G, map, mq, &Y[dim_ * nnodes_ * i_elems]);
+   }); // End of nelems
 }
 
 /// Method defining element assembly.
@@ -756,10 +1235,9 @@ void ExaNLFIntegrator::AssembleGradEA(const Vector& /*x*/,const FiniteElementSpa
 void ExaNLFIntegrator::AssembleEA(const FiniteElementSpace &fes, Vector &emat)
 {
    CALI_CXX_MARK_SCOPE("enlfi_assembleEA");
-   Mesh *mesh = fes.GetMesh();
    const FiniteElement &el = *fes.GetFE(0);
    space_dims = el.GetDim();
-   const IntegrationRule *ir = &(IntRules.Get(el.GetGeomType(), 2 * el.GetOrder() + 1));
+   const IntegrationRule *ir = &GetKernelIntRule(el);
 
    nqpts = ir->GetNPoints();
    nnodes = el.GetDof();
@@ -787,233 +1265,228 @@ void ExaNLFIntegrator::AssembleEA(const FiniteElementSpace &fes, Vector &emat)
          grad.UseDevice(true);
       }
 
-      // geom->J really isn't going to work for us as of right now. We could just reorder it
-      // to the version that we want it to be in instead...
+      // Our jacobian normally comes from AssemblePA
       if (jacobian.Size() != (dim * dim * nqpts * nelems)) {
-         jacobian.SetSize(dim * dim * nqpts * nelems, mfem::Device::GetMemoryType());
-         jacobian.UseDevice(true);
-
-         geom = mesh->GetGeometricFactors(*ir, GeometricFactors::JACOBIANS);
-
-         const int DIM4 = 4;
-         std::array<RAJA::idx_t, DIM4> perm4 {{ 3, 2, 1, 0 } };
-
-         RAJA::Layout<DIM4> layout_jacob = RAJA::make_permuted_layout({{ dim, dim, nqpts, nelems } }, perm4);
-         RAJA::View<double, RAJA::Layout<DIM4, RAJA::Index_type, 0> > J(jacobian.ReadWrite(), layout_jacob);
-
-         RAJA::Layout<DIM4> layout_geom = RAJA::make_permuted_layout({{ nqpts, dim, dim, nelems } }, perm4);
-         RAJA::View<const double, RAJA::Layout<DIM4, RAJA::Index_type, 0> > geom_j_view(geom->J.Read(), layout_geom);
-         const int nqpts_ = nqpts;
-	 const int dim_ = dim;
-         MFEM_FORALL(i, nelems, {
-            for (int j = 0; j < nqpts_; j++) {
-               for (int k = 0; k < dim_; k++) {
-                  for (int l = 0; l < dim_; l++) {
-                     J(l, k, j, i) = geom_j_view(j, l, k, i);
-                  }
-               }
-            }
-         });
+         SetupJacobian(fes, *ir);
       }
 
-      const int DIM2 = 2;
-      const int DIM3 = 3;
-      const int DIM4 = 4;
+      // Compile time specialized kernels for hex8 / 2x2x2, hex27 / 3x3x3, and hex64 / 4x4x4
+      if ((nnodes == 8) && (nqpts == 8)) {
+         AssembleEAKernel<8, 8>(W, emat);
+      }
+      else if ((nnodes == 27) && (nqpts == 27)) {
+         AssembleEAKernel<27, 27>(W, emat);
+      }
+      else if ((nnodes == 64) && (nqpts == 64)) {
+         AssembleEAKernel<64, 64>(W, emat);
+      }
+      else {
+         AssembleEAKernel(W, emat);
+      }
+   }
+}
 
-      std::array<RAJA::idx_t, DIM4> perm4 {{ 3, 2, 1, 0 } };
-      std::array<RAJA::idx_t, DIM3> perm3 {{ 2, 1, 0 } };
-      std::array<RAJA::idx_t, DIM2> perm2 {{ 1, 0 } };
+template<int T_NNODES, int T_NQPTS>
+void ExaNLFIntegrator::AssembleEAKernel(const double *W, mfem::Vector &emat) const
+{
+   const int dim = 3;
+   const int DIM2 = 2;
+   const int DIM3 = 3;
+   const int DIM4 = 4;
 
-      // bunch of helper RAJA views to make dealing with data easier down below in our kernel.
+   std::array<RAJA::idx_t, DIM4> perm4 {{ 3, 2, 1, 0 } };
+   std::array<RAJA::idx_t, DIM3> perm3 {{ 2, 1, 0 } };
+   std::array<RAJA::idx_t, DIM2> perm2 {{ 1, 0 } };
 
-      RAJA::Layout<DIM4> layout_tensor = RAJA::make_permuted_layout({{ 2 * dim, 2 * dim, nqpts, nelems } }, perm4);
-      RAJA::View<const double, RAJA::Layout<DIM4, RAJA::Index_type, 0> > K(model->GetMatGrad()->Read(), layout_tensor);
+   // bunch of helper RAJA views to make dealing with data easier down below in our kernel.
 
-      // Our field variables that are inputs and outputs
-      RAJA::Layout<DIM3> layout_field = RAJA::make_permuted_layout({{ nnodes * dim, nnodes * dim, nelems } }, perm3);
-      RAJA::View<double, RAJA::Layout<DIM3, RAJA::Index_type, 0> > E(emat.ReadWrite(), layout_field);
+   RAJA::Layout<DIM4> layout_tensor = RAJA::make_permuted_layout({{ 2 * dim, 2 * dim, nqpts, nelems } }, perm4);
+   RAJA::View<const double, RAJA::Layout<DIM4, RAJA::Index_type, 0> > K(model->GetMatGrad()->Read(), layout_tensor);
 
-      RAJA::Layout<DIM4> layout_jacob = RAJA::make_permuted_layout({{ dim, dim, nqpts, nelems } }, perm4);
-      RAJA::View<const double, RAJA::Layout<DIM4, RAJA::Index_type, 0> > J(jacobian.Read(), layout_jacob);
+   // Our field variables that are inputs and outputs
+   RAJA::Layout<DIM3> layout_field = RAJA::make_permuted_layout({{ nnodes * dim, nnodes * dim, nelems } }, perm3);
+   RAJA::View<double, RAJA::Layout<DIM3, RAJA::Index_type, 0> > E(emat.ReadWrite(), layout_field);
 
-      RAJA::Layout<DIM2> layout_adj = RAJA::make_permuted_layout({{ dim, dim } }, perm2);
+   RAJA::Layout<DIM4> layout_jacob = RAJA::make_permuted_layout({{ dim, dim, nqpts, nelems } }, perm4);
+   RAJA::View<const double, RAJA::Layout<DIM4, RAJA::Index_type, 0> > J(jacobian.Read(), layout_jacob);
 
-      RAJA::Layout<DIM3> layout_grads = RAJA::make_permuted_layout({{ nnodes, dim, nqpts } }, perm3);
-      RAJA::View<const double, RAJA::Layout<DIM3, RAJA::Index_type, 0> > Gt(grad.Read(), layout_grads);
+   RAJA::Layout<DIM2> layout_adj = RAJA::make_permuted_layout({{ dim, dim } }, perm2);
 
-      double dt = model->GetModelDt();
-      const int nqpts_ = nqpts;
-      const int dim_ = dim;
-      const int nnodes_ = nnodes;
-      // This loop we'll want to parallelize the rest are all serial for now.
-      MFEM_FORALL(i_elems, nelems, {
-         double adj[dim_ * dim_];
-         double c_detJ;
-         // So, we're going to say this view is constant however we're going to mutate the values only in
-         // that one scoped section for the quadrature points.
-         RAJA::View<const double, RAJA::Layout<DIM2, RAJA::Index_type, 0> > A(&adj[0], layout_adj);
-         for (int j_qpts = 0; j_qpts < nqpts_; j_qpts++) {
-            // If we scope this then we only need to carry half the number of variables around with us for
-            // the adjugate term.
-            {
-               const double J11 = J(0, 0, j_qpts, i_elems); // 0,0
-               const double J21 = J(1, 0, j_qpts, i_elems); // 1,0
-               const double J31 = J(2, 0, j_qpts, i_elems); // 2,0
-               const double J12 = J(0, 1, j_qpts, i_elems); // 0,1
-               const double J22 = J(1, 1, j_qpts, i_elems); // 1,1
-               const double J32 = J(2, 1, j_qpts, i_elems); // 2,1
-               const double J13 = J(0, 2, j_qpts, i_elems); // 0,2
-               const double J23 = J(1, 2, j_qpts, i_elems); // 1,2
-               const double J33 = J(2, 2, j_qpts, i_elems); // 2,2
-               const double detJ = J11 * (J22 * J33 - J32 * J23) -
-                                   /* */ J21 * (J12 * J33 - J32 * J13) +
-                                   /* */ J31 * (J12 * J23 - J22 * J13);
-               c_detJ = 1.0 / detJ * W[j_qpts] * dt;
-               // adj(J)
-               adj[0] = (J22 * J33) - (J23 * J32); // 0,0
-               adj[1] = (J32 * J13) - (J12 * J33); // 0,1
-               adj[2] = (J12 * J23) - (J22 * J13); // 0,2
-               adj[3] = (J31 * J23) - (J21 * J33); // 1,0
-               adj[4] = (J11 * J33) - (J13 * J31); // 1,1
-               adj[5] = (J21 * J13) - (J11 * J23); // 1,2
-               adj[6] = (J21 * J32) - (J31 * J22); // 2,0
-               adj[7] = (J31 * J12) - (J11 * J32); // 2,1
-               adj[8] = (J11 * J22) - (J12 * J21); // 2,2
-            }
-            for (int knds = 0; knds < nnodes_; knds++) {
-               const double bx = Gt(knds, 0, j_qpts) * A(0, 0)
-                                 + Gt(knds, 1, j_qpts) * A(0, 1)
-                                 + Gt(knds, 2, j_qpts) * A(0, 2);
-
-               const double by = Gt(knds, 0, j_qpts) * A(1, 0)
-                                 + Gt(knds, 1, j_qpts) * A(1, 1)
-                                 + Gt(knds, 2, j_qpts) * A(1, 2);
-
-               const double bz = Gt(knds, 0, j_qpts) * A(2, 0)
-                                 + Gt(knds, 1, j_qpts) * A(2, 1)
-                                 + Gt(knds, 2, j_qpts) * A(2, 2);
-
-
-               const double k11x = c_detJ * (bx * K(0, 0, j_qpts, i_elems)
-                                             + by * K(0, 5, j_qpts, i_elems)
-                                             + bz * K(0, 4, j_qpts, i_elems));
-               const double k11y = c_detJ * (bx * K(5, 0, j_qpts, i_elems)
-                                             + by * K(5, 5, j_qpts, i_elems)
-                                             + bz * K(5, 4, j_qpts, i_elems));
-               const double k11z = c_detJ * (bx * K(4, 0, j_qpts, i_elems)
-                                             + by * K(4, 5, j_qpts, i_elems)
-                                             + bz * K(4, 4, j_qpts, i_elems));
-
-               const double k12x = c_detJ * (bx * K(0, 5, j_qpts, i_elems)
-                                             + by * K(0, 1, j_qpts, i_elems)
-                                             + bz * K(0, 3, j_qpts, i_elems));
-               const double k12y = c_detJ * (bx * K(5, 5, j_qpts, i_elems)
-                                             + by * K(5, 1, j_qpts, i_elems)
-                                             + bz * K(5, 3, j_qpts, i_elems));
-               const double k12z = c_detJ * (bx * K(4, 5, j_qpts, i_elems)
-                                             + by * K(4, 1, j_qpts, i_elems)
-                                             + bz * K(4, 3, j_qpts, i_elems));
-
-               const double k13x = c_detJ * (bx * K(0, 4, j_qpts, i_elems)
-                                             + by * K(0, 3, j_qpts, i_elems)
-                                             + bz * K(0, 2, j_qpts, i_elems));
-               const double k13y = c_detJ * (bx * K(5, 4, j_qpts, i_elems)
-                                             + by * K(5, 3, j_qpts, i_elems)
-                                             + bz * K(5, 2, j_qpts, i_elems));
-               const double k13z = c_detJ * (bx * K(4, 4, j_qpts, i_elems)
-                                             + by * K(4, 3, j_qpts, i_elems)
-                                             + bz * K(4, 2, j_qpts, i_elems));
-
-               const double k21x = c_detJ * (bx * K(5, 0, j_qpts, i_elems)
-                                             + by * K(5, 5, j_qpts, i_elems)
-                                             + bz * K(5, 4, j_qpts, i_elems));
-               const double k21y = c_detJ * (bx * K(1, 0, j_qpts, i_elems)
-                                             + by * K(1, 5, j_qpts, i_elems)
-                                             + bz * K(1, 4, j_qpts, i_elems));
-               const double k21z = c_detJ * (bx * K(3, 0, j_qpts, i_elems)
-                                             + by * K(3, 5, j_qpts, i_elems)
-                                             + bz * K(3, 4, j_qpts, i_elems));
-
-               const double k22x = c_detJ * (bx * K(5, 5, j_qpts, i_elems)
-                                             + by * K(5, 1, j_qpts, i_elems)
-                                             + bz * K(5, 3, j_qpts, i_elems));
-               const double k22y = c_detJ * (bx * K(1, 5, j_qpts, i_elems)
-                                             + by * K(1, 1, j_qpts, i_elems)
-                                             + bz * K(1, 3, j_qpts, i_elems));
-               const double k22z = c_detJ * (bx * K(3, 5, j_qpts, i_elems)
-                                             + by * K(3, 1, j_qpts, i_elems)
-                                             + bz * K(3, 3, j_qpts, i_elems));
-
-               const double k23x = c_detJ * (bx * K(5, 4, j_qpts, i_elems)
-                                             + by * K(5, 3, j_qpts, i_elems)
-                                             + bz * K(5, 2, j_qpts, i_elems));
-               const double k23y = c_detJ * (bx * K(1, 4, j_qpts, i_elems)
-                                             + by * K(1, 3, j_qpts, i_elems)
-                                             + bz * K(1, 2, j_qpts, i_elems));
-               const double k23z = c_detJ * (bx * K(3, 4, j_qpts, i_elems)
-                                             + by * K(3, 3, j_qpts, i_elems)
-                                             + bz * K(3, 2, j_qpts, i_elems));
-
-               const double k31x = c_detJ * (bx * K(4, 0, j_qpts, i_elems)
-                                             + by * K(4, 5, j_qpts, i_elems)
-                                             + bz * K(4, 4, j_qpts, i_elems));
-               const double k31y = c_detJ * (bx * K(3, 0, j_qpts, i_elems)
-                                             + by * K(3, 5, j_qpts, i_elems)
-                                             + bz * K(3, 4, j_qpts, i_elems));
-               const double k31z = c_detJ * (bx * K(2, 0, j_qpts, i_elems)
-                                             + by * K(2, 5, j_qpts, i_elems)
-                                             + bz * K(2, 4, j_qpts, i_elems));
-
-               const double k32x = c_detJ * (bx * K(4, 5, j_qpts, i_elems)
-                                             + by * K(4, 1, j_qpts, i_elems)
-                                             + bz * K(4, 3, j_qpts, i_elems));
-               const double k32y = c_detJ * (bx * K(3, 5, j_qpts, i_elems)
-                                             + by * K(3, 1, j_qpts, i_elems)
-                                             + bz * K(3, 3, j_qpts, i_elems));
-               const double k32z = c_detJ * (bx * K(2, 5, j_qpts, i_elems)
-                                             + by * K(2, 1, j_qpts, i_elems)
-                                             + bz * K(2, 3, j_qpts, i_elems));
-
-               const double k33x = c_detJ * (bx * K(4, 4, j_qpts, i_elems)
-                                             + by * K(4, 3, j_qpts, i_elems)
-                                             + bz * K(4, 2, j_qpts, i_elems));
-               const double k33y = c_detJ * (bx * K(3, 4, j_qpts, i_elems)
-                                             + by * K(3, 3, j_qpts, i_elems)
-                                             + bz * K(3, 2, j_qpts, i_elems));
-               const double k33z = c_detJ * (bx * K(2, 4, j_qpts, i_elems)
-                                             + by * K(2, 3, j_qpts, i_elems)
-                                             + bz * K(2, 2, j_qpts, i_elems));
-
-               for (int lnds = 0; lnds < nnodes_; lnds++) {
-                  const double gx = Gt(lnds, 0, j_qpts) * A(0, 0)
-                                    + Gt(lnds, 1, j_qpts) * A(0, 1)
-                                    + Gt(lnds, 2, j_qpts) * A(0, 2);
-
-                  const double gy = Gt(lnds, 0, j_qpts) * A(1, 0)
-                                    + Gt(lnds, 1, j_qpts) * A(1, 1)
-                                    + Gt(lnds, 2, j_qpts) * A(1, 2);
-
-                  const double gz = Gt(lnds, 0, j_qpts) * A(2, 0)
-                                    + Gt(lnds, 1, j_qpts) * A(2, 1)
-                                    + Gt(lnds, 2, j_qpts) * A(2, 2);
-
-
-                  E(lnds, knds, i_elems) += gx * k11x + gy * k11y + gz * k11z;
-                  E(lnds, knds + nnodes_, i_elems) += gx * k12x + gy * k12y + gz * k12z;
-                  E(lnds, knds + 2 * nnodes_, i_elems) += gx * k13x + gy * k13y + gz * k13z;
-
-                  E(lnds + nnodes_, knds, i_elems) += gx * k21x + gy * k21y + gz * k21z;
-                  E(lnds + nnodes_, knds + nnodes_, i_elems) += gx * k22x + gy * k22y + gz * k22z;
-                  E(lnds + nnodes_, knds + 2 * nnodes_, i_elems) += gx * k23x + gy * k23y + gz * k23z;
-
-                  E(lnds + 2 * nnodes_, knds, i_elems) += gx * k31x + gy * k31y + gz * k31z;
-                  E(lnds + 2 * nnodes_, knds + nnodes_, i_elems) += gx * k32x + gy * k32y + gz * k32z;
-                  E(lnds + 2 * nnodes_, knds + 2 * nnodes_, i_elems) += gx * k33x + gy * k33y + gz * k33z;
-               }
+   RAJA::Layout<DIM3> layout_grads = RAJA::make_permuted_layout({{ nnodes, dim, nqpts } }, perm3);
+   RAJA::View<const double, RAJA::Layout<DIM3, RAJA::Index_type, 0> > Gt(grad.Read(), layout_grads);
+
+   double dt = model->GetModelDt();
+   const int nqpts_ = T_NQPTS ? T_NQPTS : nqpts;
+   const int dim_ = dim;
+   const int nnodes_ = T_NNODES ? T_NNODES : nnodes;
+   // This loop we'll want to parallelize the rest are all serial for now.
+   MFEM_FORALL(i_elems, nelems, {
+      double adj[dim_ * dim_];
+      double c_detJ;
+      // So, we're going to say this view is constant however we're going to mutate the values only in
+      // that one scoped section for the quadrature points.
+      RAJA::View<const double, RAJA::Layout<DIM2, RAJA::Index_type, 0> > A(&adj[0], layout_adj);
+      for (int j_qpts = 0; j_qpts < nqpts_; j_qpts++) {
+         // If we scope this then we only need to carry half the number of variables around with us for
+         // the adjugate term.
+         {
+            const double J11 = J(0, 0, j_qpts, i_elems); // 0,0
+            const double J21 = J(1, 0, j_qpts, i_elems); // 1,0
+            const double J31 = J(2, 0, j_qpts, i_elems); // 2,0
+            const double J12 = J(0, 1, j_qpts, i_elems); // 0,1
+            const double J22 = J(1, 1, j_qpts, i_elems); // 1,1
+            const double J32 = J(2, 1, j_qpts, i_elems); // 2,1
+            const double J13 = J(0, 2, j_qpts, i_elems); // 0,2
+            const double J23 = J(1, 2, j_qpts, i_elems); // 1,2
+            const double J33 = J(2, 2, j_qpts, i_elems); // 2,2
+            const double detJ = J11 * (J22 * J33 - J32 * J23) -
+                                /* */ J21 * (J12 * J33 - J32 * J13) +
+                                /* */ J31 * (J12 * J23 - J22 * J13);
+            c_detJ = 1.0 / detJ * W[j_qpts] * dt;
+            // adj(J)
+            adj[0] = (J22 * J33) - (J23 * J32); // 0,0
+            adj[1] = (J32 * J13) - (J12 * J33); // 0,1
+            adj[2] = (J12 * J23) - (J22 * J13); // 0,2
+            adj[3] = (J31 * J23) - (J21 * J33); // 1,0
+            adj[4] = (J11 * J33) - (J13 * J31); // 1,1
+            adj[5] = (J21 * J13) - (J11 * J23); // 1,2
+            adj[6] = (J21 * J32) - (J31 * J22); // 2,0
+            adj[7] = (J31 * J12) - (J11 * J32); // 2,1
+            adj[8] = (J11 * J22) - (J12 * J21); // 2,2
+         }
+         for (int knds = 0; knds < nnodes_; knds++) {
+            const double bx = Gt(knds, 0, j_qpts) * A(0, 0)
+                              + Gt(knds, 1, j_qpts) * A(0, 1)
+                              + Gt(knds, 2, j_qpts) * A(0, 2);
+
+            const double by = Gt(knds, 0, j_qpts) * A(1, 0)
+                              + Gt(knds, 1, j_qpts) * A(1, 1)
+                              + Gt(knds, 2, j_qpts) * A(1, 2);
+
+            const double bz = Gt(knds, 0, j_qpts) * A(2, 0)
+                              + Gt(knds, 1, j_qpts) * A(2, 1)
+                              + Gt(knds, 2, j_qpts) * A(2, 2);
+
+
+            const double k11x = c_detJ * (bx * K(0, 0, j_qpts, i_elems)
+                                          + by * K(0, 5, j_qpts, i_elems)
+                                          + bz * K(0, 4, j_qpts, i_elems));
+            const double k11y = c_detJ * (bx * K(5, 0, j_qpts, i_elems)
+                                          + by * K(5, 5, j_qpts, i_elems)
+                                          + bz * K(5, 4, j_qpts, i_elems));
+            const double k11z = c_detJ * (bx * K(4, 0, j_qpts, i_elems)
+                                          + by * K(4, 5, j_qpts, i_elems)
+                                          + bz * K(4, 4, j_qpts, i_elems));
+
+            const double k12x = c_detJ * (bx * K(0, 5, j_qpts, i_elems)
+                                          + by * K(0, 1, j_qpts, i_elems)
+                                          + bz * K(0, 3, j_qpts, i_elems));
+            const double k12y = c_detJ * (bx * K(5, 5, j_qpts, i_elems)
+                                          + by * K(5, 1, j_qpts, i_elems)
+                                          + bz * K(5, 3, j_qpts, i_elems));
+            const double k12z = c_detJ * (bx * K(4, 5, j_qpts, i_elems)
+                                          + by * K(4, 1, j_qpts, i_elems)
+                                          + bz * K(4, 3, j_qpts, i_elems));
+
+            const double k13x = c_detJ * (bx * K(0, 4, j_qpts, i_elems)
+                                          + by * K(0, 3, j_qpts, i_elems)
+                                          + bz * K(0, 2, j_qpts, i_elems));
+            const double k13y = c_detJ * (bx * K(5, 4, j_qpts, i_elems)
+                                          + by * K(5, 3, j_qpts, i_elems)
+                                          + bz * K(5, 2, j_qpts, i_elems));
+            const double k13z = c_detJ * (bx * K(4, 4, j_qpts, i_elems)
+                                          + by * K(4, 3, j_qpts, i_elems)
+                                          + bz * K(4, 2, j_qpts, i_elems));
+
+            const double k21x = c_detJ * (bx * K(5, 0, j_qpts, i_elems)
+                                          + by * K(5, 5, j_qpts, i_elems)
+                                          + bz * K(5, 4, j_qpts, i_elems));
+            const double k21y = c_detJ * (bx * K(1, 0, j_qpts, i_elems)
+                                          + by * K(1, 5, j_qpts, i_elems)
+                                          + bz * K(1, 4, j_qpts, i_elems));
+            const double k21z = c_detJ * (bx * K(3, 0, j_qpts, i_elems)
+                                          + by * K(3, 5, j_qpts, i_elems)
+                                          + bz * K(3, 4, j_qpts, i_elems));
+
+            const double k22x = c_detJ * (bx * K(5, 5, j_qpts, i_elems)
+                                          + by * K(5, 1, j_qpts, i_elems)
+                                          + bz * K(5, 3, j_qpts, i_elems));
+            const double k22y = c_detJ * (bx * K(1, 5, j_qpts, i_elems)
+                                          + by * K(1, 1, j_qpts, i_elems)
+                                          + bz * K(1, 3, j_qpts, i_elems));
+            const double k22z = c_detJ * (bx * K(3, 5, j_qpts, i_elems)
+                                          + by * K(3, 1, j_qpts, i_elems)
+                                          + bz * K(3, 3, j_qpts, i_elems));
+
+            const double k23x = c_detJ * (bx * K(5, 4, j_qpts, i_elems)
+                                          + by * K(5, 3, j_qpts, i_elems)
+                                          + bz * K(5, 2, j_qpts, i_elems));
+            const double k23y = c_detJ * (bx * K(1, 4, j_qpts, i_elems)
+                                          + by * K(1, 3, j_qpts, i_elems)
+                                          + bz * K(1, 2, j_qpts, i_elems));
+            const double k23z = c_detJ * (bx * K(3, 4, j_qpts, i_elems)
+                                          + by * K(3, 3, j_qpts, i_elems)
+                                          + bz * K(3, 2, j_qpts, i_elems));
+
+            const double k31x = c_detJ * (bx * K(4, 0, j_qpts, i_elems)
+                                          + by * K(4, 5, j_qpts, i_elems)
+                                          + bz * K(4, 4, j_qpts, i_elems));
+            const double k31y = c_detJ * (bx * K(3, 0, j_qpts, i_elems)
+                                          + by * K(3, 5, j_qpts, i_elems)
+                                          + bz * K(3, 4, j_qpts, i_elems));
+            const double k31z = c_detJ * (bx * K(2, 0, j_qpts, i_elems)
+                                          + by * K(2, 5, j_qpts, i_elems)
+                                          + bz * K(2, 4, j_qpts, i_elems));
+
+            const double k32x = c_detJ * (bx * K(4, 5, j_qpts, i_elems)
+                                          + by * K(4, 1, j_qpts, i_elems)
+                                          + bz * K(4, 3, j_qpts, i_elems));
+            const double k32y = c_detJ * (bx * K(3, 5, j_qpts, i_elems)
+                                          + by * K(3, 1, j_qpts, i_elems)
+                                          + bz * K(3, 3, j_qpts, i_elems));
+            const double k32z = c_detJ * (bx * K(2, 5, j_qpts, i_elems)
+                                          + by * K(2, 1, j_qpts, i_elems)
+                                          + bz * K(2, 3, j_qpts, i_elems));
+
+            const double k33x = c_detJ * (bx * K(4, 4, j_qpts, i_elems)
+                                          + by * K(4, 3, j_qpts, i_elems)
+                                          + bz * K(4, 2, j_qpts, i_elems));
+            const double k33y = c_detJ * (bx * K(3, 4, j_qpts, i_elems)
+                                          + by * K(3, 3, j_qpts, i_elems)
+                                          + bz * K(3, 2, j_qpts, i_elems));
+            const double k33z = c_detJ * (bx * K(2, 4, j_qpts, i_elems)
+                                          + by * K(2, 3, j_qpts, i_elems)
+                                          + bz * K(2, 2, j_qpts, i_elems));
+
+            for (int lnds = 0; lnds < nnodes_; lnds++) {
+               const double gx = Gt(lnds, 0, j_qpts) * A(0, 0)
+                                 + Gt(lnds, 1, j_qpts) * A(0, 1)
+                                 + Gt(lnds, 2, j_qpts) * A(0, 2);
+
+               const double gy = Gt(lnds, 0, j_qpts) * A(1, 0)
+                                 + Gt(lnds, 1, j_qpts) * A(1, 1)
+                                 + Gt(lnds, 2, j_qpts) * A(1, 2);
+
+               const double gz = Gt(lnds, 0, j_qpts) * A(2, 0)
+                                 + Gt(lnds, 1, j_qpts) * A(2, 1)
+                                 + Gt(lnds, 2, j_qpts) * A(2, 2);
+
+
+               E(lnds, knds, i_elems) += gx * k11x + gy * k11y + gz * k11z;
+               E(lnds, knds + nnodes_, i_elems) += gx * k12x + gy * k12y + gz * k12z;
+               E(lnds, knds + 2 * nnodes_, i_elems) += gx * k13x + gy * k13y + gz * k13z;
+
+               E(lnds + nnodes_, knds, i_elems) += gx * k21x + gy * k21y + gz * k21z;
+               E(lnds + nnodes_, knds + nnodes_, i_elems) += gx * k22x + gy * k22y + gz * k22z;
+               E(lnds + nnodes_, knds + 2 * nnodes_, i_elems) += gx * k23x + gy * k23y + gz * k23z;
+
+               E(lnds + 2 * nnodes_, knds, i_elems) += gx * k31x + gy * k31y + gz * k31z;
+               E(lnds + 2 * nnodes_, knds + nnodes_, i_elems) += gx * k32x + gy * k32y + gz * k32z;
+               E(lnds + 2 * nnodes_, knds + 2 * nnodes_, i_elems) += gx * k33x + gy * k33y + gz * k33z;
             }
          }
-      });
-   }
+      }
+   });
 }
 
 // Outside of the UMAT function calls this should be the function called
@@ -1197,7 +1670,7 @@ void ICExaNLFIntegrator::AssembleEA(const mfem::FiniteElementSpace &fes, mfem::V
    CALI_CXX_MARK_SCOPE("icenlfi_assembleEA");
    const FiniteElement &el = *fes.GetFE(0);
    space_dims = el.GetDim();
-   const IntegrationRule *ir = &(IntRules.Get(el.GetGeomType(), 2 * el.GetOrder() + 1));
+   const IntegrationRule *ir = &GetKernelIntRule(el);
 
    nqpts = ir->GetNPoints();
    nnodes = el.GetDof();
@@ -1208,9 +1681,532 @@ void ICExaNLFIntegrator::AssembleEA(const mfem::FiniteElementSpace &fes, mfem::V
       MFEM_ABORT("Dimensions of 1 or 2 not supported.");
    }
 
+   else {
+      // Compile time specialized kernels for hex8 / 2x2x2, hex27 / 3x3x3, and hex64 / 4x4x4
+      if ((nnodes == 8) && (nqpts == 8)) {
+         AssembleEAKernel<8, 8>(W, emat);
+      }
+      else if ((nnodes == 27) && (nqpts == 27)) {
+         AssembleEAKernel<27, 27>(W, emat);
+      }
+      else if ((nnodes == 64) && (nqpts == 64)) {
+         AssembleEAKernel<64, 64>(W, emat);
+      }
+      else {
+         AssembleEAKernel(W, emat);
+      }
+   }
+
+}
+
+template<int T_NNODES, int T_NQPTS>
+void ICExaNLFIntegrator::AssembleEAKernel(const double *W, mfem::Vector &emat) const
+{
+   const int dim = 3;
+   const int DIM2 = 2;
+   const int DIM3 = 3;
+   const int DIM4 = 4;
+
+   std::array<RAJA::idx_t, DIM4> perm4 {{ 3, 2, 1, 0 } };
+   std::array<RAJA::idx_t, DIM3> perm3 {{ 2, 1, 0 } };
+   std::array<RAJA::idx_t, DIM2> perm2 {{ 1, 0 } };
+
+   // bunch of helper RAJA views to make dealing with data easier down below in our kernel.
+
+   // Our field variables that are inputs and outputs
+
+   RAJA::Layout<DIM3> layout_egrads = RAJA::make_permuted_layout({{ nnodes, dim, nelems } }, perm3);
+   RAJA::View<const double, RAJA::Layout<DIM3, RAJA::Index_type, 0> > eDS_view(eDS.Read(), layout_egrads);
+
+   RAJA::Layout<DIM4> layout_tensor = RAJA::make_permuted_layout({{ 2 * dim, 2 * dim, nqpts, nelems } }, perm4);
+   RAJA::View<const double, RAJA::Layout<DIM4, RAJA::Index_type, 0> > K(model->GetMatGrad()->Read(), layout_tensor);
+
+   // Our field variables that are inputs and outputs
+   RAJA::Layout<DIM3> layout_field = RAJA::make_permuted_layout({{ nnodes * dim, nnodes * dim, nelems } }, perm3);
+   RAJA::View<double, RAJA::Layout<DIM3, RAJA::Index_type, 0> > E(emat.ReadWrite(), layout_field);
+
+   RAJA::Layout<DIM4> layout_jacob = RAJA::make_permuted_layout({{ dim, dim, nqpts, nelems } }, perm4);
+   RAJA::View<const double, RAJA::Layout<DIM4, RAJA::Index_type, 0> > J(jacobian.Read(), layout_jacob);
+
+   RAJA::Layout<DIM2> layout_adj = RAJA::make_permuted_layout({{ dim, dim } }, perm2);
+
+   RAJA::Layout<DIM3> layout_grads = RAJA::make_permuted_layout({{ nnodes, dim, nqpts } }, perm3);
+   RAJA::View<const double, RAJA::Layout<DIM3, RAJA::Index_type, 0> > Gt(grad.Read(), layout_grads);
+
+   double dt = model->GetModelDt();
+   const double i3 = 1.0 / 3.0;
+   const int nqpts_ = T_NQPTS ? T_NQPTS : nqpts;
+   const int dim_ = dim;
+   const int nnodes_ = T_NNODES ? T_NNODES : nnodes;
+   // This loop we'll want to parallelize the rest are all serial for now.
+   MFEM_FORALL(i_elems, nelems, {
+      double adj[dim_ * dim_];
+      double c_detJ;
+      double idetJ;
+      // So, we're going to say this view is constant however we're going to mutate the values only in
+      // that one scoped section for the quadrature points.
+      RAJA::View<const double, RAJA::Layout<DIM2, RAJA::Index_type, 0> > A(&adj[0], layout_adj);
+      for (int j_qpts = 0; j_qpts < nqpts_; j_qpts++) {
+         // If we scope this then we only need to carry half the number of variables around with us for
+         // the adjugate term.
+         {
+            const double J11 = J(0, 0, j_qpts, i_elems); // 0,0
+            const double J21 = J(1, 0, j_qpts, i_elems); // 1,0
+            const double J31 = J(2, 0, j_qpts, i_elems); // 2,0
+            const double J12 = J(0, 1, j_qpts, i_elems); // 0,1
+            const double J22 = J(1, 1, j_qpts, i_elems); // 1,1
+            const double J32 = J(2, 1, j_qpts, i_elems); // 2,1
+            const double J13 = J(0, 2, j_qpts, i_elems); // 0,2
+            const double J23 = J(1, 2, j_qpts, i_elems); // 1,2
+            const double J33 = J(2, 2, j_qpts, i_elems); // 2,2
+            const double detJ = J11 * (J22 * J33 - J32 * J23) -
+                                /* */ J21 * (J12 * J33 - J32 * J13) +
+                                /* */ J31 * (J12 * J23 - J22 * J13);
+            idetJ = 1.0 / detJ;
+            c_detJ = detJ * W[j_qpts] * dt;
+            // adj(J)
+            adj[0] = (J22 * J33) - (J23 * J32); // 0,0
+            adj[1] = (J32 * J13) - (J12 * J33); // 0,1
+            adj[2] = (J12 * J23) - (J22 * J13); // 0,2
+            adj[3] = (J31 * J23) - (J21 * J33); // 1,0
+            adj[4] = (J11 * J33) - (J13 * J31); // 1,1
+            adj[5] = (J21 * J13) - (J11 * J23); // 1,2
+            adj[6] = (J21 * J32) - (J31 * J22); // 2,0
+            adj[7] = (J31 * J12) - (J11 * J32); // 2,1
+            adj[8] = (J11 * J22) - (J12 * J21); // 2,2
+         }
+         for (int knds = 0; knds < nnodes_; knds++) {
+            const double bx = idetJ * (Gt(knds, 0, j_qpts) * A(0, 0)
+                                     + Gt(knds, 1, j_qpts) * A(0, 1)
+                                     + Gt(knds, 2, j_qpts) * A(0, 2));
+
+            const double by = idetJ * (Gt(knds, 0, j_qpts) * A(1, 0)
+                                     + Gt(knds, 1, j_qpts) * A(1, 1)
+                                     + Gt(knds, 2, j_qpts) * A(1, 2));
+
+            const double bz = idetJ * (Gt(knds, 0, j_qpts) * A(2, 0)
+                                     + Gt(knds, 1, j_qpts) * A(2, 1)
+                                     + Gt(knds, 2, j_qpts) * A(2, 2));
+            const double b4 = i3 * (eDS_view(knds, 0, i_elems) - bx);
+            const double b5 = b4 + bx;
+            const double b6 = i3 * (eDS_view(knds, 1, i_elems) - by);
+            const double b7 = b6 + by;
+            const double b8 = i3 * (eDS_view(knds, 2, i_elems) - bz);
+            const double b9 = b8 + bz;
+
+
+            const double k11w = c_detJ * (b4 * K(1, 1, j_qpts, i_elems)
+                                        + b4 * K(1, 2, j_qpts, i_elems)
+                                        + b5 * K(1, 0, j_qpts, i_elems)
+                                        + by * K(1, 5, j_qpts, i_elems)
+                                        + bz * K(1, 4, j_qpts, i_elems)
+                                        + b4 * K(2, 1, j_qpts, i_elems)
+                                        + b4 * K(2, 2, j_qpts, i_elems)
+                                        + b5 * K(2, 0, j_qpts, i_elems)
+                                        + by * K(2, 5, j_qpts, i_elems)
+                                        + bz * K(2, 4, j_qpts, i_elems));
+
+            const double k11x = c_detJ * (b4 * K(0, 1, j_qpts, i_elems)
+                                        + b4 * K(0, 2, j_qpts, i_elems)
+                                        + b5 * K(0, 0, j_qpts, i_elems)
+                                        + by * K(0, 5, j_qpts, i_elems)
+                                        + bz * K(0, 4, j_qpts, i_elems));
+
+            const double k11y = c_detJ * (b4 * K(5, 1, j_qpts, i_elems)
+                                        + b4 * K(5, 2, j_qpts, i_elems)
+                                        + b5 * K(5, 0, j_qpts, i_elems)
+                                        + by * K(5, 5, j_qpts, i_elems)
+                                        + bz * K(5, 4, j_qpts, i_elems));
+
+            const double k11z = c_detJ * (b4 * K(4, 1, j_qpts, i_elems)
+                                        + b4 * K(4, 2, j_qpts, i_elems)
+                                        + b5 * K(4, 0, j_qpts, i_elems)
+                                        + by * K(4, 5, j_qpts, i_elems)
+                                        + bz * K(4, 4, j_qpts, i_elems));
+
+            const double k12w = c_detJ * (b6 * K(1, 0, j_qpts, i_elems)
+                                        + b6 * K(1, 2, j_qpts, i_elems)
+                                        + b7 * K(1, 1, j_qpts, i_elems)
+                                        + bx * K(1, 5, j_qpts, i_elems)
+                                        + bz * K(1, 3, j_qpts, i_elems)
+                                        + b6 * K(2, 0, j_qpts, i_elems)
+                                        + b6 * K(2, 2, j_qpts, i_elems)
+                                        + b7 * K(2, 1, j_qpts, i_elems)
+                                        + bx * K(2, 5, j_qpts, i_elems)
+                                        + bz * K(2, 3, j_qpts, i_elems));
+
+            const double k12x = c_detJ * (b6 * K(0, 0, j_qpts, i_elems)
+                                        + b6 * K(0, 2, j_qpts, i_elems)
+                                        + b7 * K(0, 1, j_qpts, i_elems)
+                                        + bx * K(0, 5, j_qpts, i_elems)
+                                        + bz * K(0, 3, j_qpts, i_elems));
+
+            const double k12y = c_detJ * (b6 * K(5, 0, j_qpts, i_elems)
+                                        + b6 * K(5, 2, j_qpts, i_elems)
+                                        + b7 * K(5, 1, j_qpts, i_elems)
+                                        + bx * K(5, 5, j_qpts, i_elems)
+                                        + bz * K(5, 3, j_qpts, i_elems));
+
+            const double k12z = c_detJ * (b6 * K(4, 0, j_qpts, i_elems)
+                                        + b6 * K(4, 2, j_qpts, i_elems)
+                                        + b7 * K(4, 1, j_qpts, i_elems)
+                                        + bx * K(4, 5, j_qpts, i_elems)
+                                        + bz * K(4, 3, j_qpts, i_elems));
+
+            const double k13w = c_detJ * (b8 * K(1, 0, j_qpts, i_elems)
+                                        + b8 * K(1, 1, j_qpts, i_elems)
+                                        + b9 * K(1, 2, j_qpts, i_elems)
+                                        + bx * K(1, 4, j_qpts, i_elems)
+                                        + by * K(1, 3, j_qpts, i_elems)
+                                        + b8 * K(2, 0, j_qpts, i_elems)
+                                        + b8 * K(2, 1, j_qpts, i_elems)
+                                        + b9 * K(2, 2, j_qpts, i_elems)
+                                        + bx * K(2, 4, j_qpts, i_elems)
+                                        + by * K(2, 3, j_qpts, i_elems));
+
+            const double k13x = c_detJ * (b8 * K(0, 0, j_qpts, i_elems)
+                                        + b8 * K(0, 1, j_qpts, i_elems)
+                                        + b9 * K(0, 2, j_qpts, i_elems)
+                                        + bx * K(0, 4, j_qpts, i_elems)
+                                        + by * K(0, 3, j_qpts, i_elems));
+
+            const double k13y = c_detJ * (b8 * K(5, 0, j_qpts, i_elems)
+                                        + b8 * K(5, 1, j_qpts, i_elems)
+                                        + b9 * K(5, 2, j_qpts, i_elems)
+                                        + bx * K(5, 4, j_qpts, i_elems)
+                                        + by * K(5, 3, j_qpts, i_elems));
+
+            const double k13z = c_detJ * (b8 * K(4, 0, j_qpts, i_elems)
+                                        + b8 * K(4, 1, j_qpts, i_elems)
+                                        + b9 * K(4, 2, j_qpts, i_elems)
+                                        + bx * K(4, 4, j_qpts, i_elems)
+                                        + by * K(4, 3, j_qpts, i_elems));
+
+            const double k21w = c_detJ * (b4 * K(0, 1, j_qpts, i_elems)
+                                        + b4 * K(0, 2, j_qpts, i_elems)
+                                        + b5 * K(0, 0, j_qpts, i_elems)
+                                        + by * K(0, 5, j_qpts, i_elems)
+                                        + bz * K(0, 4, j_qpts, i_elems)
+                                        + b4 * K(2, 1, j_qpts, i_elems)
+                                        + b4 * K(2, 2, j_qpts, i_elems)
+                                        + b5 * K(2, 0, j_qpts, i_elems)
+                                        + by * K(2, 5, j_qpts, i_elems)
+                                        + bz * K(2, 4, j_qpts, i_elems));
+
+            const double k21x = c_detJ * (b4 * K(1, 1, j_qpts, i_elems)
+                                        + b4 * K(1, 2, j_qpts, i_elems)
+                                        + b5 * K(1, 0, j_qpts, i_elems)
+                                        + by * K(1, 5, j_qpts, i_elems)
+                                        + bz * K(1, 4, j_qpts, i_elems));
+
+            const double k21y = c_detJ * (b4 * K(5, 1, j_qpts, i_elems)
+                                        + b4 * K(5, 2, j_qpts, i_elems)
+                                        + b5 * K(5, 0, j_qpts, i_elems)
+                                        + by * K(5, 5, j_qpts, i_elems)
+                                        + bz * K(5, 4, j_qpts, i_elems));
+
+            const double k21z = c_detJ * (b4 * K(3, 1, j_qpts, i_elems)
+                                        + b4 * K(3, 2, j_qpts, i_elems)
+                                        + b5 * K(3, 0, j_qpts, i_elems)
+                                        + by * K(3, 5, j_qpts, i_elems)
+                                        + bz * K(3, 4, j_qpts, i_elems));
+
+            const double k22w = c_detJ * (b6 * K(0, 0, j_qpts, i_elems)
+                                        + b6 * K(0, 2, j_qpts, i_elems)
+                                        + b7 * K(0, 1, j_qpts, i_elems)
+                                        + bx * K(0, 5, j_qpts, i_elems)
+                                        + bz * K(0, 3, j_qpts, i_elems)
+                                        + b6 * K(2, 0, j_qpts, i_elems)
+                                        + b6 * K(2, 2, j_qpts, i_elems)
+                                        + b7 * K(2, 1, j_qpts, i_elems)
+                                        + bx * K(2, 5, j_qpts, i_elems)
+                                        + bz * K(2, 3, j_qpts, i_elems));
+
+            const double k22x = c_detJ * (b6 * K(1, 0, j_qpts, i_elems)
+                                        + b6 * K(1, 2, j_qpts, i_elems)
+                                        + b7 * K(1, 1, j_qpts, i_elems)
+                                        + bx * K(1, 5, j_qpts, i_elems)
+                                        + bz * K(1, 3, j_qpts, i_elems));
+
+            const double k22y = c_detJ * (b6 * K(5, 0, j_qpts, i_elems)
+                                        + b6 * K(5, 2, j_qpts, i_elems)
+                                        + b7 * K(5, 1, j_qpts, i_elems)
+                                        + bx * K(5, 5, j_qpts, i_elems)
+                                        + bz * K(5, 3, j_qpts, i_elems));
+
+            const double k22z = c_detJ * (b6 * K(3, 0, j_qpts, i_elems)
+                                        + b6 * K(3, 2, j_qpts, i_elems)
+                                        + b7 * K(3, 1, j_qpts, i_elems)
+                                        + bx * K(3, 5, j_qpts, i_elems)
+                                        + bz * K(3, 3, j_qpts, i_elems));
+
+            const double k23w = c_detJ * (b8 * K(0, 0, j_qpts, i_elems)
+                                        + b8 * K(0, 1, j_qpts, i_elems)
+                                        + b9 * K(0, 2, j_qpts, i_elems)
+                                        + bx * K(0, 4, j_qpts, i_elems)
+                                        + by * K(0, 3, j_qpts, i_elems)
+                                        + b8 * K(2, 0, j_qpts, i_elems)
+                                        + b8 * K(2, 1, j_qpts, i_elems)
+                                        + b9 * K(2, 2, j_qpts, i_elems)
+                                        + bx * K(2, 4, j_qpts, i_elems)
+                                        + by * K(2, 3, j_qpts, i_elems));
+
+            const double k23x = c_detJ * (b8 * K(1, 0, j_qpts, i_elems)
+                                        + b8 * K(1, 1, j_qpts, i_elems)
+                                        + b9 * K(1, 2, j_qpts, i_elems)
+                                        + bx * K(1, 4, j_qpts, i_elems)
+                                        + by * K(1, 3, j_qpts, i_elems));
+
+            const double k23y = c_detJ * (b8 * K(5, 0, j_qpts, i_elems)
+                                        + b8 * K(5, 1, j_qpts, i_elems)
+                                        + b9 * K(5, 2, j_qpts, i_elems)
+                                        + bx * K(5, 4, j_qpts, i_elems)
+                                        + by * K(5, 3, j_qpts, i_elems));
+
+            const double k23z = c_detJ * (b8 * K(3, 0, j_qpts, i_elems)
+                                        + b8 * K(3, 1, j_qpts, i_elems)
+                                        + b9 * K(3, 2, j_qpts, i_elems)
+                                        + bx * K(3, 4, j_qpts, i_elems)
+                                        + by * K(3, 3, j_qpts, i_elems));
+
+            const double k31w = c_detJ * (b4 * K(0, 1, j_qpts, i_elems)
+                                        + b4 * K(0, 2, j_qpts, i_elems)
+                                        + b5 * K(0, 0, j_qpts, i_elems)
+                                        + by * K(0, 5, j_qpts, i_elems)
+                                        + bz * K(0, 4, j_qpts, i_elems)
+                                        + b4 * K(1, 1, j_qpts, i_elems)
+                                        + b4 * K(1, 2, j_qpts, i_elems)
+                                        + b5 * K(1, 0, j_qpts, i_elems)
+                                        + by * K(1, 5, j_qpts, i_elems)
+                                        + bz * K(1, 4, j_qpts, i_elems));
+
+            const double k31x = c_detJ * (b4 * K(2, 1, j_qpts, i_elems)
+                                        + b4 * K(2, 2, j_qpts, i_elems)
+                                        + b5 * K(2, 0, j_qpts, i_elems)
+                                        + by * K(2, 5, j_qpts, i_elems)
+                                        + bz * K(2, 4, j_qpts, i_elems));
+
+            const double k31y = c_detJ * (b4 * K(4, 1, j_qpts, i_elems)
+                                        + b4 * K(4, 2, j_qpts, i_elems)
+                                        + b5 * K(4, 0, j_qpts, i_elems)
+                                        + by * K(4, 5, j_qpts, i_elems)
+                                        + bz * K(4, 4, j_qpts, i_elems));
+
+            const double k31z = c_detJ * (b4 * K(3, 1, j_qpts, i_elems)
+                                        + b4 * K(3, 2, j_qpts, i_elems)
+                                        + b5 * K(3, 0, j_qpts, i_elems)
+                                        + by * K(3, 5, j_qpts, i_elems)
+                                        + bz * K(3, 4, j_qpts, i_elems));
+
+            const double k32w = c_detJ * (b6 * K(0, 0, j_qpts, i_elems)
+                                        + b6 * K(0, 2, j_qpts, i_elems)
+                                        + b7 * K(0, 1, j_qpts, i_elems)
+                                        + bx * K(0, 5, j_qpts, i_elems)
+                                        + bz * K(0, 3, j_qpts, i_elems)
+                                        + b6 * K(1, 0, j_qpts, i_elems)
+                                        + b6 * K(1, 2, j_qpts, i_elems)
+                                        + b7 * K(1, 1, j_qpts, i_elems)
+                                        + bx * K(1, 5, j_qpts, i_elems)
+                                        + bz * K(1, 3, j_qpts, i_elems));
+
+            const double k32x = c_detJ * (b6 * K(2, 0, j_qpts, i_elems)
+                                        + b6 * K(2, 2, j_qpts, i_elems)
+                                        + b7 * K(2, 1, j_qpts, i_elems)
+                                        + bx * K(2, 5, j_qpts, i_elems)
+                                        + bz * K(2, 3, j_qpts, i_elems));
+
+            const double k32y = c_detJ * (b6 * K(4, 0, j_qpts, i_elems)
+                                        + b6 * K(4, 2, j_qpts, i_elems)
+                                        + b7 * K(4, 1, j_qpts, i_elems)
+                                        + bx * K(4, 5, j_qpts, i_elems)
+                                        + bz * K(4, 3, j_qpts, i_elems));
+
+            const double k32z = c_detJ * (b6 * K(3, 0, j_qpts, i_elems)
+                                        + b6 * K(3, 2, j_qpts, i_elems)
+                                        + b7 * K(3, 1, j_qpts, i_elems)
+                                        + bx * K(3, 5, j_qpts, i_elems)
+                                        + bz * K(3, 3, j_qpts, i_elems));
+
+            const double k33w = c_detJ * (b8 * K(0, 0, j_qpts, i_elems)
+                                        + b8 * K(0, 1, j_qpts, i_elems)
+                                        + b9 * K(0, 2, j_qpts, i_elems)
+                                        + bx * K(0, 4, j_qpts, i_elems)
+                                        + by * K(0, 3, j_qpts, i_elems)
+                                        + b8 * K(1, 0, j_qpts, i_elems)
+                                        + b8 * K(1, 1, j_qpts, i_elems)
+                                        + b9 * K(1, 2, j_qpts, i_elems)
+                                        + bx * K(1, 4, j_qpts, i_elems)
+                                        + by * K(1, 3, j_qpts, i_elems));
+
+            const double k33x = c_detJ * (b8 * K(2, 0, j_qpts, i_elems)
+                                        + b8 * K(2, 1, j_qpts, i_elems)
+                                        + b9 * K(2, 2, j_qpts, i_elems)
+                                        + bx * K(2, 4, j_qpts, i_elems)
+                                        + by * K(2, 3, j_qpts, i_elems));
+
+            const double k33y = c_detJ * (b8 * K(4, 0, j_qpts, i_elems)
+                                        + b8 * K(4, 1, j_qpts, i_elems)
+                                        + b9 * K(4, 2, j_qpts, i_elems)
+                                        + bx * K(4, 4, j_qpts, i_elems)
+                                        + by * K(4, 3, j_qpts, i_elems));
+
+            const double k33z = c_detJ * (b8 * K(3, 0, j_qpts, i_elems)
+                                        + b8 * K(3, 1, j_qpts, i_elems)
+                                        + b9 * K(3, 2, j_qpts, i_elems)
+                                        + bx * K(3, 4, j_qpts, i_elems)
+                                        + by * K(3, 3, j_qpts, i_elems));
+
+            for (int lnds = 0; lnds < nnodes_; lnds++) {
+               const double gx = idetJ * (Gt(lnds, 0, j_qpts) * A(0, 0)
+                                        + Gt(lnds, 1, j_qpts) * A(0, 1)
+                                        + Gt(lnds, 2, j_qpts) * A(0, 2));
+
+               const double gy = idetJ * (Gt(lnds, 0, j_qpts) * A(1, 0)
+                                        + Gt(lnds, 1, j_qpts) * A(1, 1)
+                                        + Gt(lnds, 2, j_qpts) * A(1, 2));
+
+               const double gz = idetJ * (Gt(lnds, 0, j_qpts) * A(2, 0)
+                                        + Gt(lnds, 1, j_qpts) * A(2, 1)
+                                        + Gt(lnds, 2, j_qpts) * A(2, 2));
+
+               const double g4 = i3 * (eDS_view(lnds, 0, i_elems) - gx);
+               const double g5 = g4 + gx;
+               const double g6 = i3 * (eDS_view(lnds, 1, i_elems) - gy);
+               const double g7 = g6 + gy;
+               const double g8 = i3 * (eDS_view(lnds, 2, i_elems) - gz);
+               const double g9 = g8 + gz;
+
+               E(lnds, knds, i_elems) += g4 * k11w + g5 * k11x + gy * k11y + gz * k11z;
+               E(lnds, knds + nnodes_, i_elems) += g4 * k12w + g5 * k12x + gy * k12y + gz * k12z; 
+               E(lnds, knds + 2 * nnodes_, i_elems) += g4 * k13w + g5 * k13x + gy * k13y + gz * k13z;
+
+               E(lnds + nnodes_, knds, i_elems) += g6 * k21w + g7 * k21x + gx * k21y + gz * k21z;
+               E(lnds + nnodes_, knds + nnodes_, i_elems) += g6 * k22w + g7 * k22x + gx * k22y + gz * k22z;
+               E(lnds + nnodes_, knds + 2 * nnodes_, i_elems) += g6 * k23w + g7 * k23x + gx * k23y + gz * k23z;
+
+               E(lnds + 2 * nnodes_, knds, i_elems) += g8 * k31w + g9 * k31x + gx * k31y + gy * k31z;
+               E(lnds + 2 * nnodes_, knds + nnodes_, i_elems) += g8 * k32w + g9 * k32x + gx * k32y + gy * k32z;
+               E(lnds + 2 * nnodes_, knds + 2 * nnodes_, i_elems) += g8 * k33w + g9 * k33x + gx * k33y + gy * k33z;
+            }
+         }
+      }
+   });
+}
+
+// In the below function we'll be applying the below action on our material
+// tangent matrix C^{tan} at each quadrature point as:
+// D_{ij} = det(J) * w_{qpt} * dt * C^{tan}_{ij}
+// where C^{tan} is kept in its 6x6 Voigt form. Unlike the ExaNLFIntegrator version we
+// can't fold the adj(J) terms into D, since the Bbar strain mixes the quadrature point
+// gradients with the element averaged volumetric term eDS. So, the adj(J) terms are
+// instead applied on the fly in AddMultGradPA.
+void ICExaNLFIntegrator::AssembleGradPA(const FiniteElementSpace &fes)
+{
+   CALI_CXX_MARK_SCOPE("icenlfi_assemblePAG");
+   const FiniteElement &el = *fes.GetFE(0);
+   space_dims = el.GetDim();
+
+   // Our shape function gradients, jacobians, and eDS terms all come from AssemblePA
+   // which is normally called right before us.
+   if (eDS.Size() != (el.GetDof() * space_dims * fes.GetNE())) {
+      AssemblePA(fes);
+   }
+
+   const IntegrationRule *ir = &GetKernelIntRule(el);
+   auto W = ir->GetWeights().Read();
+
+   if ((space_dims == 1) || (space_dims == 2)) {
+      MFEM_ABORT("Dimensions of 1 or 2 not supported.");
+   }
    else {
       const int dim = 3;
+      const int dim2 = 2 * dim;
+
+      if (pa_dmat.Size() != (dim2 * dim2 * nqpts * nelems)) {
+         pa_dmat.SetSize(dim2 * dim2 * nqpts * nelems, mfem::Device::GetMemoryType());
+         pa_dmat.UseDevice(true);
+      }
+      pa_dmat_sym = false;
+
+      const int DIM4 = 4;
+      std::array<RAJA::idx_t, DIM4> perm4 {{ 3, 2, 1, 0 } };
+
+      RAJA::Layout<DIM4> layout_tensor = RAJA::make_permuted_layout({{ dim2, dim2, nqpts, nelems } }, perm4);
+      RAJA::View<const double, RAJA::Layout<DIM4, RAJA::Index_type, 0> > K(model->GetMatGrad()->Read(), layout_tensor);
+      RAJA::View<double, RAJA::Layout<DIM4, RAJA::Index_type, 0> > D(pa_dmat.Write(), layout_tensor);
+
+      RAJA::Layout<DIM4> layout_jacob = RAJA::make_permuted_layout({{ dim, dim, nqpts, nelems } }, perm4);
+      RAJA::View<const double, RAJA::Layout<DIM4, RAJA::Index_type, 0> > J(jacobian.Read(), layout_jacob);
+
+      // When asked for it we also assemble the diagonal of our gradient in this same pass
+      // over the quadrature points rather than rereading our tangent in AssembleGradDiagonalPA.
+      const bool fuse_diag = (pa_diag != nullptr);
+      double *Yd = fuse_diag ? pa_diag->ReadWrite() : nullptr;
+      const double *Gt = grad.Read();
+      const double *eds = eDS.Read();
+
+      double dt = model->GetModelDt();
+      const int nqpts_ = nqpts;
+      const int nnodes_ = nnodes;
+      const int dim_ = dim;
+      const int dim2_ = dim2;
+      // This loop we'll want to parallelize the rest are all serial for now.
+      MFEM_FORALL(i_elems, nelems, {
+         for (int j_qpts = 0; j_qpts < nqpts_; j_qpts++) {
+            const double J11 = J(0, 0, j_qpts, i_elems); // 0,0
+            const double J21 = J(1, 0, j_qpts, i_elems); // 1,0
+            const double J31 = J(2, 0, j_qpts, i_elems); // 2,0
+            const double J12 = J(0, 1, j_qpts, i_elems); // 0,1
+            const double J22 = J(1, 1, j_qpts, i_elems); // 1,1
+            const double J32 = J(2, 1, j_qpts, i_elems); // 2,1
+            const double J13 = J(0, 2, j_qpts, i_elems); // 0,2
+            const double J23 = J(1, 2, j_qpts, i_elems); // 1,2
+            const double J33 = J(2, 2, j_qpts, i_elems); // 2,2
+            const double detJ = J11 * (J22 * J33 - J32 * J23) -
+                                /* */ J21 * (J12 * J33 - J32 * J13) +
+                                /* */ J31 * (J12 * J23 - J22 * J13);
+            const double c_detJ = detJ * W[j_qpts] * dt;
+            for (int j = 0; j < dim2_; j++) {
+               for (int i = 0; i < dim2_; i++) {
+                  D(i, j, j_qpts, i_elems) = c_detJ * K(i, j, j_qpts, i_elems);
+               }
+            }
+            if (fuse_diag) {
+               double adj[dim_ * dim_];
+               adj[0] = (J22 * J33) - (J23 * J32); // 0,0
+               adj[1] = (J32 * J13) - (J12 * J33); // 0,1
+               adj[2] = (J12 * J23) - (J22 * J13); // 0,2
+               adj[3] = (J31 * J23) - (J21 * J33); // 1,0
+               adj[4] = (J11 * J33) - (J13 * J31); // 1,1
+               adj[5] = (J21 * J13) - (J11 * J23); // 1,2
+               adj[6] = (J21 * J32) - (J31 * J22); // 2,0
+               adj[7] = (J31 * J12) - (J11 * J32); // 2,1
+               adj[8] = (J11 * J22) - (J12 * J21); // 2,2
+               exaconstit::kernel::bbar_grad_diag_qpt(nnodes_, 1.0, &D(0, 0, j_qpts, i_elems), adj, 1.0 / detJ,
+                                                      &Gt[nnodes_ * dim_ * j_qpts],
+                                                      &eds[nnodes_ * dim_ * i_elems],
+                                                      &Yd[nnodes_ * dim_ * i_elems]);
+            }
+         } // End of quadrature loop
+      }); // End of Elements loop
+   } // End of else statement
+}
 
+// Here we're applying the action of the Bbar tangent stiffness matrix
+// y = Bbar^T D Bbar x
+// without ever forming it. The Bbar strain rate at a quadrature point is the
+// symmetric part of the velocity gradient L with its volumetric part replaced by the
+// element averaged one, which is just eDS : x. Going back to the nodes we then have
+// the deviatoric part of our stress like term contracted with our shape function
+// gradients plus the mean of it summed over the quadrature points contracted with eDS.
+void ICExaNLFIntegrator::AddMultGradPA(const mfem::Vector &x, mfem::Vector &y) const
+{
+   CALI_CXX_MARK_SCOPE("icenlfi_amPAG");
+   if ((space_dims == 1) || (space_dims == 2)) {
+      MFEM_ABORT("Dimensions of 1 or 2 not supported.");
+   }
+   else {
+      const int dim = 3;
       const int DIM2 = 2;
       const int DIM3 = 3;
       const int DIM4 = 4;
@@ -1219,41 +2215,51 @@ void ICExaNLFIntegrator::AssembleEA(const mfem::FiniteElementSpace &fes, mfem::V
       std::array<RAJA::idx_t, DIM3> perm3 {{ 2, 1, 0 } };
       std::array<RAJA::idx_t, DIM2> perm2 {{ 1, 0 } };
 
-      // bunch of helper RAJA views to make dealing with data easier down below in our kernel.
-
-      // Our field variables that are inputs and outputs
-
-      RAJA::Layout<DIM3> layout_egrads = RAJA::make_permuted_layout({{ nnodes, dim, nelems } }, perm3);
-      RAJA::View<const double, RAJA::Layout<DIM3, RAJA::Index_type, 0> > eDS_view(eDS.Read(), layout_egrads);
-
       RAJA::Layout<DIM4> layout_tensor = RAJA::make_permuted_layout({{ 2 * dim, 2 * dim, nqpts, nelems } }, perm4);
-      RAJA::View<const double, RAJA::Layout<DIM4, RAJA::Index_type, 0> > K(model->GetMatGrad()->Read(), layout_tensor);
-
-      // Our field variables that are inputs and outputs
-      RAJA::Layout<DIM3> layout_field = RAJA::make_permuted_layout({{ nnodes * dim, nnodes * dim, nelems } }, perm3);
-      RAJA::View<double, RAJA::Layout<DIM3, RAJA::Index_type, 0> > E(emat.ReadWrite(), layout_field);
+      RAJA::View<const double, RAJA::Layout<DIM4, RAJA::Index_type, 0> > D(pa_dmat.Read(), layout_tensor);
 
       RAJA::Layout<DIM4> layout_jacob = RAJA::make_permuted_layout({{ dim, dim, nqpts, nelems } }, perm4);
       RAJA::View<const double, RAJA::Layout<DIM4, RAJA::Index_type, 0> > J(jacobian.Read(), layout_jacob);
 
-      RAJA::Layout<DIM2> layout_adj = RAJA::make_permuted_layout({{ dim, dim } }, perm2);
-
+      // Our field variables that are inputs and outputs
+      RAJA::Layout<DIM3> layout_field = RAJA::make_permuted_layout({{ nnodes, dim, nelems } }, perm3);
+      RAJA::View<const double, RAJA::Layout<DIM3, RAJA::Index_type, 0> > X(x.Read(), layout_field);
+      RAJA::View<double, RAJA::Layout<DIM3, RAJA::Index_type, 0> > Y(y.ReadWrite(), layout_field);
+      // Transpose of the local gradient variable
       RAJA::Layout<DIM3> layout_grads = RAJA::make_permuted_layout({{ nnodes, dim, nqpts } }, perm3);
       RAJA::View<const double, RAJA::Layout<DIM3, RAJA::Index_type, 0> > Gt(grad.Read(), layout_grads);
 
-      double dt = model->GetModelDt();
+      RAJA::Layout<DIM3> layout_egrads = RAJA::make_permuted_layout({{ nnodes, dim, nelems } }, perm3);
+      RAJA::View<const double, RAJA::Layout<DIM3, RAJA::Index_type, 0> > eDS_view(eDS.Read(), layout_egrads);
+
+      RAJA::Layout<DIM2> layout_adj = RAJA::make_permuted_layout({{ dim, dim } }, perm2);
+
       const double i3 = 1.0 / 3.0;
       const int nqpts_ = nqpts;
       const int dim_ = dim;
-      const int nnodes_ = nnodes; 
-      // This loop we'll want to parallelize the rest are all serial for now.
-      MFEM_FORALL(i_elems, nelems, {
+      const int nnodes_ = nnodes;
+      // We might only be applying our operator to a subset of our elements
+      const int nsel = pa_elems ? pa_elems->Size() : nelems;
+      const int *sel = pa_elems ? pa_elems->Read() : nullptr;
+
+      MFEM_FORALL(i_sel, nsel, {
+         const int i_elems = sel ? sel[i_sel] : i_sel;
          double adj[dim_ * dim_];
-         double c_detJ;
          double idetJ;
          // So, we're going to say this view is constant however we're going to mutate the values only in
          // that one scoped section for the quadrature points.
          RAJA::View<const double, RAJA::Layout<DIM2, RAJA::Index_type, 0> > A(&adj[0], layout_adj);
+
+         // Element averaged volumetric strain rate eDS : x
+         double evol = 0.0;
+         for (int k = 0; k < dim_; k++) {
+            for (int i = 0; i < nnodes_; i++) {
+               evol += eDS_view(i, k, i_elems) * X(i, k, i_elems);
+            }
+         }
+         // Sum of the mean of our stress like term over all the quadrature points
+         double pbar = 0.0;
+
          for (int j_qpts = 0; j_qpts < nqpts_; j_qpts++) {
             // If we scope this then we only need to carry half the number of variables around with us for
             // the adjugate term.
@@ -1271,7 +2277,6 @@ void ICExaNLFIntegrator::AssembleEA(const mfem::FiniteElementSpace &fes, mfem::V
                                    /* */ J21 * (J12 * J33 - J32 * J13) +
                                    /* */ J31 * (J12 * J23 - J22 * J13);
                idetJ = 1.0 / detJ;
-               c_detJ = detJ * W[j_qpts] * dt;
                // adj(J)
                adj[0] = (J22 * J33) - (J23 * J32); // 0,0
                adj[1] = (J32 * J13) - (J12 * J33); // 0,1
@@ -1283,324 +2288,76 @@ void ICExaNLFIntegrator::AssembleEA(const mfem::FiniteElementSpace &fes, mfem::V
                adj[7] = (J31 * J12) - (J11 * J32); // 2,1
                adj[8] = (J11 * J22) - (J12 * J21); // 2,2
             }
-            for (int knds = 0; knds < nnodes_; knds++) {
-               const double bx = idetJ * (Gt(knds, 0, j_qpts) * A(0, 0)
-                                        + Gt(knds, 1, j_qpts) * A(0, 1)
-                                        + Gt(knds, 2, j_qpts) * A(0, 2));
 
-               const double by = idetJ * (Gt(knds, 0, j_qpts) * A(1, 0)
-                                        + Gt(knds, 1, j_qpts) * A(1, 1)
-                                        + Gt(knds, 2, j_qpts) * A(1, 2));
+            // Reference gradient of x: gX_{ia} = X_{ki} Gt_{ka}
+            double gX[9] = { 0, 0, 0, 0, 0, 0, 0, 0, 0 };
+            for (int a = 0; a < dim_; a++) {
+               for (int i = 0; i < dim_; i++) {
+                  for (int k = 0; k < nnodes_; k++) {
+                     gX[i + dim_ * a] += Gt(k, a, j_qpts) * X(k, i, i_elems);
+                  }
+               }
+            }
 
-               const double bz = idetJ * (Gt(knds, 0, j_qpts) * A(2, 0)
-                                        + Gt(knds, 1, j_qpts) * A(2, 1)
-                                        + Gt(knds, 2, j_qpts) * A(2, 2));
-               const double b4 = i3 * (eDS_view(knds, 0, i_elems) - bx);
-               const double b5 = b4 + bx;
-               const double b6 = i3 * (eDS_view(knds, 1, i_elems) - by);
-               const double b7 = b6 + by;
-               const double b8 = i3 * (eDS_view(knds, 2, i_elems) - bz);
-               const double b9 = b8 + bz;
+            // Velocity gradient L_{ij} = gX_{ia} adj(J)_{aj} / det(J)
+            double L[9];
+            for (int j = 0; j < dim_; j++) {
+               for (int i = 0; i < dim_; i++) {
+                  L[i + dim_ * j] = idetJ * (gX[i] * A(j, 0) + gX[i + dim_] * A(j, 1) + gX[i + 2 * dim_] * A(j, 2));
+               }
+            }
+
+            // Bbar strain rate in Voigt notation using engineering shear strains
+            double eps[6];
+            {
+               const double dvol = i3 * (evol - (L[0] + L[4] + L[8]));
+               eps[0] = L[0] + dvol;
+               eps[1] = L[4] + dvol;
+               eps[2] = L[8] + dvol;
+               eps[3] = L[5] + L[7];
+               eps[4] = L[2] + L[6];
+               eps[5] = L[1] + L[3];
+            }
+
+            double sig[6] = { 0, 0, 0, 0, 0, 0 };
+            for (int n = 0; n < 6; n++) {
+               for (int m = 0; m < 6; m++) {
+                  sig[m] += D(m, n, j_qpts, i_elems) * eps[n];
+               }
+            }
 
+            // The volumetric part of sig goes back through eDS and the deviatoric part
+            // through our quadrature point gradients.
+            const double smean = i3 * (sig[0] + sig[1] + sig[2]);
+            pbar += smean;
+            const double S[9] = { sig[0] - smean, sig[5], sig[4],
+                                  sig[5], sig[1] - smean, sig[3],
+                                  sig[4], sig[3], sig[2] - smean };
 
-               const double k11w = c_detJ * (b4 * K(1, 1, j_qpts, i_elems)
-                                           + b4 * K(1, 2, j_qpts, i_elems)
-                                           + b5 * K(1, 0, j_qpts, i_elems)
-                                           + by * K(1, 5, j_qpts, i_elems)
-                                           + bz * K(1, 4, j_qpts, i_elems)
-                                           + b4 * K(2, 1, j_qpts, i_elems)
-                                           + b4 * K(2, 2, j_qpts, i_elems)
-                                           + b5 * K(2, 0, j_qpts, i_elems)
-                                           + by * K(2, 5, j_qpts, i_elems)
-                                           + bz * K(2, 4, j_qpts, i_elems));
-
-               const double k11x = c_detJ * (b4 * K(0, 1, j_qpts, i_elems)
-                                           + b4 * K(0, 2, j_qpts, i_elems)
-                                           + b5 * K(0, 0, j_qpts, i_elems)
-                                           + by * K(0, 5, j_qpts, i_elems)
-                                           + bz * K(0, 4, j_qpts, i_elems));
-
-               const double k11y = c_detJ * (b4 * K(5, 1, j_qpts, i_elems)
-                                           + b4 * K(5, 2, j_qpts, i_elems)
-                                           + b5 * K(5, 0, j_qpts, i_elems)
-                                           + by * K(5, 5, j_qpts, i_elems)
-                                           + bz * K(5, 4, j_qpts, i_elems));
-
-               const double k11z = c_detJ * (b4 * K(4, 1, j_qpts, i_elems)
-                                           + b4 * K(4, 2, j_qpts, i_elems)
-                                           + b5 * K(4, 0, j_qpts, i_elems)
-                                           + by * K(4, 5, j_qpts, i_elems)
-                                           + bz * K(4, 4, j_qpts, i_elems));
-
-               const double k12w = c_detJ * (b6 * K(1, 0, j_qpts, i_elems)
-                                           + b6 * K(1, 2, j_qpts, i_elems)
-                                           + b7 * K(1, 1, j_qpts, i_elems)
-                                           + bx * K(1, 5, j_qpts, i_elems)
-                                           + bz * K(1, 3, j_qpts, i_elems)
-                                           + b6 * K(2, 0, j_qpts, i_elems)
-                                           + b6 * K(2, 2, j_qpts, i_elems)
-                                           + b7 * K(2, 1, j_qpts, i_elems)
-                                           + bx * K(2, 5, j_qpts, i_elems)
-                                           + bz * K(2, 3, j_qpts, i_elems));
-
-               const double k12x = c_detJ * (b6 * K(0, 0, j_qpts, i_elems)
-                                           + b6 * K(0, 2, j_qpts, i_elems)
-                                           + b7 * K(0, 1, j_qpts, i_elems)
-                                           + bx * K(0, 5, j_qpts, i_elems)
-                                           + bz * K(0, 3, j_qpts, i_elems));
-
-               const double k12y = c_detJ * (b6 * K(5, 0, j_qpts, i_elems)
-                                           + b6 * K(5, 2, j_qpts, i_elems)
-                                           + b7 * K(5, 1, j_qpts, i_elems)
-                                           + bx * K(5, 5, j_qpts, i_elems)
-                                           + bz * K(5, 3, j_qpts, i_elems));
-
-               const double k12z = c_detJ * (b6 * K(4, 0, j_qpts, i_elems)
-                                           + b6 * K(4, 2, j_qpts, i_elems)
-                                           + b7 * K(4, 1, j_qpts, i_elems)
-                                           + bx * K(4, 5, j_qpts, i_elems)
-                                           + bz * K(4, 3, j_qpts, i_elems));
-
-               const double k13w = c_detJ * (b8 * K(1, 0, j_qpts, i_elems)
-                                           + b8 * K(1, 1, j_qpts, i_elems)
-                                           + b9 * K(1, 2, j_qpts, i_elems)
-                                           + bx * K(1, 4, j_qpts, i_elems)
-                                           + by * K(1, 3, j_qpts, i_elems)
-                                           + b8 * K(2, 0, j_qpts, i_elems)
-                                           + b8 * K(2, 1, j_qpts, i_elems)
-                                           + b9 * K(2, 2, j_qpts, i_elems)
-                                           + bx * K(2, 4, j_qpts, i_elems)
-                                           + by * K(2, 3, j_qpts, i_elems));
-
-               const double k13x = c_detJ * (b8 * K(0, 0, j_qpts, i_elems)
-                                           + b8 * K(0, 1, j_qpts, i_elems)
-                                           + b9 * K(0, 2, j_qpts, i_elems)
-                                           + bx * K(0, 4, j_qpts, i_elems)
-                                           + by * K(0, 3, j_qpts, i_elems));
-
-               const double k13y = c_detJ * (b8 * K(5, 0, j_qpts, i_elems)
-                                           + b8 * K(5, 1, j_qpts, i_elems)
-                                           + b9 * K(5, 2, j_qpts, i_elems)
-                                           + bx * K(5, 4, j_qpts, i_elems)
-                                           + by * K(5, 3, j_qpts, i_elems));
-
-               const double k13z = c_detJ * (b8 * K(4, 0, j_qpts, i_elems)
-                                           + b8 * K(4, 1, j_qpts, i_elems)
-                                           + b9 * K(4, 2, j_qpts, i_elems)
-                                           + bx * K(4, 4, j_qpts, i_elems)
-                                           + by * K(4, 3, j_qpts, i_elems));
-
-               const double k21w = c_detJ * (b4 * K(0, 1, j_qpts, i_elems)
-                                           + b4 * K(0, 2, j_qpts, i_elems)
-                                           + b5 * K(0, 0, j_qpts, i_elems)
-                                           + by * K(0, 5, j_qpts, i_elems)
-                                           + bz * K(0, 4, j_qpts, i_elems)
-                                           + b4 * K(2, 1, j_qpts, i_elems)
-                                           + b4 * K(2, 2, j_qpts, i_elems)
-                                           + b5 * K(2, 0, j_qpts, i_elems)
-                                           + by * K(2, 5, j_qpts, i_elems)
-                                           + bz * K(2, 4, j_qpts, i_elems));
-
-               const double k21x = c_detJ * (b4 * K(1, 1, j_qpts, i_elems)
-                                           + b4 * K(1, 2, j_qpts, i_elems)
-                                           + b5 * K(1, 0, j_qpts, i_elems)
-                                           + by * K(1, 5, j_qpts, i_elems)
-                                           + bz * K(1, 4, j_qpts, i_elems));
-
-               const double k21y = c_detJ * (b4 * K(5, 1, j_qpts, i_elems)
-                                           + b4 * K(5, 2, j_qpts, i_elems)
-                                           + b5 * K(5, 0, j_qpts, i_elems)
-                                           + by * K(5, 5, j_qpts, i_elems)
-                                           + bz * K(5, 4, j_qpts, i_elems));
-
-               const double k21z = c_detJ * (b4 * K(3, 1, j_qpts, i_elems)
-                                           + b4 * K(3, 2, j_qpts, i_elems)
-                                           + b5 * K(3, 0, j_qpts, i_elems)
-                                           + by * K(3, 5, j_qpts, i_elems)
-                                           + bz * K(3, 4, j_qpts, i_elems));
-
-               const double k22w = c_detJ * (b6 * K(0, 0, j_qpts, i_elems)
-                                           + b6 * K(0, 2, j_qpts, i_elems)
-                                           + b7 * K(0, 1, j_qpts, i_elems)
-                                           + bx * K(0, 5, j_qpts, i_elems)
-                                           + bz * K(0, 3, j_qpts, i_elems)
-                                           + b6 * K(2, 0, j_qpts, i_elems)
-                                           + b6 * K(2, 2, j_qpts, i_elems)
-                                           + b7 * K(2, 1, j_qpts, i_elems)
-                                           + bx * K(2, 5, j_qpts, i_elems)
-                                           + bz * K(2, 3, j_qpts, i_elems));
-
-               const double k22x = c_detJ * (b6 * K(1, 0, j_qpts, i_elems)
-                                           + b6 * K(1, 2, j_qpts, i_elems)
-                                           + b7 * K(1, 1, j_qpts, i_elems)
-                                           + bx * K(1, 5, j_qpts, i_elems)
-                                           + bz * K(1, 3, j_qpts, i_elems));
-
-               const double k22y = c_detJ * (b6 * K(5, 0, j_qpts, i_elems)
-                                           + b6 * K(5, 2, j_qpts, i_elems)
-                                           + b7 * K(5, 1, j_qpts, i_elems)
-                                           + bx * K(5, 5, j_qpts, i_elems)
-                                           + bz * K(5, 3, j_qpts, i_elems));
-
-               const double k22z = c_detJ * (b6 * K(3, 0, j_qpts, i_elems)
-                                           + b6 * K(3, 2, j_qpts, i_elems)
-                                           + b7 * K(3, 1, j_qpts, i_elems)
-                                           + bx * K(3, 5, j_qpts, i_elems)
-                                           + bz * K(3, 3, j_qpts, i_elems));
-
-               const double k23w = c_detJ * (b8 * K(0, 0, j_qpts, i_elems)
-                                           + b8 * K(0, 1, j_qpts, i_elems)
-                                           + b9 * K(0, 2, j_qpts, i_elems)
-                                           + bx * K(0, 4, j_qpts, i_elems)
-                                           + by * K(0, 3, j_qpts, i_elems)
-                                           + b8 * K(2, 0, j_qpts, i_elems)
-                                           + b8 * K(2, 1, j_qpts, i_elems)
-                                           + b9 * K(2, 2, j_qpts, i_elems)
-                                           + bx * K(2, 4, j_qpts, i_elems)
-                                           + by * K(2, 3, j_qpts, i_elems));
-
-               const double k23x = c_detJ * (b8 * K(1, 0, j_qpts, i_elems)
-                                           + b8 * K(1, 1, j_qpts, i_elems)
-                                           + b9 * K(1, 2, j_qpts, i_elems)
-                                           + bx * K(1, 4, j_qpts, i_elems)
-                                           + by * K(1, 3, j_qpts, i_elems));
-
-               const double k23y = c_detJ * (b8 * K(5, 0, j_qpts, i_elems)
-                                           + b8 * K(5, 1, j_qpts, i_elems)
-                                           + b9 * K(5, 2, j_qpts, i_elems)
-                                           + bx * K(5, 4, j_qpts, i_elems)
-                                           + by * K(5, 3, j_qpts, i_elems));
-
-               const double k23z = c_detJ * (b8 * K(3, 0, j_qpts, i_elems)
-                                           + b8 * K(3, 1, j_qpts, i_elems)
-                                           + b9 * K(3, 2, j_qpts, i_elems)
-                                           + bx * K(3, 4, j_qpts, i_elems)
-                                           + by * K(3, 3, j_qpts, i_elems));
-
-               const double k31w = c_detJ * (b4 * K(0, 1, j_qpts, i_elems)
-                                           + b4 * K(0, 2, j_qpts, i_elems)
-                                           + b5 * K(0, 0, j_qpts, i_elems)
-                                           + by * K(0, 5, j_qpts, i_elems)
-                                           + bz * K(0, 4, j_qpts, i_elems)
-                                           + b4 * K(1, 1, j_qpts, i_elems)
-                                           + b4 * K(1, 2, j_qpts, i_elems)
-                                           + b5 * K(1, 0, j_qpts, i_elems)
-                                           + by * K(1, 5, j_qpts, i_elems)
-                                           + bz * K(1, 4, j_qpts, i_elems));
-
-               const double k31x = c_detJ * (b4 * K(2, 1, j_qpts, i_elems)
-                                           + b4 * K(2, 2, j_qpts, i_elems)
-                                           + b5 * K(2, 0, j_qpts, i_elems)
-                                           + by * K(2, 5, j_qpts, i_elems)
-                                           + bz * K(2, 4, j_qpts, i_elems));
-
-               const double k31y = c_detJ * (b4 * K(4, 1, j_qpts, i_elems)
-                                           + b4 * K(4, 2, j_qpts, i_elems)
-                                           + b5 * K(4, 0, j_qpts, i_elems)
-                                           + by * K(4, 5, j_qpts, i_elems)
-                                           + bz * K(4, 4, j_qpts, i_elems));
-
-               const double k31z = c_detJ * (b4 * K(3, 1, j_qpts, i_elems)
-                                           + b4 * K(3, 2, j_qpts, i_elems)
-                                           + b5 * K(3, 0, j_qpts, i_elems)
-                                           + by * K(3, 5, j_qpts, i_elems)
-                                           + bz * K(3, 4, j_qpts, i_elems));
-
-               const double k32w = c_detJ * (b6 * K(0, 0, j_qpts, i_elems)
-                                           + b6 * K(0, 2, j_qpts, i_elems)
-                                           + b7 * K(0, 1, j_qpts, i_elems)
-                                           + bx * K(0, 5, j_qpts, i_elems)
-                                           + bz * K(0, 3, j_qpts, i_elems)
-                                           + b6 * K(1, 0, j_qpts, i_elems)
-                                           + b6 * K(1, 2, j_qpts, i_elems)
-                                           + b7 * K(1, 1, j_qpts, i_elems)
-                                           + bx * K(1, 5, j_qpts, i_elems)
-                                           + bz * K(1, 3, j_qpts, i_elems));
-
-               const double k32x = c_detJ * (b6 * K(2, 0, j_qpts, i_elems)
-                                           + b6 * K(2, 2, j_qpts, i_elems)
-                                           + b7 * K(2, 1, j_qpts, i_elems)
-                                           + bx * K(2, 5, j_qpts, i_elems)
-                                           + bz * K(2, 3, j_qpts, i_elems));
-
-               const double k32y = c_detJ * (b6 * K(4, 0, j_qpts, i_elems)
-                                           + b6 * K(4, 2, j_qpts, i_elems)
-                                           + b7 * K(4, 1, j_qpts, i_elems)
-                                           + bx * K(4, 5, j_qpts, i_elems)
-                                           + bz * K(4, 3, j_qpts, i_elems));
-
-               const double k32z = c_detJ * (b6 * K(3, 0, j_qpts, i_elems)
-                                           + b6 * K(3, 2, j_qpts, i_elems)
-                                           + b7 * K(3, 1, j_qpts, i_elems)
-                                           + bx * K(3, 5, j_qpts, i_elems)
-                                           + bz * K(3, 3, j_qpts, i_elems));
-
-               const double k33w = c_detJ * (b8 * K(0, 0, j_qpts, i_elems)
-                                           + b8 * K(0, 1, j_qpts, i_elems)
-                                           + b9 * K(0, 2, j_qpts, i_elems)
-                                           + bx * K(0, 4, j_qpts, i_elems)
-                                           + by * K(0, 3, j_qpts, i_elems)
-                                           + b8 * K(1, 0, j_qpts, i_elems)
-                                           + b8 * K(1, 1, j_qpts, i_elems)
-                                           + b9 * K(1, 2, j_qpts, i_elems)
-                                           + bx * K(1, 4, j_qpts, i_elems)
-                                           + by * K(1, 3, j_qpts, i_elems));
-
-               const double k33x = c_detJ * (b8 * K(2, 0, j_qpts, i_elems)
-                                           + b8 * K(2, 1, j_qpts, i_elems)
-                                           + b9 * K(2, 2, j_qpts, i_elems)
-                                           + bx * K(2, 4, j_qpts, i_elems)
-                                           + by * K(2, 3, j_qpts, i_elems));
-
-               const double k33y = c_detJ * (b8 * K(4, 0, j_qpts, i_elems)
-                                           + b8 * K(4, 1, j_qpts, i_elems)
-                                           + b9 * K(4, 2, j_qpts, i_elems)
-                                           + bx * K(4, 4, j_qpts, i_elems)
-                                           + by * K(4, 3, j_qpts, i_elems));
-
-               const double k33z = c_detJ * (b8 * K(3, 0, j_qpts, i_elems)
-                                           + b8 * K(3, 1, j_qpts, i_elems)
-                                           + b9 * K(3, 2, j_qpts, i_elems)
-                                           + bx * K(3, 4, j_qpts, i_elems)
-                                           + by * K(3, 3, j_qpts, i_elems));
-
-               for (int lnds = 0; lnds < nnodes_; lnds++) {
-                  const double gx = idetJ * (Gt(lnds, 0, j_qpts) * A(0, 0)
-                                           + Gt(lnds, 1, j_qpts) * A(0, 1)
-                                           + Gt(lnds, 2, j_qpts) * A(0, 2));
-
-                  const double gy = idetJ * (Gt(lnds, 0, j_qpts) * A(1, 0)
-                                           + Gt(lnds, 1, j_qpts) * A(1, 1)
-                                           + Gt(lnds, 2, j_qpts) * A(1, 2));
-
-                  const double gz = idetJ * (Gt(lnds, 0, j_qpts) * A(2, 0)
-                                           + Gt(lnds, 1, j_qpts) * A(2, 1)
-                                           + Gt(lnds, 2, j_qpts) * A(2, 2));
-
-                  const double g4 = i3 * (eDS_view(lnds, 0, i_elems) - gx);
-                  const double g5 = g4 + gx;
-                  const double g6 = i3 * (eDS_view(lnds, 1, i_elems) - gy);
-                  const double g7 = g6 + gy;
-                  const double g8 = i3 * (eDS_view(lnds, 2, i_elems) - gz);
-                  const double g9 = g8 + gz;
-
-                  E(lnds, knds, i_elems) += g4 * k11w + g5 * k11x + gy * k11y + gz * k11z;
-                  E(lnds, knds + nnodes_, i_elems) += g4 * k12w + g5 * k12x + gy * k12y + gz * k12z; 
-                  E(lnds, knds + 2 * nnodes_, i_elems) += g4 * k13w + g5 * k13x + gy * k13y + gz * k13z;
-
-                  E(lnds + nnodes_, knds, i_elems) += g6 * k21w + g7 * k21x + gx * k21y + gz * k21z;
-                  E(lnds + nnodes_, knds + nnodes_, i_elems) += g6 * k22w + g7 * k22x + gx * k22y + gz * k22z;
-                  E(lnds + nnodes_, knds + 2 * nnodes_, i_elems) += g6 * k23w + g7 * k23x + gx * k23y + gz * k23z;
-
-                  E(lnds + 2 * nnodes_, knds, i_elems) += g8 * k31w + g9 * k31x + gx * k31y + gy * k31z;
-                  E(lnds + 2 * nnodes_, knds + nnodes_, i_elems) += g8 * k32w + g9 * k32x + gx * k32y + gy * k32z;
-                  E(lnds + 2 * nnodes_, knds + 2 * nnodes_, i_elems) += g8 * k33w + g9 * k33x + gx * k33y + gy * k33z;
+            // Take S back to the reference frame: T_{ai} = adj(J)_{aj} S_{ij} / det(J)
+            double T[9];
+            for (int i = 0; i < dim_; i++) {
+               for (int a = 0; a < dim_; a++) {
+                  T[a + dim_ * i] = idetJ * (A(0, a) * S[i] + A(1, a) * S[i + dim_] + A(2, a) * S[i + 2 * dim_]);
                }
             }
-         }
-      });
-   }
 
+            for (int i = 0; i < dim_; i++) {
+               for (int a = 0; a < dim_; a++) {
+                  for (int k = 0; k < nnodes_; k++) {
+                     Y(k, i, i_elems) += Gt(k, a, j_qpts) * T[a + dim_ * i];
+                  }
+               }
+            } // End of the final action of Y_{ki} += Gt_{ka} T_{ai}
+         } // End of nQpts
+
+         for (int k = 0; k < dim_; k++) {
+            for (int i = 0; i < nnodes_; i++) {
+               Y(i, k, i_elems) += eDS_view(i, k, i_elems) * pbar;
+            }
+         }
+      }); // End of nelems
+   } // End of if statement
 }
 
 // This assembles the diagonal of our LHS which can be used as a preconditioner
@@ -1616,7 +2373,6 @@ void ICExaNLFIntegrator::AssembleGradDiagonalPA(Vector &diag) const
    else {
       const int dim = 3;
 
-      const int DIM2 = 2;
       const int DIM3 = 3;
       const int DIM4 = 4;
 
@@ -1624,7 +2380,6 @@ void ICExaNLFIntegrator::AssembleGradDiagonalPA(Vector &diag) const
 
       std::array<RAJA::idx_t, DIM4> perm4 {{ 3, 2, 1, 0 } };
       std::array<RAJA::idx_t, DIM3> perm3 {{ 2, 1, 0 } };
-      std::array<RAJA::idx_t, DIM2> perm2 {{ 1, 0 } };
 
       // bunch of helper RAJA views to make dealing with data easier down below in our kernel.
 
@@ -1638,8 +2393,6 @@ void ICExaNLFIntegrator::AssembleGradDiagonalPA(Vector &diag) const
       RAJA::Layout<DIM4> layout_jacob = RAJA::make_permuted_layout({{ dim, dim, nqpts, nelems } }, perm4);
       RAJA::View<const double, RAJA::Layout<DIM4, RAJA::Index_type, 0> > J(jacobian.Read(), layout_jacob);
 
-      RAJA::Layout<DIM2> layout_adj = RAJA::make_permuted_layout({{ dim, dim } }, perm2);
-
       RAJA::Layout<DIM3> layout_grads = RAJA::make_permuted_layout({{ nnodes, dim, nqpts } }, perm3);
       RAJA::View<const double, RAJA::Layout<DIM3, RAJA::Index_type, 0> > Gt(grad.Read(), layout_grads);
 
@@ -1647,18 +2400,14 @@ void ICExaNLFIntegrator::AssembleGradDiagonalPA(Vector &diag) const
       RAJA::View<const double, RAJA::Layout<DIM3, RAJA::Index_type, 0> > eDS_view(eDS.Read(), layout_egrads);
 
       double dt = model->GetModelDt();
-      const double i3 = 1.0 / 3.0;
       const int nqpts_ = nqpts;
       const int dim_ = dim;
-      const int nnodes_ = nnodes; 
+      const int nnodes_ = nnodes;
       // This loop we'll want to parallelize the rest are all serial for now.
       MFEM_FORALL(i_elems, nelems, {
          double adj[dim_ * dim_];
          double c_detJ;
          double idetJ;
-         // So, we're going to say this view is constant however we're going to mutate the values only in
-         // that one scoped section for the quadrature points.
-         RAJA::View<const double, RAJA::Layout<DIM2, RAJA::Index_type, 0> > A(&adj[0], layout_adj);
          for (int j_qpts = 0; j_qpts < nqpts_; j_qpts++) {
             // If we scope this then we only need to carry half the number of variables around with us for
             // the adjugate term.
@@ -1688,138 +2437,34 @@ void ICExaNLFIntegrator::AssembleGradDiagonalPA(Vector &diag) const
                adj[7] = (J31 * J12) - (J11 * J32); // 2,1
                adj[8] = (J11 * J22) - (J12 * J21); // 2,2
             }
-            for (int knds = 0; knds < nnodes_; knds++) {
-               const double bx = idetJ * (Gt(knds, 0, j_qpts) * A(0, 0)
-                                        + Gt(knds, 1, j_qpts) * A(0, 1)
-                                        + Gt(knds, 2, j_qpts) * A(0, 2));
-
-               const double by = idetJ * (Gt(knds, 0, j_qpts) * A(1, 0)
-                                        + Gt(knds, 1, j_qpts) * A(1, 1)
-                                        + Gt(knds, 2, j_qpts) * A(1, 2));
-
-               const double bz = idetJ * (Gt(knds, 0, j_qpts) * A(2, 0)
-                                        + Gt(knds, 1, j_qpts) * A(2, 1)
-                                        + Gt(knds, 2, j_qpts) * A(2, 2));
-               const double b4 = i3 * (eDS_view(knds, 0, i_elems) - bx);
-               const double b5 = b4 + bx;
-               const double b6 = i3 * (eDS_view(knds, 1, i_elems) - by);
-               const double b7 = b6 + by;
-               const double b8 = i3 * (eDS_view(knds, 2, i_elems) - bz);
-               const double b9 = b8 + bz;
-
-               const double k11w = c_detJ * (b4 * K(1, 1, j_qpts, i_elems)
-                                           + b4 * K(1, 2, j_qpts, i_elems)
-                                           + b5 * K(1, 0, j_qpts, i_elems)
-                                           + by * K(1, 5, j_qpts, i_elems)
-                                           + bz * K(1, 4, j_qpts, i_elems)
-                                           + b4 * K(2, 1, j_qpts, i_elems)
-                                           + b4 * K(2, 2, j_qpts, i_elems)
-                                           + b5 * K(2, 0, j_qpts, i_elems)
-                                           + by * K(2, 5, j_qpts, i_elems)
-                                           + bz * K(2, 4, j_qpts, i_elems));
-
-               const double k11x = c_detJ * (b4 * K(0, 1, j_qpts, i_elems)
-                                           + b4 * K(0, 2, j_qpts, i_elems)
-                                           + b5 * K(0, 0, j_qpts, i_elems)
-                                           + by * K(0, 5, j_qpts, i_elems)
-                                           + bz * K(0, 4, j_qpts, i_elems));
-
-               const double k11y = c_detJ * (b4 * K(5, 1, j_qpts, i_elems)
-                                           + b4 * K(5, 2, j_qpts, i_elems)
-                                           + b5 * K(5, 0, j_qpts, i_elems)
-                                           + by * K(5, 5, j_qpts, i_elems)
-                                           + bz * K(5, 4, j_qpts, i_elems));
-
-               const double k11z = c_detJ * (b4 * K(4, 1, j_qpts, i_elems)
-                                           + b4 * K(4, 2, j_qpts, i_elems)
-                                           + b5 * K(4, 0, j_qpts, i_elems)
-                                           + by * K(4, 5, j_qpts, i_elems)
-                                           + bz * K(4, 4, j_qpts, i_elems));
-
-               const double k22w = c_detJ * (b6 * K(0, 0, j_qpts, i_elems)
-                                           + b6 * K(0, 2, j_qpts, i_elems)
-                                           + b7 * K(0, 1, j_qpts, i_elems)
-                                           + bx * K(0, 5, j_qpts, i_elems)
-                                           + bz * K(0, 3, j_qpts, i_elems)
-                                           + b6 * K(2, 0, j_qpts, i_elems)
-                                           + b6 * K(2, 2, j_qpts, i_elems)
-                                           + b7 * K(2, 1, j_qpts, i_elems)
-                                           + bx * K(2, 5, j_qpts, i_elems)
-                                           + bz * K(2, 3, j_qpts, i_elems));
-
-               const double k22x = c_detJ * (b6 * K(1, 0, j_qpts, i_elems)
-                                           + b6 * K(1, 2, j_qpts, i_elems)
-                                           + b7 * K(1, 1, j_qpts, i_elems)
-                                           + bx * K(1, 5, j_qpts, i_elems)
-                                           + bz * K(1, 3, j_qpts, i_elems));
-
-               const double k22y = c_detJ * (b6 * K(5, 0, j_qpts, i_elems)
-                                           + b6 * K(5, 2, j_qpts, i_elems)
-                                           + b7 * K(5, 1, j_qpts, i_elems)
-                                           + bx * K(5, 5, j_qpts, i_elems)
-                                           + bz * K(5, 3, j_qpts, i_elems));
-
-               const double k22z = c_detJ * (b6 * K(3, 0, j_qpts, i_elems)
-                                           + b6 * K(3, 2, j_qpts, i_elems)
-                                           + b7 * K(3, 1, j_qpts, i_elems)
-                                           + bx * K(3, 5, j_qpts, i_elems)
-                                           + bz * K(3, 3, j_qpts, i_elems));
-
-               const double k33w = c_detJ * (b8 * K(0, 0, j_qpts, i_elems)
-                                           + b8 * K(0, 1, j_qpts, i_elems)
-                                           + b9 * K(0, 2, j_qpts, i_elems)
-                                           + bx * K(0, 4, j_qpts, i_elems)
-                                           + by * K(0, 3, j_qpts, i_elems)
-                                           + b8 * K(1, 0, j_qpts, i_elems)
-                                           + b8 * K(1, 1, j_qpts, i_elems)
-                                           + b9 * K(1, 2, j_qpts, i_elems)
-                                           + bx * K(1, 4, j_qpts, i_elems)
-                                           + by * K(1, 3, j_qpts, i_elems));
-
-               const double k33x = c_detJ * (b8 * K(2, 0, j_qpts, i_elems)
-                                           + b8 * K(2, 1, j_qpts, i_elems)
-                                           + b9 * K(2, 2, j_qpts, i_elems)
-                                           + bx * K(2, 4, j_qpts, i_elems)
-                                           + by * K(2, 3, j_qpts, i_elems));
-
-               const double k33y = c_detJ * (b8 * K(4, 0, j_qpts, i_elems)
-                                           + b8 * K(4, 1, j_qpts, i_elems)
-                                           + b9 * K(4, 2, j_qpts, i_elems)
-                                           + bx * K(4, 4, j_qpts, i_elems)
-                                           + by * K(4, 3, j_qpts, i_elems));
-
-               const double k33z = c_detJ * (b8 * K(3, 0, j_qpts, i_elems)
-                                           + b8 * K(3, 1, j_qpts, i_elems)
-                                           + b9 * K(3, 2, j_qpts, i_elems)
-                                           + bx * K(3, 4, j_qpts, i_elems)
-                                           + by * K(3, 3, j_qpts, i_elems));
-
-               Y(knds, 0, i_elems) += b4 * k11w + b5 * k11x + by * k11y + bz * k11z;
-               Y(knds, 1, i_elems) += b6 * k22w + b7 * k22x + bx * k22y + bz * k22z;
-               Y(knds, 2, i_elems) += b8 * k33w + b9 * k33x + bx * k33y + by * k33z;
-
-            }
+            exaconstit::kernel::bbar_grad_diag_qpt(nnodes_, c_detJ, &K(0, 0, j_qpts, i_elems), adj, idetJ,
+                                                   &Gt(0, 0, j_qpts), &eDS_view(0, 0, i_elems),
+                                                   &Y(0, 0, i_elems));
          }
       });
    }
 }
 
+void ICExaNLFIntegrator::AssembleGradBlockDiagonalPA(Vector &blk_diag) const
+{
+   CALI_CXX_MARK_SCOPE("icenlfi_AssembleGradBlockDiagonalPA");
+   AssembleGradBlockDiagonalKernel(eDS.Read(), blk_diag);
+}
+
 // This performs the assembly step of our RHS side of our system:
 // f_ik =
 void ICExaNLFIntegrator::AssemblePA(const FiniteElementSpace &fes)
 {
    CALI_CXX_MARK_SCOPE("icenlfi_assemblePA");
-   Mesh *mesh = fes.GetMesh();
    const FiniteElement &el = *fes.GetFE(0);
    space_dims = el.GetDim();
-   const IntegrationRule *ir = &(IntRules.Get(el.GetGeomType(), 2 * el.GetOrder() + 1));
+   const IntegrationRule *ir = &GetKernelIntRule(el);
 
    nqpts = ir->GetNPoints();
    nnodes = el.GetDof();
    nelems = fes.GetNE();
 
    auto W = ir->GetWeights().Read();
-   geom = mesh->GetGeometricFactors(*ir, GeometricFactors::JACOBIANS);
 
    if ((space_dims == 1) || (space_dims == 2)) {
       MFEM_ABORT("Dimensions of 1 or 2 not supported.");
@@ -1840,6 +2485,7 @@ void ICExaNLFIntegrator::AssemblePA(const FiniteElementSpace &fes)
             }
          }
          grad.UseDevice(true);
+         SetupTensorBasis(el, *ir);
       }
 
       if (eDS.Size() != (nnodes * dim * nelems)) {
@@ -1849,12 +2495,7 @@ void ICExaNLFIntegrator::AssemblePA(const FiniteElementSpace &fes)
 
       eDS = 0.0;
 
-      // geom->J really isn't going to work for us as of right now. We could just reorder it
-      // to the version that we want it to be in instead...
-      if (jacobian.Size() != (dim * dim * nqpts * nelems)) {
-         jacobian.SetSize(dim * dim * nqpts * nelems, mfem::Device::GetMemoryType());
-         jacobian.UseDevice(true);
-      }
+      SetupJacobian(fes, *ir);
 
       const int DIM2 = 2;
       const int DIM3 = 3;
@@ -1864,10 +2505,7 @@ void ICExaNLFIntegrator::AssemblePA(const FiniteElementSpace &fes)
       std::array<RAJA::idx_t, DIM2> perm2 {{ 1, 0 } };
 
       RAJA::Layout<DIM4> layout_jacob = RAJA::make_permuted_layout({{ dim, dim, nqpts, nelems } }, perm4);
-      RAJA::View<double, RAJA::Layout<DIM4, RAJA::Index_type, 0> > J(jacobian.ReadWrite(), layout_jacob);
-
-      RAJA::Layout<DIM4> layout_geom = RAJA::make_permuted_layout({{ nqpts, dim, dim, nelems } }, perm4);
-      RAJA::View<const double, RAJA::Layout<DIM4, RAJA::Index_type, 0> > geom_j_view(geom->J.Read(), layout_geom);
+      RAJA::View<const double, RAJA::Layout<DIM4, RAJA::Index_type, 0> > J(jacobian.Read(), layout_jacob);
 
       RAJA::Layout<DIM3> layout_egrads = RAJA::make_permuted_layout({{ nnodes, dim, nelems } }, perm3);
       RAJA::View<double, RAJA::Layout<DIM3, RAJA::Index_type, 0> > eDS_view(eDS.ReadWrite(), layout_egrads);
@@ -1881,16 +2519,6 @@ void ICExaNLFIntegrator::AssemblePA(const FiniteElementSpace &fes)
       const int dim_ = dim;
       const int nnodes_ = nnodes; 
 
-      MFEM_FORALL(i, nelems, {
-         for (int j = 0; j < nqpts_; j++) {
-            for (int k = 0; k < dim_; k++) {
-               for (int l = 0; l < dim_; l++) {
-                  J(l, k, j, i) = geom_j_view(j, l, k, i);
-               }
-            }
-         }
-      });
-
       // This loop we'll want to parallelize the rest are all serial for now.
       MFEM_FORALL(i_elems, nelems, {
          double adj[dim_ * dim_];
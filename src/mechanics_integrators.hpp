@@ -20,15 +20,86 @@ class ExaNLFIntegrator : public mfem::NonlinearFormIntegrator
       mfem::Vector grad;
       mfem::Vector *tan_mat; // Not owned
       mfem::Vector pa_dmat;
+      // Whether pa_dmat only holds the unique entries of our symmetric PA tangent
+      bool pa_dmat_sym;
       mfem::Vector jacobian;
+      // Whether jacobian is a reference to a per configuration jacobian owned by someone else
+      bool shared_jacobian;
       const mfem::GeometricFactors *geom; // Not owned
       int space_dims, nelems, nqpts, nnodes;
+      // 1D basis values, 1D basis derivatives, and lexicographic to native node map
+      // used by the sum-factorized kernels for tensor-product hexahedral elements.
+      mfem::Vector basis1d, dbasis1d;
+      mfem::Array<int> dof_map;
+      int ndofs1d, nqpts1d;
+      bool tensor_kernels;
+      // The elements our AddMultGradPA kernels are restricted to, where nullptr is all of them
+      mutable const mfem::Array<int> *pa_elems;
+      // The E-vector AssembleGradPA adds our diagonal to, where nullptr skips it
+      mfem::Vector *pa_diag;
+
+      /// The integration rule of our PA and EA kernels, which must match the quadrature
+      /// space of our model. It's the rule provided through SetIntRule if there is one.
+      const mfem::IntegrationRule &GetKernelIntRule(const mfem::FiniteElement &el) const;
+
+      /// Forms our jacobian terms from the mesh geometric factors unless we're
+      /// making use of a shared jacobian.
+      void SetupJacobian(const mfem::FiniteElementSpace &fes, const mfem::IntegrationRule &ir);
+
+      /// Determines whether the sum-factorized kernels can be used for this element
+      /// and integration rule, and if so sets up the 1D basis data they require.
+      void SetupTensorBasis(const mfem::FiniteElement &el, const mfem::IntegrationRule &ir);
+
+      /// Sum-factorized versions of AddMultPA, AddMultGradPA, and AssembleGradDiagonalPA
+      /// for tensor-product hexahedral elements. These are selected automatically
+      /// by their general counterparts whenever tensor_kernels is set.
+      /// The common 1D dof / quadrature point combinations have compile time
+      /// specialized versions, and T_D1D = T_Q1D = 0 is the generic runtime version.
+      template<int T_D1D = 0, int T_Q1D = 0>
+      void AddMultPATensor(mfem::Vector &y) const;
+      template<int T_D1D = 0, int T_Q1D = 0>
+      void AddMultGradPATensor(const mfem::Vector &x, mfem::Vector &y) const;
+      template<int T_D1D = 0, int T_Q1D = 0>
+      void AssembleGradDiagonalPATensor(mfem::Vector &diag) const;
+      /// Whether the generic runtime versions of the sum-factorized kernels can be used.
+      /// Their per thread quadrature point arrays are sized for TENSOR_MAX_Q1D, which spills
+      /// out to local memory on a GPU, so there the general kernels are used instead for the
+      /// element orders without a compile time specialized version.
+      bool GenericTensorKernels() const { return !mfem::Device::Allows(mfem::Backend::DEVICE_MASK); }
+
+      /// The quadrature point kernel of AssembleGradPA, which also adds our diagonal to
+      /// pa_diag when T_DIAG is set. T_TENSOR selects the sum-factorized diagonal, which
+      /// follows the T_D1D / T_Q1D specializations of AssembleGradDiagonalPATensor.
+      template<bool T_DIAG, bool T_TENSOR = false, int T_D1D = 0, int T_Q1D = 0>
+      void AssembleGradPAKernel(const double *W);
+
+      /// The element assembly kernel which can be specialized at compile time on the
+      /// number of nodes and quadrature points of an element (hex8 / 2x2x2, hex27 / 3x3x3,
+      /// and hex64 / 4x4x4). T_NNODES = T_NQPTS = 0 is the generic runtime version.
+      template<int T_NNODES = 0, int T_NQPTS = 0>
+      void AssembleEAKernel(const double *W, mfem::Vector &emat) const;
+
+      /// Adds the nodal 3x3 diagonal blocks of our element gradient matrices to blk_diag.
+      /// If eds is provided then it's used as the element averaged shape function gradients
+      /// of the Bbar formulation.
+      void AssembleGradBlockDiagonalKernel(const double *eds, mfem::Vector &blk_diag) const;
 
    public:
-      ExaNLFIntegrator(ExaModel *m) : model(m) { }
+      ExaNLFIntegrator(ExaModel *m) : model(m), pa_dmat_sym(false), shared_jacobian(false),
+         ndofs1d(0), nqpts1d(0), tensor_kernels(false), pa_elems(nullptr),
+         pa_diag(nullptr) { }
 
       virtual ~ExaNLFIntegrator() { }
 
+      /// Makes use of an externally owned jacobian at each quadrature point, in the
+      /// (dim, dim, nqpts, nelems) col. major layout, instead of forming our own copy
+      /// of it. The owner is responsible for keeping it up to date with the mesh.
+      void SetSharedJacobian(mfem::Vector &jac);
+
+      /// Whether our element gradient matrices are symmetric, which is the case
+      /// whenever our material tangent stiffness matrix is.
+      bool SymmetricGrad() const { return model->SymmetricMatGrad(); }
+
       /// This doesn't do anything at this point. We can add the functionality
       /// later on if a use case arises.
       virtual double GetElementEnergy(const mfem::FiniteElement &el,
@@ -61,6 +132,14 @@ class ExaNLFIntegrator : public mfem::NonlinearFormIntegrator
       virtual void AssembleGradPA(const mfem::Vector &/* x */, const mfem::FiniteElementSpace &fes) override;
       virtual void AssembleGradPA(const mfem::FiniteElementSpace &fes) override;
       virtual void AddMultGradPA(const mfem::Vector &x, mfem::Vector &y) const override;
+      /// AddMultGradPA where only the elements in elems are applied. The entries of x and y
+      /// of every other element are left alone.
+      void AddMultGradPAElements(const mfem::Vector &x, mfem::Vector &y,
+                                 const mfem::Array<int> &elems) const;
+      /// AssembleGradPA which also adds the diagonal of our gradient to the E-vector diag
+      /// in the same pass over the quadrature points. This gives the same diag as a
+      /// following call to AssembleGradDiagonalPA would.
+      void AssembleGradPADiagonal(const mfem::FiniteElementSpace &fes, mfem::Vector &diag);
 
       using mfem::NonlinearFormIntegrator::AssemblePA;
       virtual void AssemblePA(const mfem::FiniteElementSpace &fes) override;
@@ -68,6 +147,13 @@ class ExaNLFIntegrator : public mfem::NonlinearFormIntegrator
 
       virtual void AssembleGradDiagonalPA(mfem::Vector &diag) const override;
 
+      /// Adds the 3x3 block of each node along the diagonal of our element gradient
+      /// matrices to blk_diag. These couple the displacement components of a node.
+      /// blk_diag is laid out as (nnodes, dim, nelems, dim) where the last index is
+      /// the column of the block, so each column is an E-vector of its own.
+      /// AssemblePA must have been called for the current configuration.
+      virtual void AssembleGradBlockDiagonalPA(mfem::Vector &blk_diag) const;
+
       /// Method defining element assembly.
       /** The result of the element assembly is added and stored in the @a emat
           Vector. */
@@ -84,6 +170,12 @@ class ICExaNLFIntegrator : public ExaNLFIntegrator
    private:
       // Will take a look and see what I need and don't need for this.
       mfem::Vector eDS;
+
+      /// The Bbar element assembly kernel which can be specialized at compile time on
+      /// the number of nodes and quadrature points of an element.
+      /// T_NNODES = T_NQPTS = 0 is the generic runtime version.
+      template<int T_NNODES = 0, int T_NQPTS = 0>
+      void AssembleEAKernel(const double *W, mfem::Vector &emat) const;
    public:
       ICExaNLFIntegrator(ExaModel *m) : ExaNLFIntegrator(m) { }
 
@@ -104,10 +196,13 @@ class ICExaNLFIntegrator : public ExaNLFIntegrator
                                        mfem::ElementTransformation &Ttr,
                                        const mfem::Vector & /*elfun*/, mfem::DenseMatrix &elmat) override;
 
-      // This method doesn't easily extend to PA formulation, so we're punting on
-      // it for now.
       using ExaNLFIntegrator::AssembleGradPA;
-      using ExaNLFIntegrator::AddMultGradPA;
+      /// Assembles the quadrature point data needed by the PA version of our Bbar
+      /// gradient operator. This only needs the scaled 6x6 material tangent as the
+      /// Bbar operator itself is applied on the fly in AddMultGradPA.
+      virtual void AssembleGradPA(const mfem::FiniteElementSpace &fes) override;
+      /// Applies the Bbar gradient operator, Bbar^T D Bbar, to x without forming it.
+      virtual void AddMultGradPA(const mfem::Vector &x, mfem::Vector &y) const override;
 
       // using mfem::NonlinearFormIntegrator::AssemblePA;
       // We've got to override this as well for the Bbar method...
@@ -116,6 +211,8 @@ class ICExaNLFIntegrator : public ExaNLFIntegrator
 
       virtual void AssembleGradDiagonalPA(mfem::Vector &diag) const override;
 
+      virtual void AssembleGradBlockDiagonalPA(mfem::Vector &blk_diag) const override;
+
       /// Method defining element assembly.
       /** The result of the element assembly is added and stored in the @a emat
           Vector. */
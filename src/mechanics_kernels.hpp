@@ -15,6 +15,367 @@ namespace kernel {
 void grad_calc(const int nqpts, const int nelems, const int nnodes,
                 const double *jacobian_data, const double *loc_grad_data,
                 const double *field_data, double* field_grad_array);
+
+/// Number of unique entries per quadrature point of the PA tangent D_{abln} when it
+/// has major and minor symmetry. In that case D_{abln} = D_{nlba}, so it can be viewed
+/// as a symmetric 9x9 matrix N(a + 3b, n + 3l) of which we store the upper triangle.
+constexpr int PA_TAN_SYM_SIZE = 45;
+
+/// Offset of the start of row u in the packed upper triangle of a symmetric 9x9 matrix
+/// such that entry (u, v) with u <= v lives at sym_tan_row(u) + v.
+MFEM_HOST_DEVICE inline
+int sym_tan_row(const int u)
+{
+    return (u * (17 - u)) / 2;
+}
+
+/// Applies the packed symmetric PA tangent N to a 3x3 col. major gradient:
+/// T(a, b) = \sum_{ij} D_{abij} grad(i, j) with T returned in col. major order.
+MFEM_HOST_DEVICE inline
+void sym_tan_mult(const double *N, const double *grad, double *T)
+{
+    // Our column index of N for grad(i, j) is j + 3i so we need its transpose
+    double gt[9];
+    for (int i = 0; i < 3; i++) {
+        for (int j = 0; j < 3; j++) {
+            gt[j + 3 * i] = grad[i + 3 * j];
+        }
+    }
+    for (int u = 0; u < 9; u++) {
+        T[u] = 0.0;
+    }
+    for (int u = 0; u < 9; u++) {
+        const double *row = &N[sym_tan_row(u)];
+        T[u] += row[u] * gt[u];
+        for (int v = u + 1; v < 9; v++) {
+            T[u] += row[v] * gt[v];
+            T[v] += row[v] * gt[u];
+        }
+    }
+}
+
+/// Largest number of 1D dofs and quadrature points supported by the sum-factorized
+/// hexahedral kernels. With our 2 * p + 1 quadrature order this covers p = 1 - 4.
+/// Anything larger falls back to the dense per quadrature point kernels.
+constexpr int TENSOR_MAX_D1D = 5;
+constexpr int TENSOR_MAX_Q1D = 5;
+
+/// Sum-factorized evaluation of the reference gradient of a 3D vector field at the
+/// quadrature points of a tensor-product hexahedral element.
+/// The T_D1D and T_Q1D template parameters allow the 1D sizes to be fixed at compile
+/// time so the loops can be unrolled, while the default of 0 uses d1d_ and q1d_.
+/// B and G are the 1D basis and basis derivative values (q1d x d1d, col. major),
+/// dof_map takes a lexicographic node number to its native node number in xe,
+/// xe is the element field (nnodes x 3, col. major), and on return
+/// grad_q(i, j, q) = d xe_i / d xi_j (3 x 3 x nqpts, col. major).
+template<int T_D1D = 0, int T_Q1D = 0>
+MFEM_HOST_DEVICE inline
+void tensor_grad_hex(const int d1d_, const int q1d_, const double *B, const double *G,
+                     const int *dof_map, const double *xe, double *grad_q)
+{
+    const int d1d = T_D1D ? T_D1D : d1d_;
+    const int q1d = T_Q1D ? T_Q1D : q1d_;
+    const int nnodes = d1d * d1d * d1d;
+    constexpr int MD = T_D1D ? T_D1D : TENSOR_MAX_D1D;
+    constexpr int MQ = T_Q1D ? T_Q1D : TENSOR_MAX_Q1D;
+    // Contract over x
+    double bx[MD][MD][MQ][3];
+    double gx[MD][MD][MQ][3];
+    for (int dz = 0; dz < d1d; dz++) {
+        for (int dy = 0; dy < d1d; dy++) {
+            for (int qx = 0; qx < q1d; qx++) {
+                for (int c = 0; c < 3; c++) {
+                    bx[dz][dy][qx][c] = 0.0;
+                    gx[dz][dy][qx][c] = 0.0;
+                }
+            }
+            for (int dx = 0; dx < d1d; dx++) {
+                const int node = dof_map[dx + d1d * (dy + d1d * dz)];
+                const double x0 = xe[node];
+                const double x1 = xe[node + nnodes];
+                const double x2 = xe[node + 2 * nnodes];
+                for (int qx = 0; qx < q1d; qx++) {
+                    const double b = B[qx + q1d * dx];
+                    const double g = G[qx + q1d * dx];
+                    bx[dz][dy][qx][0] += b * x0;
+                    bx[dz][dy][qx][1] += b * x1;
+                    bx[dz][dy][qx][2] += b * x2;
+                    gx[dz][dy][qx][0] += g * x0;
+                    gx[dz][dy][qx][1] += g * x1;
+                    gx[dz][dy][qx][2] += g * x2;
+                }
+            }
+        }
+    }
+    // Contract over y
+    double bbx[MD][MQ][MQ][3];
+    double gbx[MD][MQ][MQ][3];
+    double bgx[MD][MQ][MQ][3];
+    for (int dz = 0; dz < d1d; dz++) {
+        for (int qy = 0; qy < q1d; qy++) {
+            for (int qx = 0; qx < q1d; qx++) {
+                for (int c = 0; c < 3; c++) {
+                    double sbb = 0.0;
+                    double sgb = 0.0;
+                    double sbg = 0.0;
+                    for (int dy = 0; dy < d1d; dy++) {
+                        const double b = B[qy + q1d * dy];
+                        const double g = G[qy + q1d * dy];
+                        sbb += b * bx[dz][dy][qx][c];
+                        sgb += b * gx[dz][dy][qx][c];
+                        sbg += g * bx[dz][dy][qx][c];
+                    }
+                    bbx[dz][qy][qx][c] = sbb;
+                    gbx[dz][qy][qx][c] = sgb;
+                    bgx[dz][qy][qx][c] = sbg;
+                }
+            }
+        }
+    }
+    // Contract over z
+    for (int qz = 0; qz < q1d; qz++) {
+        for (int qy = 0; qy < q1d; qy++) {
+            for (int qx = 0; qx < q1d; qx++) {
+                double *gq = &grad_q[9 * (qx + q1d * (qy + q1d * qz))];
+                for (int c = 0; c < 3; c++) {
+                    double s0 = 0.0;
+                    double s1 = 0.0;
+                    double s2 = 0.0;
+                    for (int dz = 0; dz < d1d; dz++) {
+                        const double b = B[qz + q1d * dz];
+                        const double g = G[qz + q1d * dz];
+                        s0 += b * gbx[dz][qy][qx][c];
+                        s1 += b * bgx[dz][qy][qx][c];
+                        s2 += g * bbx[dz][qy][qx][c];
+                    }
+                    gq[c] = s0;
+                    gq[c + 3] = s1;
+                    gq[c + 6] = s2;
+                }
+            }
+        }
+    }
+}
+
+/// Sum-factorized action of the transpose of the reference gradient operator on a
+/// tensor-product hexahedral element:
+/// ye(k, b) += \sum_q \sum_a d phi_k / d xi_a (q) T(a, b, q)
+/// where T is (3 x 3 x nqpts, col. major) and ye is (nnodes x 3, col. major) in the
+/// native node ordering. The remaining arguments follow tensor_grad_hex.
+template<int T_D1D = 0, int T_Q1D = 0>
+MFEM_HOST_DEVICE inline
+void tensor_grad_trans_hex(const int d1d_, const int q1d_, const double *B, const double *G,
+                           const int *dof_map, const double *T, double *ye)
+{
+    const int d1d = T_D1D ? T_D1D : d1d_;
+    const int q1d = T_Q1D ? T_Q1D : q1d_;
+    const int nnodes = d1d * d1d * d1d;
+    constexpr int MD = T_D1D ? T_D1D : TENSOR_MAX_D1D;
+    constexpr int MQ = T_Q1D ? T_Q1D : TENSOR_MAX_Q1D;
+    // Contract over qx
+    double gt[MQ][MQ][MD][3];
+    double bt1[MQ][MQ][MD][3];
+    double bt2[MQ][MQ][MD][3];
+    for (int qz = 0; qz < q1d; qz++) {
+        for (int qy = 0; qy < q1d; qy++) {
+            for (int dx = 0; dx < d1d; dx++) {
+                for (int c = 0; c < 3; c++) {
+                    gt[qz][qy][dx][c] = 0.0;
+                    bt1[qz][qy][dx][c] = 0.0;
+                    bt2[qz][qy][dx][c] = 0.0;
+                }
+            }
+            for (int qx = 0; qx < q1d; qx++) {
+                const double *tq = &T[9 * (qx + q1d * (qy + q1d * qz))];
+                for (int dx = 0; dx < d1d; dx++) {
+                    const double b = B[qx + q1d * dx];
+                    const double g = G[qx + q1d * dx];
+                    for (int c = 0; c < 3; c++) {
+                        gt[qz][qy][dx][c] += g * tq[3 * c];
+                        bt1[qz][qy][dx][c] += b * tq[1 + 3 * c];
+                        bt2[qz][qy][dx][c] += b * tq[2 + 3 * c];
+                    }
+                }
+            }
+        }
+    }
+    // Contract over qy
+    double bbt[MQ][MD][MD][3];
+    double bgt[MQ][MD][MD][3];
+    for (int qz = 0; qz < q1d; qz++) {
+        for (int dy = 0; dy < d1d; dy++) {
+            for (int dx = 0; dx < d1d; dx++) {
+                for (int c = 0; c < 3; c++) {
+                    double s01 = 0.0;
+                    double s2 = 0.0;
+                    for (int qy = 0; qy < q1d; qy++) {
+                        const double b = B[qy + q1d * dy];
+                        const double g = G[qy + q1d * dy];
+                        s01 += b * gt[qz][qy][dx][c] + g * bt1[qz][qy][dx][c];
+                        s2 += b * bt2[qz][qy][dx][c];
+                    }
+                    bbt[qz][dy][dx][c] = s01;
+                    bgt[qz][dy][dx][c] = s2;
+                }
+            }
+        }
+    }
+    // Contract over qz and scatter back to the native ordering
+    for (int dz = 0; dz < d1d; dz++) {
+        for (int dy = 0; dy < d1d; dy++) {
+            for (int dx = 0; dx < d1d; dx++) {
+                const int node = dof_map[dx + d1d * (dy + d1d * dz)];
+                for (int c = 0; c < 3; c++) {
+                    double s = 0.0;
+                    for (int qz = 0; qz < q1d; qz++) {
+                        s += B[qz + q1d * dz] * bbt[qz][dy][dx][c] +
+                             G[qz + q1d * dz] * bgt[qz][dy][dx][c];
+                    }
+                    ye[node + nnodes * c] += s;
+                }
+            }
+        }
+    }
+}
+
+/// Sum-factorized diagonal of the operator ye(k, c) += \sum_q \sum_{jl} d phi_k / d xi_j
+/// d phi_k / d xi_l M_c(j, l, q) on a tensor-product hexahedral element.
+/// M is provided in its symmetrized packed form mq(p, c, q) (6 x 3 x nqpts, col. major)
+/// with the pairs p = (0,0), (1,1), (2,2), (0,1), (0,2), (1,2) and the off-diagonal pairs
+/// holding M_c(j, l) + M_c(l, j). The remaining arguments follow tensor_grad_hex.
+template<int T_D1D = 0, int T_Q1D = 0>
+MFEM_HOST_DEVICE inline
+void tensor_grad_diag_hex(const int d1d_, const int q1d_, const double *B, const double *G,
+                          const int *dof_map, const double *mq, double *ye)
+{
+    const int d1d = T_D1D ? T_D1D : d1d_;
+    const int q1d = T_Q1D ? T_Q1D : q1d_;
+    const int nnodes = d1d * d1d * d1d;
+    constexpr int MD = T_D1D ? T_D1D : TENSOR_MAX_D1D;
+    constexpr int MQ = T_Q1D ? T_Q1D : TENSOR_MAX_Q1D;
+    const int pj[6] = { 0, 1, 2, 0, 0, 1 };
+    const int pl[6] = { 0, 1, 2, 1, 2, 2 };
+    double tx[MQ][MQ][MD][3];
+    double ty[MQ][MD][MD][3];
+    for (int p = 0; p < 6; p++) {
+        // The 1D factor for each direction is either B^2, B G, or G^2 depending on
+        // how many of the pair's derivatives fall along that direction.
+        const double *fx0 = (pj[p] == 0) ? G : B;
+        const double *fx1 = (pl[p] == 0) ? G : B;
+        const double *fy0 = (pj[p] == 1) ? G : B;
+        const double *fy1 = (pl[p] == 1) ? G : B;
+        const double *fz0 = (pj[p] == 2) ? G : B;
+        const double *fz1 = (pl[p] == 2) ? G : B;
+        for (int qz = 0; qz < q1d; qz++) {
+            for (int qy = 0; qy < q1d; qy++) {
+                for (int dx = 0; dx < d1d; dx++) {
+                    for (int c = 0; c < 3; c++) {
+                        double s = 0.0;
+                        for (int qx = 0; qx < q1d; qx++) {
+                            const int iq = qx + q1d * dx;
+                            s += fx0[iq] * fx1[iq] * mq[p + 6 * (c + 3 * (qx + q1d * (qy + q1d * qz)))];
+                        }
+                        tx[qz][qy][dx][c] = s;
+                    }
+                }
+            }
+        }
+        for (int qz = 0; qz < q1d; qz++) {
+            for (int dy = 0; dy < d1d; dy++) {
+                for (int dx = 0; dx < d1d; dx++) {
+                    for (int c = 0; c < 3; c++) {
+                        double s = 0.0;
+                        for (int qy = 0; qy < q1d; qy++) {
+                            const int iq = qy + q1d * dy;
+                            s += fy0[iq] * fy1[iq] * tx[qz][qy][dx][c];
+                        }
+                        ty[qz][dy][dx][c] = s;
+                    }
+                }
+            }
+        }
+        for (int dz = 0; dz < d1d; dz++) {
+            for (int dy = 0; dy < d1d; dy++) {
+                for (int dx = 0; dx < d1d; dx++) {
+                    const int node = dof_map[dx + d1d * (dy + d1d * dz)];
+                    for (int c = 0; c < 3; c++) {
+                        double s = 0.0;
+                        for (int qz = 0; qz < q1d; qz++) {
+                            const int iq = qz + q1d * dz;
+                            s += fz0[iq] * fz1[iq] * ty[qz][dy][dx][c];
+                        }
+                        ye[node + nnodes * c] += s;
+                    }
+                }
+            }
+        }
+    }
+}
+/// Adds the quadrature point contribution of the Bbar formulation to the diagonal of an
+/// element's stiffness matrix. Kq is the 6x6 col. major Voigt tangent which is scaled by
+/// scale, A(i, j) = adj[i + 3j] is the adjugate term of our jacobian, Gtq holds the nnodes x 3
+/// col. major shape function gradients at the quadrature point, and eds and ye are the
+/// element's nnodes x 3 col. major volume averaged gradients and diagonal.
+MFEM_HOST_DEVICE inline
+void bbar_grad_diag_qpt(const int nnodes, const double scale, const double *Kq,
+                        const double *adj, const double idetJ, const double *Gtq,
+                        const double *eds, double *ye)
+{
+    const double i3 = 1.0 / 3.0;
+    auto K = [&](const int i, const int j) { return Kq[i + 6 * j]; };
+    for (int knds = 0; knds < nnodes; knds++) {
+        const double g0 = Gtq[knds];
+        const double g1 = Gtq[knds + nnodes];
+        const double g2 = Gtq[knds + 2 * nnodes];
+        const double bx = idetJ * (g0 * adj[0] + g1 * adj[3] + g2 * adj[6]);
+        const double by = idetJ * (g0 * adj[1] + g1 * adj[4] + g2 * adj[7]);
+        const double bz = idetJ * (g0 * adj[2] + g1 * adj[5] + g2 * adj[8]);
+        const double b4 = i3 * (eds[knds] - bx);
+        const double b5 = b4 + bx;
+        const double b6 = i3 * (eds[knds + nnodes] - by);
+        const double b7 = b6 + by;
+        const double b8 = i3 * (eds[knds + 2 * nnodes] - bz);
+        const double b9 = b8 + bz;
+
+        const double k11w = scale * (b4 * K(1, 1) + b4 * K(1, 2) + b5 * K(1, 0)
+                                     + by * K(1, 5) + bz * K(1, 4)
+                                     + b4 * K(2, 1) + b4 * K(2, 2) + b5 * K(2, 0)
+                                     + by * K(2, 5) + bz * K(2, 4));
+        const double k11x = scale * (b4 * K(0, 1) + b4 * K(0, 2) + b5 * K(0, 0)
+                                     + by * K(0, 5) + bz * K(0, 4));
+        const double k11y = scale * (b4 * K(5, 1) + b4 * K(5, 2) + b5 * K(5, 0)
+                                     + by * K(5, 5) + bz * K(5, 4));
+        const double k11z = scale * (b4 * K(4, 1) + b4 * K(4, 2) + b5 * K(4, 0)
+                                     + by * K(4, 5) + bz * K(4, 4));
+
+        const double k22w = scale * (b6 * K(0, 0) + b6 * K(0, 2) + b7 * K(0, 1)
+                                     + bx * K(0, 5) + bz * K(0, 3)
+                                     + b6 * K(2, 0) + b6 * K(2, 2) + b7 * K(2, 1)
+                                     + bx * K(2, 5) + bz * K(2, 3));
+        const double k22x = scale * (b6 * K(1, 0) + b6 * K(1, 2) + b7 * K(1, 1)
+                                     + bx * K(1, 5) + bz * K(1, 3));
+        const double k22y = scale * (b6 * K(5, 0) + b6 * K(5, 2) + b7 * K(5, 1)
+                                     + bx * K(5, 5) + bz * K(5, 3));
+        const double k22z = scale * (b6 * K(3, 0) + b6 * K(3, 2) + b7 * K(3, 1)
+                                     + bx * K(3, 5) + bz * K(3, 3));
+
+        const double k33w = scale * (b8 * K(0, 0) + b8 * K(0, 1) + b9 * K(0, 2)
+                                     + bx * K(0, 4) + by * K(0, 3)
+                                     + b8 * K(1, 0) + b8 * K(1, 1) + b9 * K(1, 2)
+                                     + bx * K(1, 4) + by * K(1, 3));
+        const double k33x = scale * (b8 * K(2, 0) + b8 * K(2, 1) + b9 * K(2, 2)
+                                     + bx * K(2, 4) + by * K(2, 3));
+        const double k33y = scale * (b8 * K(4, 0) + b8 * K(4, 1) + b9 * K(4, 2)
+                                     + bx * K(4, 4) + by * K(4, 3));
+        const double k33z = scale * (b8 * K(3, 0) + b8 * K(3, 1) + b9 * K(3, 2)
+                                     + bx * K(3, 4) + by * K(3, 3));
+
+        ye[knds] += b4 * k11w + b5 * k11x + by * k11y + bz * k11z;
+        ye[knds + nnodes] += b6 * k22w + b7 * k22x + bx * k22y + bz * k22z;
+        ye[knds + 2 * nnodes] += b8 * k33w + b9 * k33x + bx * k33y + by * k33z;
+    }
+}
+
 //Computes the volume average values of values that lie at the quadrature points
 template<bool vol_avg>
 void ComputeVolAvgTensor(const mfem::ParFiniteElementSpace* fes,
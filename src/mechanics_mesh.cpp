@@ -0,0 +1,65 @@
+#include "mfem.hpp"
+#include "mechanics_mesh.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+using namespace mfem;
+
+void reorderMeshLocality(Mesh *mesh, const ElementOrdering ordering)
+{
+   const int nelems = mesh->GetNE();
+   Array<int> order(nelems);
+
+   if (ordering == ElementOrdering::HILBERT) {
+      mesh->GetHilbertElementOrdering(order);
+   }
+   else if (ordering == ElementOrdering::MORTON) {
+      // The Morton key of an element is the bit interleaving of the coordinates of its
+      // center quantized onto a 2^21 grid in each direction.
+      const int dim = mesh->SpaceDimension();
+      DenseMatrix centers(dim, nelems);
+      Vector center;
+      for (int i = 0; i < nelems; ++i) {
+         centers.GetColumnReference(i, center);
+         mesh->GetElementCenter(i, center);
+      }
+
+      double pmin[3] = { 0.0, 0.0, 0.0 };
+      double pmax[3] = { 0.0, 0.0, 0.0 };
+      for (int d = 0; d < dim; ++d) {
+         pmin[d] = pmax[d] = (nelems > 0) ? centers(d, 0) : 0.0;
+         for (int i = 1; i < nelems; ++i) {
+            pmin[d] = std::min(pmin[d], centers(d, i));
+            pmax[d] = std::max(pmax[d], centers(d, i));
+         }
+      }
+
+      const int nbits = 21;
+      const double nmax = static_cast<double>((1 << nbits) - 1);
+      // Ties are broken by the original element index so the ordering is deterministic
+      std::vector<std::pair<uint64_t, int>> keys(nelems);
+      for (int i = 0; i < nelems; ++i) {
+         uint64_t key = 0;
+         for (int d = 0; d < dim; ++d) {
+            const double len = pmax[d] - pmin[d];
+            const uint64_t q = (len > 0.0) ? static_cast<uint64_t>(nmax * (centers(d, i) - pmin[d]) / len) : 0;
+            for (int b = 0; b < nbits; ++b) {
+               key |= ((q >> b) & 1) << (dim * b + d);
+            }
+         }
+         keys[i] = std::make_pair(key, i);
+      }
+      std::sort(keys.begin(), keys.end());
+
+      // ReorderElements wants the new index of each of our old elements
+      for (int i = 0; i < nelems; ++i) {
+         order[keys[i].second] = i;
+      }
+   }
+   else {
+      return;
+   }
+
+   mesh->ReorderElements(order, true);
+}
@@ -0,0 +1,12 @@
+#ifndef MECHANICS_MESH
+#define MECHANICS_MESH
+
+#include "mfem.hpp"
+#include "option_types.hpp"
+
+/// Reorders the elements, and with them the vertices, of our mesh along a space-filling
+/// curve so that neighboring elements are close to each other in memory. Everything that
+/// lives on an element, such as its attribute, moves along with it.
+void reorderMeshLocality(mfem::Mesh *mesh, const ElementOrdering ordering);
+
+#endif
@@ -480,6 +480,26 @@ void ExaModel::UpdateEndCoords(const Vector& vels)
    return;
 }
 
+void ExaModel::SaveEndState()
+{
+   CALI_CXX_MARK_SCOPE("model_save_end_state");
+   snap_stress.UseDevice(true);
+   snap_matVars.UseDevice(true);
+   snap_crds.UseDevice(true);
+   snap_stress = *stress1;
+   snap_matVars = *matVars1;
+   snap_crds = *end_coords;
+}
+
+void ExaModel::RestoreEndState()
+{
+   CALI_CXX_MARK_SCOPE("model_restore_end_state");
+   MFEM_VERIFY(snap_stress.Size() == stress1->Size(), "RestoreEndState called before SaveEndState");
+   *stress1 = snap_stress;
+   *matVars1 = snap_matVars;
+   *end_coords = snap_crds;
+}
+
 // A helper function that takes in a 3x3 rotation matrix and converts it over
 // to a unit quaternion.
 // rmat should be constant here...
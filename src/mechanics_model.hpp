@@ -64,6 +64,12 @@ class ExaModel
       mfem::Vector matGradPA;
 
       std::unordered_map<std::string, std::pair<int, int> > qf_mapping;
+
+      // In-memory copies of our end time step stress, state variables, and coordinates
+      // from our last SaveEndState call
+      mfem::Vector snap_stress;
+      mfem::Vector snap_matVars;
+      mfem::Vector snap_crds;
    // ---------------------------------------------------------------------------
 
    public:
@@ -110,6 +116,12 @@ class ExaModel
                               const int nnodes, const mfem::Vector &jacobian,
                               const mfem::Vector &loc_grad, const mfem::Vector &vel) = 0;
 
+      /// Finishes putting the material tangent stiffness matrix from our last ModelSetup call
+      /// into the format our integrators expect. This is only called once a gradient is
+      /// actually needed, so our residual only evaluations of the model can skip this work.
+      /// It's called at most once per ModelSetup call.
+      virtual void FinalizeMatGrad() {}
+
       /// routine to update the beginning step deformation gradient. This must
       /// be written by a model class extension to update whatever else
       /// may be required for that particular model
@@ -140,6 +152,9 @@ class ExaModel
       /// return a pointer to the matVars0 quadrature function
       mfem::QuadratureFunction *GetMatVars0() { return matVars0; }
 
+      /// return a pointer to the matVars1 quadrature function
+      mfem::QuadratureFunction *GetMatVars1() { return matVars1; }
+
       /// return a pointer to the matGrad quadrature function
       mfem::QuadratureFunction *GetMatGrad() { return matGrad; }
 
@@ -186,6 +201,13 @@ class ExaModel
       /// The beggining time step coordinates should be updated outside of the model routines
       void UpdateEndCoords(const mfem::Vector& vel);
 
+      /// Saves off a copy of our end time step stress, state variables, and coordinates
+      void SaveEndState();
+
+      /// Rolls our end time step stress, state variables, and coordinates back to our
+      /// last SaveEndState call, so a time step that failed can be attempted again
+      void RestoreEndState();
+
       /// This method performs a fast approximate polar decomposition for 3x3 matrices
       /// The deformation gradient or 3x3 matrix of interest to be decomposed is passed
       /// in as the initial R matrix. The error on the solution can be set by the user.
@@ -217,6 +239,12 @@ class ExaModel
       /// tensor
       void TransformMatGradTo4D();
 
+      /// Returns whether the material tangent stiffness matrix is known to have major
+      /// symmetry (minor symmetry already follows from our Voigt notation storage).
+      /// If so, the PA operator only needs to store the unique entries of its
+      /// 4th order tensor. We can't make any promises for a general UMAT.
+      virtual bool SymmetricMatGrad() const { return false; }
+
       /// This method sets the end time step stress to the beginning step
       /// and then returns the internal data pointer of the end time step
       /// array.
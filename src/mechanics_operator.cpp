@@ -26,8 +26,10 @@ NonlinearMechOperator::NonlinearMechOperator(ParFiniteElementSpace &fes,
                                              ParGridFunction &beg_crds,
                                              ParGridFunction &end_crds,
                                              Vector &matProps,
-                                             int nStateVars)
-   : NonlinearForm(&fes), fe_space(fes), x_ref(ref_crds), x_cur(end_crds), ess_bdr_comps(ess_bdr_comp)
+                                             int nStateVars,
+                                             const Array<ParMesh*> &coarse_meshes)
+   : NonlinearForm(&fes), fe_space(fes), geom_valid(false), tangent_valid(false), x_ref(ref_crds), x_cur(end_crds),
+     ess_bdr_comps(ess_bdr_comp)
 {
    CALI_CXX_MARK_SCOPE("mechop_class_setup");
    Vector * rhs;
@@ -209,19 +211,19 @@ NonlinearMechOperator::NonlinearMechOperator(ParFiniteElementSpace &fes,
       }
    }
 
+   full_oper = nullptr;
+   prec_oper = nullptr;
+   mech_prec = nullptr;
+   pa_oper = nullptr;
    if (assembly == Assembly::PA) {
       Hform->SetAssemblyLevel(mfem::AssemblyLevel::PARTIAL, ElementDofOrdering::NATIVE);
-      diag.SetSize(fe_space.GetTrueVSize(), Device::GetMemoryType());
-      diag.UseDevice(true);
-      diag = 1.0;
-      prec_oper = new MechOperatorJacobiSmoother(diag, Hform->GetEssentialTrueDofs());
+      pa_oper = new PANonlinearMechOperatorGradExt(Hform, Hform->GetEssentialTrueDofs());
    }
    else if (assembly == Assembly::EA) {
       Hform->SetAssemblyLevel(mfem::AssemblyLevel::ELEMENT, ElementDofOrdering::NATIVE);
-      diag.SetSize(fe_space.GetTrueVSize(), Device::GetMemoryType());
-      diag.UseDevice(true);
-      diag = 1.0;
-      prec_oper = new MechOperatorJacobiSmoother(diag, Hform->GetEssentialTrueDofs());
+   }
+   else if (options.full_from_ea) {
+      full_oper = new FullMechOperatorGradAssembler(Hform);
    }
 
    // So, we're going to originally support non tensor-product type elements originally.
@@ -231,6 +233,8 @@ NonlinearMechOperator::NonlinearMechOperator(ParFiniteElementSpace &fes,
 
    el_x.SetSize(elem_restrict_lex->Height(), Device::GetMemoryType());
    el_x.UseDevice(true);
+   el_y.SetSize(elem_restrict_lex->Height(), Device::GetMemoryType());
+   el_y.UseDevice(true);
    px.SetSize(P->Height(), Device::GetMemoryType());
    px.UseDevice(true);
 
@@ -245,6 +249,15 @@ NonlinearMechOperator::NonlinearMechOperator(ParFiniteElementSpace &fes,
 
       el_jac.SetSize(space_dims * space_dims * nqpts * nelems, Device::GetMemoryType());
       el_jac.UseDevice(true);
+      // Our integrators all share this single copy of the jacobian rather than
+      // each pulling their own from the mesh's geometric factors.
+      Array<NonlinearFormIntegrator*> &integrators = *Hform->GetDNFI();
+      for (int i = 0; i < integrators.Size(); i++) {
+         ExaNLFIntegrator *integ = dynamic_cast<ExaNLFIntegrator*>(integrators[i]);
+         if (integ) {
+            integ->SetSharedJacobian(el_jac);
+         }
+      }
 
       qpts_dshape.SetSize(nqpts * space_dims * ndofs, Device::GetMemoryType());
       qpts_dshape.UseDevice(true);
@@ -260,6 +273,43 @@ NonlinearMechOperator::NonlinearMechOperator(ParFiniteElementSpace &fes,
       }
    }
 
+   if (assembly != Assembly::FULL) {
+      diag.SetSize(fe_space.GetTrueVSize(), Device::GetMemoryType());
+      diag.UseDevice(true);
+      diag = 1.0;
+      if (options.precond == PreconditionerType::BLOCKJACOBI) {
+         mech_prec = new MechOperatorBlockJacobi(Hform, Hform->GetEssentialTrueDofs());
+      }
+      else if (options.precond == PreconditionerType::SCHWARZ) {
+         MFEM_VERIFY(assembly == Assembly::EA, "The SCHWARZ preconditioner requires EA assembly");
+         mech_prec = new MechOperatorElementSchwarz(Hform, Hform->GetEssentialTrueDofs());
+      }
+      else if (options.precond == PreconditionerType::LORAMG) {
+         mech_prec = new MechOperatorLORAMG(fe_space, model, x_cur, Hform->GetEssentialTrueDofs());
+      }
+      else if (options.precond == PreconditionerType::GMG) {
+         mech_prec = new MechOperatorGMG(fe_space, model, x_cur, Hform->GetEssentialTrueDofs(),
+                                         coarse_meshes, ess_bdr, ess_bdr_comps, options.mg_smooth_iters,
+                                         options.mg_smoother, options.cheb_order, options.cheb_power_iters);
+      }
+      else if (options.precond == PreconditionerType::PMG) {
+         // Our lower order levels share el_jac with our own integrators
+         const AssemblyLevel level = (assembly == Assembly::PA) ? AssemblyLevel::PARTIAL : AssemblyLevel::ELEMENT;
+         mech_prec = new MechOperatorPMG(fe_space, model, el_jac, Hform->GetEssentialTrueDofs(),
+                                         ess_bdr, ess_bdr_comps, level, options.mg_smooth_iters,
+                                         options.mg_smoother, options.cheb_order, options.cheb_power_iters);
+      }
+      else if (options.precond == PreconditionerType::CHEBYSHEV) {
+         // As a standalone preconditioner we want to damp as much of the spectrum as we can
+         const double eig_ratio = 30.0;
+         prec_oper = new MechOperatorChebyshevSmoother(fe_space.GetComm(), diag, Hform->GetEssentialTrueDofs(),
+                                                       options.cheb_order, options.cheb_power_iters, eig_ratio);
+      }
+      else {
+         prec_oper = new MechOperatorJacobiSmoother(diag, Hform->GetEssentialTrueDofs());
+      }
+   }
+
    // We'll probably want to eventually add a print settings into our option class that tells us whether
    // or not we're going to be printing this.
 
@@ -282,6 +332,9 @@ void NonlinearMechOperator::UpdateEssTDofs(const Array<int> &ess_bdr)
    Hform->SetEssentialBC(ess_bdr, ess_bdr_comps, nullptr);
    // Set the essential boundary conditions that we can store on our class
    SetEssentialBC(ess_bdr, ess_bdr_comps, nullptr);
+   if (mech_prec) {
+      mech_prec->UpdateEssTDofs(ess_bdr);
+   }
 }
 
 // compute: y = H(x,p)
@@ -294,19 +347,40 @@ void NonlinearMechOperator::Mult(const Vector &k, Vector &y) const
    // we're going to be using.
    Setup<true>(k);
    // We now perform our element vector operation.
-   if (assembly == Assembly::PA) {
-      CALI_CXX_MARK_SCOPE("mechop_PA_PreSetup");
-      model->TransformMatGradTo4D();
-   }
    CALI_MARK_BEGIN("mechop_mult_setup");
    // Assemble our operator
    Hform->Setup();
    CALI_MARK_END("mechop_mult_setup");
    CALI_MARK_BEGIN("mechop_mult_Mult");
-   Hform->Mult(k, y);
+   if (assembly == Assembly::FULL) {
+      Hform->Mult(k, y);
+   }
+   else {
+      MultElementLocal(y);
+   }
    CALI_MARK_END("mechop_mult_Mult");
 }
 
+void NonlinearMechOperator::MultElementLocal(Vector &y) const
+{
+   CALI_CXX_MARK_SCOPE("mechop_MultElementLocal");
+   // Our E-vector was already formed in Setup, so we can go straight to the integrators
+   el_y = 0.0;
+   Array<NonlinearFormIntegrator*> &integrators = *Hform->GetDNFI();
+   for (int i = 0; i < integrators.Size(); i++) {
+      integrators[i]->AddMultPA(el_x, el_y);
+   }
+
+   elem_restrict_lex->MultTranspose(el_y, px);
+   P->MultTranspose(px, y);
+
+   // Apply the essential boundary conditions
+   const Array<int> &ess_tdofs = Hform->GetEssentialTrueDofs();
+   auto I = ess_tdofs.Read();
+   auto Y = y.ReadWrite();
+   MFEM_FORALL(i, ess_tdofs.Size(), Y[I[i]] = 0.0; );
+}
+
 template<bool upd_crds>
 void NonlinearMechOperator::Setup(const Vector &k) const
 {
@@ -339,17 +413,42 @@ void NonlinearMechOperator::Setup(const Vector &k) const
    if (mech_type == MechType::UMAT) {
       model->ModelSetup(nqpts, nelems, space_dims, ndofs, el_jac, qpts_dshape, k);
    }
-   else {
-      // Takes in k vector and transforms into into our E-vector array
+   // Takes in k vector and transforms into into our E-vector array
+   // The PA and EA residual assembly also reuses this E-vector.
+   if ((mech_type != MechType::UMAT) || (assembly != Assembly::FULL)) {
       P->Mult(k, px);
       elem_restrict_lex->Mult(px, el_x);
+   }
+   if (mech_type != MechType::UMAT) {
       model->ModelSetup(nqpts, nelems, space_dims, ndofs, el_jac, qpts_dshape, el_x);
    }
+   tangent_valid = false;
 } // End of model setup
 
+void NonlinearMechOperator::SetupTangent() const
+{
+   if (tangent_valid) { return; }
+   CALI_CXX_MARK_SCOPE("mechop_setup_tangent");
+   model->FinalizeMatGrad();
+   if (assembly == Assembly::PA) {
+      model->TransformMatGradTo4D();
+   }
+   tangent_valid = true;
+}
+
 void NonlinearMechOperator::SetupJacobianTerms() const
 {
+   // The geometry only changes when our end coordinates do, so there's no need
+   // to rebuild it on every Newton iteration or gradient call.
+   if (geom_valid) {
+      return;
+   }
+   ComputeJacobianTerms(el_jac);
+   geom_valid = true;
+}
 
+void NonlinearMechOperator::ComputeJacobianTerms(mfem::Vector &jac) const
+{
    Mesh *mesh = fe_space.GetMesh();
    const FiniteElement &el = *fe_space.GetFE(0);
    const int space_dims = el.GetDim();
@@ -369,7 +468,7 @@ void NonlinearMechOperator::SetupJacobianTerms() const
    std::array<RAJA::idx_t, DIM4> perm4 {{ 3, 2, 1, 0 } };
    // bunch of helper RAJA views to make dealing with data easier down below in our kernel.
    RAJA::Layout<DIM4> layout_jacob = RAJA::make_permuted_layout({{ space_dims, space_dims, nqpts, nelems } }, perm4);
-   RAJA::View<double, RAJA::Layout<DIM4, RAJA::Index_type, 0> > jac_view(el_jac.ReadWrite(), layout_jacob);
+   RAJA::View<double, RAJA::Layout<DIM4, RAJA::Index_type, 0> > jac_view(jac.Write(), layout_jacob);
 
    RAJA::Layout<DIM4> layout_geom = RAJA::make_permuted_layout({{ nqpts, space_dims, space_dims, nelems } }, perm4);
    RAJA::View<const double, RAJA::Layout<DIM4, RAJA::Index_type, 0> > geom_j_view(geom->J.Read(), layout_geom);
@@ -392,13 +491,29 @@ void NonlinearMechOperator::SetupJacobianTerms() const
 
 void NonlinearMechOperator::CalculateDeformationGradient(mfem::QuadratureFunction &def_grad) const
 {
-   Mesh *mesh = fe_space.GetMesh();
-
-   //Since we never modify our mesh nodes during this operations this is okay.
-   mfem::GridFunction *nodes = const_cast<mfem::ParGridFunction*>(&x_ref); // set a nodes grid function to global current configuration
-   int owns_nodes = 0;
-   mesh->SwapNodes(nodes, owns_nodes); // pmesh has current configuration nodes
-   SetupJacobianTerms();
+   CALI_CXX_MARK_SCOPE("mechop_def_grad");
+   // Our reference configuration never changes so its jacobian only needs to be
+   // formed the first time we're called.
+   if (ref_jac.Size() == 0) {
+      Mesh *mesh = fe_space.GetMesh();
+      //Since we never modify our mesh nodes during this operations this is okay.
+      mfem::GridFunction *nodes = const_cast<mfem::ParGridFunction*>(&x_ref); // set a nodes grid function to global reference configuration
+      int owns_nodes = 0;
+      mesh->SwapNodes(nodes, owns_nodes); // pmesh has reference configuration nodes
+
+      ref_jac.SetSize(el_jac.Size(), Device::GetMemoryType());
+      ref_jac.UseDevice(true);
+      ComputeJacobianTerms(ref_jac);
+
+      //We're returning our mesh nodes to the original object they were pointing to.
+      //So, we need to cast away the const here.
+      //We just don't want other functions outside this changing things.
+      nodes = const_cast<mfem::ParGridFunction*>(&x_cur);
+      mesh->SwapNodes(nodes, owns_nodes);
+      //Delete the old geometric factors since they dealt with the original reference frame.
+      //el_jac is our own copy so it's still valid for the current configuration.
+      mesh->DeleteGeometricFactors();
+   }
 
    const IntegrationRule *ir = &(IntRules.Get(fe_space.GetFE(0)->GetGeomType(), 2 * fe_space.GetFE(0)->GetOrder() + 1));;
 
@@ -414,31 +529,58 @@ void NonlinearMechOperator::CalculateDeformationGradient(mfem::QuadratureFunctio
    elem_restrict_lex->Mult(px, el_x);
 
    def_grad = 0.0;
-   exaconstit::kernel::grad_calc(nqpts, nelems, ndofs, el_jac.Read(), qpts_dshape.Read(), el_x.Read(), def_grad.ReadWrite());
-
-   //We're returning our mesh nodes to the original object they were pointing to.
-   //So, we need to cast away the const here.
-   //We just don't want other functions outside this changing things.
-   nodes = const_cast<mfem::ParGridFunction*>(&x_cur);
-   mesh->SwapNodes(nodes, owns_nodes);
-   //Delete the old geometric factors since they dealt with the original reference frame.
-   mesh->DeleteGeometricFactors();
-
+   exaconstit::kernel::grad_calc(nqpts, nelems, ndofs, ref_jac.Read(), qpts_dshape.Read(), el_x.Read(), def_grad.ReadWrite());
 }
 
 // Update the end coords used in our model
 void NonlinearMechOperator::UpdateEndCoords(const Vector& vel) const
 {
    model->UpdateEndCoords(vel);
+   // Our mesh nodes point to the end coordinates so our geometry is now out of date
+   geom_valid = false;
+}
+
+void NonlinearMechOperator::RestoreEndState() const
+{
+   model->RestoreEndState();
+   geom_valid = false;
+   tangent_valid = false;
+}
+
+bool NonlinearMechOperator::NeedsDiagonal() const
+{
+   return prec_oper || (mech_prec && mech_prec->NeedsDiagonal());
 }
 
 // Compute the Jacobian from the nonlinear form
 Operator &NonlinearMechOperator::GetGradient(const Vector &x) const
 {
    CALI_CXX_MARK_SCOPE("mechop_getgrad");
-   Jacobian = &Hform->GetGradient(x);
-   // Reset our preconditioner operator aka recompute the diagonal for our jacobi.
-   Jacobian->AssembleDiagonal(diag);
+   const bool need_diag = NeedsDiagonal();
+   SetupTangent();
+   if (full_oper) {
+      full_oper->Assemble();
+      Jacobian = &full_oper->EliminateBC(ess_tdof_list);
+   }
+   else if (pa_oper) {
+      // Our gradient and its diagonal are assembled in a single pass over the quadrature points
+      pa_oper->AssembleGradient(need_diag ? &diag : nullptr);
+      Jacobian = pa_oper;
+   }
+   else {
+      Jacobian = &Hform->GetGradient(x);
+      if (need_diag) {
+         // Reset our preconditioner operator aka recompute the diagonal for our jacobi.
+         Jacobian->AssembleDiagonal(diag);
+      }
+   }
+   if (mech_prec) {
+      mech_prec->Update(*Jacobian, diag);
+   }
+   else if (prec_oper) {
+      prec_oper->SetOperator(*Jacobian);
+      prec_oper->Setup(diag);
+   }
    return *Jacobian;
 }
 
@@ -447,6 +589,7 @@ Operator& NonlinearMechOperator::GetUpdateBCsAction(const Vector &k, const Vecto
 {
 
    CALI_CXX_MARK_SCOPE("mechop_GetUpdateBCsAction");
+   const bool need_diag = NeedsDiagonal();
    // We first run a setup step before actually doing anything.
    // We'll want to move this outside of Mult() at some given point in time
    // and have it live in the NR solver itself or whatever solver
@@ -455,21 +598,54 @@ Operator& NonlinearMechOperator::GetUpdateBCsAction(const Vector &k, const Vecto
    // We now perform our element vector operation.
    Vector resid(y); resid.UseDevice(true);
    Array<int> zero_tdofs;
-   if (assembly == Assembly::PA) {
-      CALI_CXX_MARK_SCOPE("mechop_PA_BC_PreSetup");
-      model->TransformMatGradTo4D();
-   }
+   SetupTangent();
 
    CALI_MARK_BEGIN("mechop_Hform_LocalGrad");
-   Hform->Setup();
-   Hform->SetEssentialTrueDofs(zero_tdofs);
-   auto &loc_jacobian = Hform->GetGradient(x);
-   loc_jacobian.Mult(x, y);
-   Hform->SetEssentialTrueDofs(ess_tdof_list);
-   Hform->Mult(k, resid);
-   Jacobian = &Hform->GetGradient(x);
+   if (full_oper) {
+      // We only need to assemble things once since we can apply our BCs afterwards
+      full_oper->Assemble().Mult(x, y);
+      Hform->Mult(k, resid);
+      Jacobian = &full_oper->EliminateBC(ess_tdof_list);
+   }
+   else if (pa_oper) {
+      Hform->Setup();
+      // Our PA data doesn't depend on the essential true dofs, so we only need to assemble
+      // it once. Our gradient operator shares its essential true dofs with Hform, so
+      // without any of them we get the local action of our gradient.
+      pa_oper->AssembleGradient(need_diag ? &diag : nullptr);
+      Hform->SetEssentialTrueDofs(zero_tdofs);
+      pa_oper->Mult(x, y);
+      Hform->SetEssentialTrueDofs(ess_tdof_list);
+      MultElementLocal(resid);
+      Jacobian = pa_oper;
+   }
+   else {
+      Hform->Setup();
+      Hform->SetEssentialTrueDofs(zero_tdofs);
+      auto &loc_jacobian = Hform->GetGradient(x);
+      loc_jacobian.Mult(x, y);
+      Hform->SetEssentialTrueDofs(ess_tdof_list);
+      if (assembly == Assembly::FULL) {
+         Hform->Mult(k, resid);
+      }
+      else {
+         MultElementLocal(resid);
+      }
+      Jacobian = &Hform->GetGradient(x);
+      if (need_diag) {
+         Jacobian->AssembleDiagonal(diag);
+      }
+   }
    CALI_MARK_END("mechop_Hform_LocalGrad");
 
+   if (mech_prec) {
+      mech_prec->Update(*Jacobian, diag);
+   }
+   else if (prec_oper) {
+      prec_oper->SetOperator(*Jacobian);
+      prec_oper->Setup(diag);
+   }
+
    {
       auto I = ess_tdof_list.Read();
       auto size = ess_tdof_list.Size();
@@ -485,5 +661,7 @@ Operator& NonlinearMechOperator::GetUpdateBCsAction(const Vector &k, const Vecto
 NonlinearMechOperator::~NonlinearMechOperator()
 {
    delete model;
+   delete full_oper;
+   delete pa_oper;
    delete Hform;
 }
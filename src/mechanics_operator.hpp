@@ -19,13 +19,25 @@ class NonlinearMechOperator : public mfem::NonlinearForm
 
       mfem::ParFiniteElementSpace &fe_space;
       mfem::ParNonlinearForm *Hform;
-      mutable mfem::Vector diag, qpts_dshape, el_x, px, el_jac;
+      mutable mfem::Vector diag, qpts_dshape, el_x, el_y, px, el_jac;
+      /// Jacobian of our reference configuration, which is only formed the first time
+      /// it's needed by CalculateDeformationGradient
+      mutable mfem::Vector ref_jac;
       mutable mfem::Operator *Jacobian;
+      /// Whether el_jac is up to date with our end coordinates
+      mutable bool geom_valid;
       const mfem::Vector *x;
       const mfem::ParGridFunction &x_ref;
       const mfem::ParGridFunction &x_cur;
+      /// Our gradient operator when using Assembly::PA. It assembles the PA data of our integrators
+      /// along with the diagonal of the gradient, and overlaps its halo exchange with the work of
+      /// our interior elements.
       mutable PANonlinearMechOperatorGradExt *pa_oper;
-      mutable MechOperatorJacobiSmoother *prec_oper;
+      mutable MechOperatorSmoother *prec_oper;
+      /// Preconditioner that needs to be updated with each new gradient operator
+      MechOperatorPreconditioner *mech_prec;
+      /// Builds our global gradient matrix from the EA kernels when using Assembly::FULL
+      FullMechOperatorGradAssembler *full_oper;
       const mfem::Operator *elem_restrict_lex;
       Assembly assembly;
       /// nonlinear model
@@ -36,6 +48,15 @@ class NonlinearMechOperator : public mfem::NonlinearForm
 
       const mfem::Array2D<bool> &ess_bdr_comps;
 
+      /// Whether our preconditioner makes use of the diagonal of our gradient operator
+      bool NeedsDiagonal() const;
+
+      /// Whether the material tangent stiffness matrix from our last model setup has been put
+      /// in the format our integrators need. Our residual evaluations don't need it, so that
+      /// work is put off until a gradient is actually formed.
+      mutable bool tangent_valid;
+      void SetupTangent() const;
+
    public:
       NonlinearMechOperator(mfem::ParFiniteElementSpace &fes,
                             mfem::Array<int> &ess_bdr,
@@ -52,7 +73,8 @@ class NonlinearMechOperator : public mfem::NonlinearForm
                             mfem::ParGridFunction &beg_crds,
                             mfem::ParGridFunction &end_crds,
                             mfem::Vector &matProps,
-                            int nStateVars);
+                            int nStateVars,
+                            const mfem::Array<mfem::ParMesh*> &coarse_meshes);
 
       /// Computes our jacobian operator for the entire system to be used within
       /// the newton raphson solver.
@@ -77,6 +99,14 @@ class NonlinearMechOperator : public mfem::NonlinearForm
       void Setup(const mfem::Vector &k) const;
 
       void SetupJacobianTerms() const;
+      /// Forms the jacobian at each quadrature point of the mesh's current nodes in the
+      /// (dim, dim, nqpts, nelems) col. major layout that our kernels expect.
+      void ComputeJacobianTerms(mfem::Vector &jac) const;
+
+      /// Computes our residual for the PA and EA assembly types straight from the E-vector
+      /// formed in Setup. This avoids Hform->Mult repeating the prolongation and
+      /// element restriction of our velocity field (along with its halo exchange).
+      void MultElementLocal(mfem::Vector &y) const;
       void CalculateDeformationGradient(mfem::QuadratureFunction &def_grad) const;
 
       // We need the solver to update the end coords after each iteration has been complete
@@ -93,7 +123,17 @@ class NonlinearMechOperator : public mfem::NonlinearForm
 
       ExaModel *GetModel() const;
 
-      MechOperatorJacobiSmoother *GetPAPreconditioner(){ return prec_oper; }
+      /// Saves off our model's end time step state so that a failed solve can be rolled back
+      void SaveEndState() const { model->SaveEndState(); }
+      /// Rolls our model's end time step state back to our last SaveEndState call. Our mesh
+      /// nodes are the end coordinates so our geometry and tangent are now out of date.
+      void RestoreEndState() const;
+
+      mfem::Solver *GetPAPreconditioner()
+      {
+         if (mech_prec) { return mech_prec; }
+         return prec_oper;
+      }
 
       virtual ~NonlinearMechOperator();
 };
@@ -6,6 +6,9 @@
 #include "mechanics_operator.hpp"
 #include "RAJA/RAJA.hpp"
 
+#include <algorithm>
+#include <cmath>
+
 using namespace mfem;
 
 MechOperatorJacobiSmoother::MechOperatorJacobiSmoother(const Vector &d,
@@ -17,7 +20,8 @@ MechOperatorJacobiSmoother::MechOperatorJacobiSmoother(const Vector &d,
    dinv(N),
    damping(dmpng),
    ess_tdof_list(ess_tdofs),
-   residual(N)
+   residual(N),
+   oper(nullptr)
 {
    Setup(d);
 }
@@ -54,6 +58,165 @@ void MechOperatorJacobiSmoother::Mult(const Vector &x, Vector &y) const
    MFEM_FORALL(i, N, Y[i] += DI[i] * R[i]; );
 }
 
+MechOperatorChebyshevSmoother::MechOperatorChebyshevSmoother(MPI_Comm _comm,
+                                                             const Vector &d,
+                                                             const Array<int> &ess_tdofs,
+                                                             const int _order,
+                                                             const int _power_iters,
+                                                             const double _eig_ratio)
+   :
+   MechOperatorSmoother(d.Size()),
+   comm(_comm),
+   N(d.Size()),
+   order(_order),
+   power_iters(_power_iters),
+   eig_ratio(_eig_ratio),
+   dinv(N),
+   eig_vec(N),
+   max_eig(0.0),
+   num_power_iters(0),
+   ess_tdof_list(ess_tdofs),
+   residual(N),
+   dir(N),
+   adir(N),
+   oper(nullptr)
+{
+   MFEM_VERIFY(order > 0, "The Chebyshev smoother requires an order of at least 1");
+   MFEM_VERIFY(eig_ratio > 1.0, "The Chebyshev smoother requires an eigenvalue ratio greater than 1");
+   residual.UseDevice(true);
+   dir.UseDevice(true);
+   adir.UseDevice(true);
+   dinv.UseDevice(true);
+   // Our first power iteration starts off from a random vector, and every
+   // later one starts off from the eigenvector of the previous estimate.
+   eig_vec.Randomize(1);
+   eig_vec.UseDevice(true);
+   {
+      auto D = d.Read();
+      auto DI = dinv.Write();
+      MFEM_FORALL(i, N, DI[i] = 1.0 / D[i]; );
+      auto I = ess_tdof_list.Read();
+      MFEM_FORALL(i, ess_tdof_list.Size(), DI[I[i]] = 1.0; );
+   }
+}
+
+void MechOperatorChebyshevSmoother::Setup(const Vector &diag)
+{
+   CALI_CXX_MARK_SCOPE("chebyshev_setup");
+   MFEM_VERIFY(oper, "SetOperator must be called before the Chebyshev smoother can be setup");
+   {
+      auto D = diag.Read();
+      auto DI = dinv.Write();
+      MFEM_FORALL(i, N, DI[i] = 1.0 / D[i]; );
+      auto I = ess_tdof_list.Read();
+      MFEM_FORALL(i, ess_tdof_list.Size(), DI[I[i]] = 1.0; );
+   }
+   EstimateMaxEig();
+}
+
+void MechOperatorChebyshevSmoother::EstimateMaxEig()
+{
+   // Our operator is the identity on the essential true dofs, so we leave them
+   // out of our estimate.
+   auto I = ess_tdof_list.Read();
+   const int ness = ess_tdof_list.Size();
+   {
+      auto V = eig_vec.ReadWrite();
+      MFEM_FORALL(i, ness, V[I[i]] = 0.0; );
+   }
+   double nrm = sqrt(InnerProduct(comm, eig_vec, eig_vec));
+   if (nrm == 0.0) {
+      // The essential true dofs wiped out our previous eigenvector
+      eig_vec.HostWrite();
+      eig_vec.Randomize(1);
+      auto V = eig_vec.ReadWrite();
+      MFEM_FORALL(i, ness, V[I[i]] = 0.0; );
+      nrm = sqrt(InnerProduct(comm, eig_vec, eig_vec));
+   }
+   eig_vec /= nrm;
+
+   // The tolerance on the relative change of our estimate between iterations.
+   // The Chebyshev polynomial is pretty forgiving of errors in lambda_max so
+   // this doesn't need to be tight.
+   const double eig_tol = 1.0e-2;
+   double lambda = 0.0;
+   num_power_iters = 0;
+   for (int it = 0; it < power_iters; it++) {
+      const double lambda_old = lambda;
+      oper->Mult(eig_vec, adir);
+      {
+         auto DI = dinv.Read();
+         auto AD = adir.ReadWrite();
+         MFEM_FORALL(i, N, AD[i] *= DI[i]; );
+         MFEM_FORALL(i, ness, AD[I[i]] = 0.0; );
+      }
+      // Our eigenvector has a unit norm
+      lambda = sqrt(InnerProduct(comm, adir, adir));
+      num_power_iters++;
+      if (lambda == 0.0) { break; }
+      eig_vec.Set(1.0 / lambda, adir);
+      if (it > 0 && fabs(lambda - lambda_old) < eig_tol * lambda) { break; }
+   }
+   MFEM_VERIFY(lambda > 0.0, "The Chebyshev smoother could not estimate the largest eigenvalue of its operator");
+   max_eig = lambda;
+}
+
+void MechOperatorChebyshevSmoother::Mult(const Vector &x, Vector &y) const
+{
+   MFEM_ASSERT(x.Size() == N, "invalid input vector");
+   MFEM_ASSERT(y.Size() == N, "invalid output vector");
+   MFEM_VERIFY(oper && max_eig > 0.0, "Setup must be called before the Chebyshev smoother can be applied");
+
+   if (iterative_mode) {
+      oper->Mult(y, residual); // r = A x
+      subtract(x, residual, residual); // r = b - A x
+   }
+   else {
+      residual = x;
+      y.UseDevice(true);
+      y = 0.0;
+   }
+
+   // The bounds of the eigenvalues we're damping where our upper bound has a
+   // safety factor since the power iterations underestimate lambda_max
+   const double upper = 1.1 * max_eig;
+   const double lower = upper / eig_ratio;
+   const double theta = 0.5 * (upper + lower);
+   const double delta = 0.5 * (upper - lower);
+   const double sigma = theta / delta;
+   double rho = 1.0 / sigma;
+
+   auto DI = dinv.Read();
+   {
+      const double c = 1.0 / theta;
+      auto R = residual.Read();
+      auto D = dir.Write();
+      auto Y = y.ReadWrite();
+      MFEM_FORALL(i, N, {
+         D[i] = c * DI[i] * R[i];
+         Y[i] += D[i];
+      });
+   }
+
+   // The three term recurrence of the Chebyshev polynomials where each term
+   // needs one more action of our operator.
+   for (int k = 1; k < order; k++) {
+      oper->Mult(dir, adir);
+      residual -= adir;
+      const double rho_new = 1.0 / (2.0 * sigma - rho);
+      const double c0 = rho_new * rho;
+      const double c1 = 2.0 * rho_new / delta;
+      auto R = residual.Read();
+      auto D = dir.ReadWrite();
+      auto Y = y.ReadWrite();
+      MFEM_FORALL(i, N, {
+         D[i] = c0 * D[i] + c1 * DI[i] * R[i];
+         Y[i] += D[i];
+      });
+      rho = rho_new;
+   }
+}
+
 NonlinearMechOperatorExt::NonlinearMechOperatorExt(NonlinearForm *_oper_mech)
    : Operator(_oper_mech->FESpace()->GetTrueVSize()), oper_mech(_oper_mech)
 {
@@ -61,7 +224,8 @@ NonlinearMechOperatorExt::NonlinearMechOperatorExt(NonlinearForm *_oper_mech)
 }
 
 PANonlinearMechOperatorGradExt::PANonlinearMechOperatorGradExt(NonlinearForm *_oper_mech, const mfem::Array<int> &ess_tdofs) :
-   NonlinearMechOperatorExt(_oper_mech), fes(_oper_mech->FESpace()), ess_tdof_list(ess_tdofs)
+   NonlinearMechOperatorExt(_oper_mech), fes(_oper_mech->FESpace()), ess_tdof_list(ess_tdofs),
+   gc(nullptr), use_overlap(true)
 {
    // So, we're going to originally support non tensor-product type elements originally.
    const ElementDofOrdering ordering = ElementDofOrdering::NATIVE;
@@ -78,7 +242,69 @@ PANonlinearMechOperatorGradExt::PANonlinearMechOperatorGradExt(NonlinearForm *_o
       localX.UseDevice(true);
       px.UseDevice(true);
       ones = 1.0;
+      SetupHaloOverlap();
+   }
+}
+
+void PANonlinearMechOperatorGradExt::SetupHaloOverlap()
+{
+   // The overlap is only done on the host, since the device path of P->Mult already
+   // packs and exchanges its buffers through its own device aware code path.
+   const ParFiniteElementSpace *pfes = dynamic_cast<const ParFiniteElementSpace*>(fes);
+   if (!pfes || pfes->GetNRanks() == 1 || !pfes->Conforming() ||
+       Device::Allows(Backend::DEVICE_MASK)) {
+      return;
+   }
+
+   gc = &pfes->GroupComm();
+
+   // Same as the ConformingProlongationOperator: the local dofs we don't own are the ones
+   // that belong to groups that we're not the master of.
+   const GroupTopology &gtopo = gc->GetGroupTopology();
+   const Table &group_ldof = gc->GroupLDofTable();
+   for (int gr = 1; gr < group_ldof.Size(); gr++) {
+      if (!gtopo.IAmMaster(gr)) {
+         external_ldofs.Append(group_ldof.GetRow(gr), group_ldof.RowSize(gr));
+      }
+   }
+   external_ldofs.Sort();
+
+   // Interior elements only touch the dofs we own, so they can be computed before our
+   // halo values come in.
+   Array<int> vdofs;
+   const int nelems = pfes->GetNE();
+   for (int ie = 0; ie < nelems; ie++) {
+      pfes->GetElementVDofs(ie, vdofs);
+      bool interior = true;
+      for (int i = 0; i < vdofs.Size(); i++) {
+         const int ldof = (vdofs[i] >= 0) ? vdofs[i] : -1 - vdofs[i];
+         if (pfes->GetLocalTDofNumber(ldof) < 0) {
+            interior = false;
+            break;
+         }
+      }
+      if (interior) {
+         interior_elems.Append(ie);
+      }
+      else {
+         boundary_elems.Append(ie);
+      }
+   }
+}
+
+bool PANonlinearMechOperatorGradExt::OverlapHalo() const
+{
+   if (!gc || !use_overlap) {
+      return false;
+   }
+   // Only our integrators know how to apply themselves over a subset of elements
+   Array<NonlinearFormIntegrator*> &integrators = *oper_mech->GetDNFI();
+   for (int i = 0; i < integrators.Size(); ++i) {
+      if (!dynamic_cast<ExaNLFIntegrator*>(integrators[i])) {
+         return false;
+      }
    }
+   return true;
 }
 
 void PANonlinearMechOperatorGradExt::Assemble()
@@ -92,28 +318,58 @@ void PANonlinearMechOperatorGradExt::Assemble()
    }
 }
 
+void PANonlinearMechOperatorGradExt::AssembleGradient(Vector *diag)
+{
+   CALI_CXX_MARK_SCOPE("PA_AssembleGradient");
+   Array<NonlinearFormIntegrator*> &integrators = *oper_mech->GetDNFI();
+   const int num_int = integrators.Size();
+
+   Vector *diag_e = elem_restrict_lex ? &localY : diag;
+   if (diag) {
+      diag_e->UseDevice(true); // typically this is a large vector, so store on device
+      *diag_e = 0.0;
+   }
+
+   for (int i = 0; i < num_int; ++i) {
+      ExaNLFIntegrator *integ = dynamic_cast<ExaNLFIntegrator*>(integrators[i]);
+      if (diag && integ) {
+         integ->AssembleGradPADiagonal(*oper_mech->FESpace(), *diag_e);
+      }
+      else {
+         integrators[i]->AssembleGradPA(*oper_mech->FESpace());
+         if (diag) {
+            integrators[i]->AssembleGradDiagonalPA(*diag_e);
+         }
+      }
+   }
+
+   if (diag) {
+      FinalizeDiagonal(*diag);
+   }
+}
+
 void PANonlinearMechOperatorGradExt::AssembleDiagonal(Vector &diag)
 {
    CALI_CXX_MARK_SCOPE("AssembleDiagonal");
    Array<NonlinearFormIntegrator*> &integrators = *oper_mech->GetDNFI();
    const int num_int = integrators.Size();
 
-   if (elem_restrict_lex) {
-      localY = 0.0;
-      for (int i = 0; i < num_int; ++i) {
-         integrators[i]->AssembleGradDiagonalPA(localY);
-      }
+   Vector &diag_e = elem_restrict_lex ? localY : diag;
+   diag_e.UseDevice(true); // typically this is a large vector, so store on device
+   diag_e = 0.0;
+   for (int i = 0; i < num_int; ++i) {
+      integrators[i]->AssembleGradDiagonalPA(diag_e);
+   }
 
+   FinalizeDiagonal(diag);
+}
+
+void PANonlinearMechOperatorGradExt::FinalizeDiagonal(Vector &diag)
+{
+   if (elem_restrict_lex) {
       elem_restrict_lex->MultTranspose(localY, px);
       P->MultTranspose(px, diag);
    }
-   else {
-      diag.UseDevice(true); // typically this is a large vector, so store on device
-      diag = 0.0;
-      for (int i = 0; i < num_int; ++i) {
-         integrators[i]->AssembleGradDiagonalPA(diag);
-      }
-   }
 
    // Apply the essential boundary conditions
    auto Y = diag.ReadWrite();
@@ -145,7 +401,42 @@ void PANonlinearMechOperatorGradExt::TMult(const Vector &x, Vector &y) const
    auto Y = ones.ReadWrite();
    MFEM_FORALL(i, ess_tdof_list.Size(), Y[I[i]] = 0.0; );
 
-   if (elem_restrict_lex) {
+   if (elem_restrict_lex && OverlapHalo()) {
+      // This is P->Mult split up so that the interior elements are computed while
+      // the values of the dofs we don't own are still in flight.
+      const double *xdata = ones.HostRead();
+      double *pxdata = px.HostReadWrite();
+      gc->BcastBegin(const_cast<double*>(xdata), 2);
+      {
+         // Copy over the dofs we own, which are everything between our external dofs
+         int j = 0;
+         const int ned = external_ldofs.Size();
+         for (int i = 0; i < ned; i++) {
+            const int end = external_ldofs[i];
+            std::copy(xdata + j - i, xdata + end - i, pxdata + j);
+            j = end + 1;
+         }
+         std::copy(xdata + j - ned, xdata + ones.Size(), pxdata + j);
+      }
+      // The external values of px are stale here, but none of our interior elements read them
+      elem_restrict_lex->Mult(px, localX);
+      localY = 0.0;
+      for (int i = 0; i < num_int; ++i) {
+         auto integ = dynamic_cast<ExaNLFIntegrator*>(integrators[i]);
+         integ->AddMultGradPAElements(localX, localY, interior_elems);
+      }
+
+      gc->BcastEnd(pxdata, 0);
+      elem_restrict_lex->Mult(px, localX);
+      for (int i = 0; i < num_int; ++i) {
+         auto integ = dynamic_cast<ExaNLFIntegrator*>(integrators[i]);
+         integ->AddMultGradPAElements(localX, localY, boundary_elems);
+      }
+
+      elem_restrict_lex->MultTranspose(localY, px);
+      P->MultTranspose(px, y);
+   }
+   else if (elem_restrict_lex) {
       P->Mult(ones, px);
       elem_restrict_lex->Mult(px, localX);
       localY = 0.0;
@@ -210,19 +501,60 @@ EANonlinearMechOperatorGradExt::EANonlinearMechOperatorGradExt(NonlinearForm *_o
 
    ea_data.SetSize(NE * elemDofs * elemDofs, Device::GetMemoryType());
    ea_data.UseDevice(true);
+
+   // We can only get away with the packed storage if all of our element matrices are symmetric
+   ea_sym = true;
+   Array<NonlinearFormIntegrator*> &integrators = *_oper_mech->GetDNFI();
+   for (int i = 0; i < integrators.Size(); ++i) {
+      ExaNLFIntegrator *integ = dynamic_cast<ExaNLFIntegrator*>(integrators[i]);
+      ea_sym = ea_sym && (integ != nullptr) && integ->SymmetricGrad();
+   }
 }
 
 void EANonlinearMechOperatorGradExt::Assemble()
 {
+   CALI_CXX_MARK_SCOPE("EA_Assemble");
+   // The full element matrices are only kept around as scratch space for the
+   // assembly when we make use of the packed storage.
+   if (ea_data.Size() != (NE * elemDofs * elemDofs)) {
+      ea_data.SetSize(NE * elemDofs * elemDofs, Device::GetMemoryType());
+      ea_data.UseDevice(true);
+   }
+
    ea_data = 0.0;
 
-   CALI_CXX_MARK_SCOPE("EA_Assemble");
    Array<NonlinearFormIntegrator*> &integrators = *oper_mech->GetDNFI();
    const int num_int = integrators.Size();
    for (int i = 0; i < num_int; ++i) {
       integrators[i]->AssemblePA(*oper_mech->FESpace());
       integrators[i]->AssembleEA(*oper_mech->FESpace(), ea_data);
    }
+
+   if (ea_sym) {
+      CALI_CXX_MARK_SCOPE("EA_Pack");
+      const int NDOFS = elemDofs;
+      const int NPACK = (NDOFS * (NDOFS + 1)) / 2;
+      if (ea_packed.Size() != (NE * NPACK)) {
+         ea_packed.SetSize(NE * NPACK, Device::GetMemoryType());
+         ea_packed.UseDevice(true);
+      }
+      auto A = Reshape(ea_data.Read(), NDOFS, NDOFS, NE);
+      auto AP = Reshape(ea_packed.Write(), NPACK, NE);
+      const int elemDofs_ = elemDofs;
+      MFEM_FORALL(glob_j, NE * NDOFS,
+      {
+         const int NDOFS = elemDofs_;
+         const int e = glob_j / NDOFS;
+         const int j = glob_j % NDOFS;
+         const int offset = (j * (j + 1)) / 2;
+         for (int i = 0; i <= j; i++) {
+            AP(offset + i, e) = A(i, j, e);
+         }
+      });
+      // Release the full element matrices so we only hold onto the packed ones
+      // while the Krylov solver is running.
+      ea_data.Destroy();
+   }
 }
 
 void EANonlinearMechOperatorGradExt::AssembleDiagonal(Vector &diag)
@@ -241,15 +573,28 @@ void EANonlinearMechOperatorGradExt::AssembleDiagonal(Vector &diag)
    // Apply the Element Matrices
    const int NDOFS = elemDofs;
    auto Y = Reshape(useRestrict ? localY.ReadWrite() : diag.ReadWrite(), NDOFS, NE);
-   auto A = Reshape(ea_data.Read(), NDOFS, NDOFS, NE);
    const int elemDofs_ = elemDofs;
-   MFEM_FORALL(glob_j, NE * NDOFS,
-   {
-      const int NDOFS = elemDofs_;
-      const int e = glob_j / NDOFS;
-      const int j = glob_j % NDOFS;
-      Y(j, e) = A(j, j, e);
-   });
+   if (ea_sym) {
+      const int NPACK = (NDOFS * (NDOFS + 1)) / 2;
+      auto AP = Reshape(ea_packed.Read(), NPACK, NE);
+      MFEM_FORALL(glob_j, NE * NDOFS,
+      {
+         const int NDOFS = elemDofs_;
+         const int e = glob_j / NDOFS;
+         const int j = glob_j % NDOFS;
+         Y(j, e) = AP((j * (j + 1)) / 2 + j, e);
+      });
+   }
+   else {
+      auto A = Reshape(ea_data.Read(), NDOFS, NDOFS, NE);
+      MFEM_FORALL(glob_j, NE * NDOFS,
+      {
+         const int NDOFS = elemDofs_;
+         const int e = glob_j / NDOFS;
+         const int j = glob_j % NDOFS;
+         Y(j, e) = A(j, j, e);
+      });
+   }
 
    // Apply the Element Restriction transposed
    if (useRestrict) {
@@ -299,19 +644,44 @@ void EANonlinearMechOperatorGradExt::TMult(const Vector &x, Vector &y) const
    const int NDOFS = elemDofs;
    auto X = Reshape(useRestrict ? localX.Read() : ones.Read(), NDOFS, NE);
    auto Y = Reshape(useRestrict ? localY.ReadWrite() : y.ReadWrite(), NDOFS, NE);
-   auto A = Reshape(ea_data.Read(), NDOFS, NDOFS, NE);
-   MFEM_FORALL(glob_j, NE * NDOFS,
-   {
-      const int NDOFS_ = NDOFS;
-      const int e = glob_j / NDOFS_;
-      const int j = glob_j % NDOFS_;
-      double res = 0.0;
-      for (int i = 0; i < NDOFS_; i++) {
-         res += A(i, j, e) * X(i, e);
-      }
+   if (ea_sym) {
+      // Row j of our element matrix is made up of the packed column j above the
+      // diagonal and then entry j of each of the following packed columns.
+      // The latter is contiguous across neighboring rows.
+      const int NPACK = (NDOFS * (NDOFS + 1)) / 2;
+      auto AP = Reshape(ea_packed.Read(), NPACK, NE);
+      MFEM_FORALL(glob_j, NE * NDOFS,
+      {
+         const int NDOFS_ = NDOFS;
+         const int e = glob_j / NDOFS_;
+         const int j = glob_j % NDOFS_;
+         const int offset = (j * (j + 1)) / 2;
+         double res = 0.0;
+         for (int i = 0; i <= j; i++) {
+            res += AP(offset + i, e) * X(i, e);
+         }
+         for (int i = j + 1; i < NDOFS_; i++) {
+            res += AP((i * (i + 1)) / 2 + j, e) * X(i, e);
+         }
 
-      Y(j, e) += res;
-   });
+         Y(j, e) += res;
+      });
+   }
+   else {
+      auto A = Reshape(ea_data.Read(), NDOFS, NDOFS, NE);
+      MFEM_FORALL(glob_j, NE * NDOFS,
+      {
+         const int NDOFS_ = NDOFS;
+         const int e = glob_j / NDOFS_;
+         const int j = glob_j % NDOFS_;
+         double res = 0.0;
+         for (int i = 0; i < NDOFS_; i++) {
+            res += A(i, j, e) * X(i, e);
+         }
+
+         Y(j, e) += res;
+      });
+   }
    // Apply the Element Restriction transposed
    if (useRestrict) {
       elem_restrict_lex->MultTranspose(localY, px);
@@ -326,3 +696,1205 @@ void EANonlinearMechOperatorGradExt::TMult(const Vector &x, Vector &y) const
       MFEM_FORALL(i, ess_tdof_list.Size(), R[I[i]] = 0.0; );
    }
 }
+
+namespace {
+// Forms the sparsity pattern of an L-vector sized local matrix from a set of element
+// dof lists, where elem_vdofs holds elem_dofs entries for each element. We also form
+// the map from each entry of the element matrices to the CSR entry they sum into.
+// The element matrices follow the EA convention where A(i, j, e) is the contribution
+// to row j and column i of the local matrix.
+SparseMatrix *SetupElementCSRGather(const Array<int> &elem_vdofs,
+                                    const int elem_dofs,
+                                    const int vsize,
+                                    Array<int> &csr_offsets,
+                                    Array<int> &csr_sources)
+{
+   const int nelems = elem_vdofs.Size() / elem_dofs;
+   const int NDOFS = elem_dofs;
+
+   // Form the same sparsity pattern that an element by element assembly would produce
+   // while keeping any explicit zeros so that our map below stays fixed.
+   SparseMatrix *mat = new SparseMatrix(vsize);
+   for (int e = 0; e < nelems; e++) {
+      const int *vdofs = &elem_vdofs[e * NDOFS];
+      for (int j = 0; j < NDOFS; j++) {
+         MFEM_VERIFY(vdofs[j] >= 0, "Negatively oriented dofs aren't supported when gathering element matrices");
+         for (int i = 0; i < NDOFS; i++) {
+            mat->Add(vdofs[j], vdofs[i], 0.0);
+         }
+      }
+   }
+   mat->Finalize(0);
+   mat->SortColumnIndices();
+
+   const int nnz = mat->NumNonZeroElems();
+   const int *row_ptr = mat->HostReadI();
+   const int *col_ind = mat->HostReadJ();
+
+   Array<int> ea_to_csr(nelems * NDOFS * NDOFS);
+   csr_offsets.SetSize(nnz + 1);
+   csr_offsets = 0;
+   for (int e = 0; e < nelems; e++) {
+      const int *vdofs = &elem_vdofs[e * NDOFS];
+      for (int j = 0; j < NDOFS; j++) {
+         const int *row_beg = col_ind + row_ptr[vdofs[j]];
+         const int *row_end = col_ind + row_ptr[vdofs[j] + 1];
+         for (int i = 0; i < NDOFS; i++) {
+            const int loc = (int) (std::lower_bound(row_beg, row_end, vdofs[i]) - col_ind);
+            ea_to_csr[i + NDOFS * (j + NDOFS * e)] = loc;
+            csr_offsets[loc + 1]++;
+         }
+      }
+   }
+
+   csr_offsets.PartialSum();
+   csr_sources.SetSize(csr_offsets[nnz]);
+   Array<int> fill(nnz);
+   for (int i = 0; i < nnz; i++) {
+      fill[i] = csr_offsets[i];
+   }
+   for (int k = 0; k < ea_to_csr.Size(); k++) {
+      csr_sources[fill[ea_to_csr[k]]++] = k;
+   }
+
+   return mat;
+}
+
+// Fills the CSR data of mat with the element matrices in ea_data using the map
+// formed by SetupElementCSRGather. Each CSR entry gathers its own element
+// contributions so no atomics are needed.
+void FillElementCSR(const Vector &ea_data,
+                    const Array<int> &csr_offsets,
+                    const Array<int> &csr_sources,
+                    SparseMatrix &mat)
+{
+   CALI_CXX_MARK_SCOPE("fill_element_csr");
+   const int nnz = mat.NumNonZeroElems();
+   auto offsets = csr_offsets.Read();
+   auto sources = csr_sources.Read();
+   auto A = ea_data.Read();
+   auto D = mat.WriteData();
+   MFEM_FORALL(i, nnz, {
+      double sum = 0.0;
+      for (int k = offsets[i]; k < offsets[i + 1]; k++) {
+         sum += A[sources[k]];
+      }
+      D[i] = sum;
+   });
+   // hypre copies our local matrix over on the host
+   mat.HostReadData();
+}
+
+// Forms P^T A P from our local matrix, which mirrors what ParNonlinearForm::GetGradient does
+void ParallelAssembleLocal(ParFiniteElementSpace *pfes, SparseMatrix *loc_mat, OperatorHandle &pmat)
+{
+   pmat.Clear();
+   OperatorHandle dA(pmat.Type()), Ph(pmat.Type());
+   dA.MakeSquareBlockDiag(pfes->GetComm(), pfes->GlobalVSize(), pfes->GetDofOffsets(), loc_mat);
+   Ph.ConvertFrom(pfes->Dof_TrueDof_Matrix());
+   pmat.MakePtAP(dA, Ph);
+}
+
+// Averages the 6x6 material tangent of each element over its quadrature points
+// where elem_tan has a (36, nelems) layout.
+void ElementAverageTangent(ExaModel *model, const int nqpts, const int nelems, Vector &elem_tan)
+{
+   const int DIM4 = 4;
+   std::array<RAJA::idx_t, DIM4> perm4 {{ 3, 2, 1, 0 } };
+   RAJA::Layout<DIM4> layout_tensor = RAJA::make_permuted_layout({{ 6, 6, nqpts, nelems } }, perm4);
+   RAJA::View<const double, RAJA::Layout<DIM4, RAJA::Index_type, 0> > K(model->GetMatGrad()->Read(), layout_tensor);
+
+   auto KE = Reshape(elem_tan.Write(), 36, nelems);
+   MFEM_FORALL(i_elems, nelems, {
+      const double inv_nqpts = 1.0 / nqpts;
+      for (int j = 0; j < 6; j++) {
+         for (int i = 0; i < 6; i++) {
+            double sum = 0.0;
+            for (int j_qpts = 0; j_qpts < nqpts; j_qpts++) {
+               sum += K(i, j, j_qpts, i_elems);
+            }
+            KE(i + 6 * j, i_elems) = sum * inv_nqpts;
+         }
+      }
+   });
+}
+
+// Creates the smoother used on one of our multigrid levels
+MechOperatorSmoother *NewMGSmoother(MPI_Comm comm,
+                                    const Vector &diag,
+                                    const Array<int> &ess_tdofs,
+                                    const SmootherType smoother_type,
+                                    const int cheb_order,
+                                    const int cheb_power_iters)
+{
+   MechOperatorSmoother *smoother;
+   if (smoother_type == SmootherType::CHEBYSHEV) {
+      // Our coarser levels take care of the lower part of the spectrum
+      const double eig_ratio = 3.0;
+      smoother = new MechOperatorChebyshevSmoother(comm, diag, ess_tdofs, cheb_order,
+                                                   cheb_power_iters, eig_ratio);
+   }
+   else {
+      // A damping factor that's commonly used for Jacobi smoothing within multigrid
+      const double damping = 2.0 / 3.0;
+      smoother = new MechOperatorJacobiSmoother(diag, ess_tdofs, damping);
+   }
+   smoother->iterative_mode = true;
+   return smoother;
+}
+} // end of anonymous namespace
+
+FullMechOperatorGradAssembler::FullMechOperatorGradAssembler(ParNonlinearForm *_oper_mech)
+   : oper_mech(_oper_mech), loc_mat(nullptr), pGrad(Operator::Hypre_ParCSR)
+{
+   NE = _oper_mech->FESpace()->GetMesh()->GetNE();
+   elemDofs = _oper_mech->FESpace()->GetFE(0)->GetDof() * _oper_mech->FESpace()->GetFE(0)->GetDim();
+
+   ea_data.SetSize(NE * elemDofs * elemDofs, Device::GetMemoryType());
+   ea_data.UseDevice(true);
+
+   SetupSparsity();
+}
+
+FullMechOperatorGradAssembler::~FullMechOperatorGradAssembler()
+{
+   delete loc_mat;
+}
+
+void FullMechOperatorGradAssembler::SetupSparsity()
+{
+   CALI_CXX_MARK_SCOPE("full_ea_setup_sparsity");
+   const FiniteElementSpace *fes = oper_mech->FESpace();
+
+   Array<int> elem_vdofs(NE * elemDofs);
+   Array<int> vdofs;
+   for (int e = 0; e < NE; e++) {
+      fes->GetElementVDofs(e, vdofs);
+      for (int i = 0; i < elemDofs; i++) {
+         elem_vdofs[i + e * elemDofs] = vdofs[i];
+      }
+   }
+
+   delete loc_mat;
+   loc_mat = SetupElementCSRGather(elem_vdofs, elemDofs, fes->GetVSize(), csr_offsets, csr_sources);
+}
+
+HypreParMatrix &FullMechOperatorGradAssembler::Assemble()
+{
+   CALI_CXX_MARK_SCOPE("full_ea_assemble");
+   const FiniteElementSpace *fes = oper_mech->FESpace();
+   ea_data = 0.0;
+
+   Array<NonlinearFormIntegrator*> &integrators = *oper_mech->GetDNFI();
+   const int num_int = integrators.Size();
+   for (int i = 0; i < num_int; ++i) {
+      integrators[i]->AssemblePA(*fes);
+      integrators[i]->AssembleEA(*fes, ea_data);
+   }
+
+   FillElementCSR(ea_data, csr_offsets, csr_sources, *loc_mat);
+   ParallelAssembleLocal(oper_mech->ParFESpace(), loc_mat, pGrad);
+
+   return *pGrad.As<HypreParMatrix>();
+}
+
+HypreParMatrix &FullMechOperatorGradAssembler::EliminateBC(const Array<int> &ess_tdofs)
+{
+   OperatorHandle pGrad_e;
+   pGrad_e.EliminateRowsCols(pGrad, ess_tdofs);
+   return *pGrad.As<HypreParMatrix>();
+}
+
+MechOperatorLORAMG::MechOperatorLORAMG(ParFiniteElementSpace &_fes,
+                                       ExaModel *_model,
+                                       const ParGridFunction &_x_cur,
+                                       const Array<int> &ess_tdofs)
+   : MechOperatorPreconditioner(_fes.GetTrueVSize()),
+   fes(_fes),
+   model(_model),
+   x_cur(_x_cur),
+   ess_tdof_list(ess_tdofs),
+   loc_mat(nullptr),
+   lor_mat(nullptr),
+   amg(nullptr)
+{
+   CALI_CXX_MARK_SCOPE("lor_amg_setup");
+   const FiniteElement &el = *fes.GetFE(0);
+   const TensorBasisElement *tbe = dynamic_cast<const TensorBasisElement*>(&el);
+   MFEM_VERIFY(tbe && (el.GetGeomType() == Geometry::CUBE),
+               "The LOR AMG preconditioner requires tensor-product hexahedral elements");
+   const IntegrationRule *ir = &(IntRules.Get(el.GetGeomType(), 2 * el.GetOrder() + 1));
+
+   nqpts = ir->GetNPoints();
+   nnodes = el.GetDof();
+   NE = fes.GetNE();
+   const int order = el.GetOrder();
+   const int order1 = order + 1;
+   nsub_elem = order * order * order;
+   // Maps lexicographic node indices to our native ones
+   const Array<int> &dof_map = tbe->GetDofMap();
+
+   // The vertices of each sub-element are in lexicographic order so vertex n = a + 2b + 4c
+   // for a, b, c in {0, 1}.
+   sub_nodes.SetSize(8 * nsub_elem);
+   for (int k = 0; k < order; k++) {
+      for (int j = 0; j < order; j++) {
+         for (int i = 0; i < order; i++) {
+            const int s = i + order * (j + order * k);
+            for (int n = 0; n < 8; n++) {
+               const int lex = (i + (n & 1)) + order1 * ((j + ((n >> 1) & 1)) + order1 * (k + ((n >> 2) & 1)));
+               sub_nodes[n + 8 * s] = (dof_map.Size() > 0) ? dof_map[lex] : lex;
+            }
+         }
+      }
+   }
+
+   // The dofs of each sub-element follow the same vdim ordering as our E-vectors
+   const int SDOFS = 24;
+   Array<int> elem_vdofs(NE * nsub_elem * SDOFS);
+   Array<int> vdofs;
+   for (int e = 0; e < NE; e++) {
+      fes.GetElementVDofs(e, vdofs);
+      for (int s = 0; s < nsub_elem; s++) {
+         for (int d = 0; d < 3; d++) {
+            for (int n = 0; n < 8; n++) {
+               elem_vdofs[n + 8 * d + SDOFS * (s + nsub_elem * e)] = vdofs[sub_nodes[n + 8 * s] + nnodes * d];
+            }
+         }
+      }
+   }
+   loc_mat = SetupElementCSRGather(elem_vdofs, SDOFS, fes.GetVSize(), csr_offsets, csr_sources);
+
+   elem_restrict_lex = fes.GetElementRestriction(ElementDofOrdering::NATIVE);
+   el_crds.SetSize(elem_restrict_lex->Height(), Device::GetMemoryType());
+   el_crds.UseDevice(true);
+   elem_tan.SetSize(36 * NE, Device::GetMemoryType());
+   elem_tan.UseDevice(true);
+   lor_data.SetSize(NE * nsub_elem * SDOFS * SDOFS, Device::GetMemoryType());
+   lor_data.UseDevice(true);
+
+   amg = new HypreBoomerAMG();
+   amg->SetPrintLevel(0);
+   amg->SetSystemsOptions(3, fes.GetOrdering() == Ordering::byNODES);
+   amg->iterative_mode = false;
+}
+
+MechOperatorLORAMG::~MechOperatorLORAMG()
+{
+   delete amg;
+   delete lor_mat;
+   delete loc_mat;
+}
+
+void MechOperatorLORAMG::AssembleSubElements()
+{
+   CALI_CXX_MARK_SCOPE("lor_amg_assemble_sub_elems");
+   // The element averaged material tangent is used for all of an element's sub-elements
+   ElementAverageTangent(model, nqpts, NE, elem_tan);
+
+   // Our sub-element vertices are the current nodal coordinates of the mesh
+   elem_restrict_lex->Mult(x_cur, el_crds);
+
+   const double dt = model->GetModelDt();
+   const int nsub = NE * nsub_elem;
+   const int nsub_elem_ = nsub_elem;
+   // Points of the 2x2x2 Gauss rule on the unit interval
+   const double gp0 = 0.5 - 0.5 / sqrt(3.0);
+   const double gp1 = 0.5 + 0.5 / sqrt(3.0);
+   auto X = Reshape(el_crds.Read(), nnodes, 3, NE);
+   auto KE = Reshape(elem_tan.Read(), 36, NE);
+   auto SN = Reshape(sub_nodes.Read(), 8, nsub_elem);
+   auto A = Reshape(lor_data.Write(), 24, 24, nsub);
+   MFEM_FORALL(s, nsub, {
+      const int e = s / nsub_elem_;
+      const int sl = s % nsub_elem_;
+      double crds[24];
+      for (int d = 0; d < 3; d++) {
+         for (int n = 0; n < 8; n++) {
+            crds[n + 8 * d] = X(SN(n, sl), d, e);
+         }
+      }
+      for (int j = 0; j < 24; j++) {
+         for (int i = 0; i < 24; i++) {
+            A(i, j, s) = 0.0;
+         }
+      }
+
+      for (int q = 0; q < 8; q++) {
+         const double xi[3] = { (q & 1) ? gp1 : gp0, ((q >> 1) & 1) ? gp1 : gp0, ((q >> 2) & 1) ? gp1 : gp0 };
+         // Trilinear shape function gradients dN[n + 8k] = dN_n / dxi_k
+         double dN[24];
+         for (int n = 0; n < 8; n++) {
+            const int a = n & 1;
+            const int b = (n >> 1) & 1;
+            const int c = (n >> 2) & 1;
+            const double la = a ? xi[0] : 1.0 - xi[0];
+            const double lb = b ? xi[1] : 1.0 - xi[1];
+            const double lc = c ? xi[2] : 1.0 - xi[2];
+            dN[n] = (a ? 1.0 : -1.0) * lb * lc;
+            dN[n + 8] = la * (b ? 1.0 : -1.0) * lc;
+            dN[n + 16] = la * lb * (c ? 1.0 : -1.0);
+         }
+         // J[l + 3k] = dx_l / dxi_k
+         double J[9];
+         for (int k = 0; k < 3; k++) {
+            for (int l = 0; l < 3; l++) {
+               double sum = 0.0;
+               for (int n = 0; n < 8; n++) {
+                  sum += crds[n + 8 * l] * dN[n + 8 * k];
+               }
+               J[l + 3 * k] = sum;
+            }
+         }
+         const double detJ = J[0] * (J[4] * J[8] - J[5] * J[7]) -
+                             /* */ J[3] * (J[1] * J[8] - J[2] * J[7]) +
+                             /* */ J[6] * (J[1] * J[5] - J[2] * J[4]);
+         const double idetJ = 1.0 / detJ;
+         // Jinv[k + 3l] = dxi_k / dx_l
+         double Jinv[9];
+         Jinv[0] = idetJ * (J[4] * J[8] - J[5] * J[7]);
+         Jinv[1] = idetJ * (J[2] * J[7] - J[1] * J[8]);
+         Jinv[2] = idetJ * (J[1] * J[5] - J[2] * J[4]);
+         Jinv[3] = idetJ * (J[5] * J[6] - J[3] * J[8]);
+         Jinv[4] = idetJ * (J[0] * J[8] - J[2] * J[6]);
+         Jinv[5] = idetJ * (J[2] * J[3] - J[0] * J[5]);
+         Jinv[6] = idetJ * (J[3] * J[7] - J[4] * J[6]);
+         Jinv[7] = idetJ * (J[1] * J[6] - J[0] * J[7]);
+         Jinv[8] = idetJ * (J[0] * J[4] - J[1] * J[3]);
+
+         // Our B matrix where the Voigt ordering is 11, 22, 33, 23, 13, 12 with
+         // engineering shear strains and column n + 8a is node n and component a
+         double B[144];
+         for (int i = 0; i < 144; i++) {
+            B[i] = 0.0;
+         }
+         for (int n = 0; n < 8; n++) {
+            double g[3];
+            for (int l = 0; l < 3; l++) {
+               g[l] = dN[n] * Jinv[3 * l] + dN[n + 8] * Jinv[1 + 3 * l] + dN[n + 16] * Jinv[2 + 3 * l];
+            }
+            B[0 + 6 * n] = g[0];
+            B[4 + 6 * n] = g[2];
+            B[5 + 6 * n] = g[1];
+            B[1 + 6 * (n + 8)] = g[1];
+            B[3 + 6 * (n + 8)] = g[2];
+            B[5 + 6 * (n + 8)] = g[0];
+            B[2 + 6 * (n + 16)] = g[2];
+            B[3 + 6 * (n + 16)] = g[1];
+            B[4 + 6 * (n + 16)] = g[0];
+         }
+
+         const double wts = 0.125 * detJ * dt;
+         // We follow the same conventions as our EA kernels
+         for (int j = 0; j < 24; j++) {
+            double KB[6];
+            for (int v = 0; v < 6; v++) {
+               double sum = 0.0;
+               for (int w = 0; w < 6; w++) {
+                  sum += KE(v + 6 * w, e) * B[w + 6 * j];
+               }
+               KB[v] = wts * sum;
+            }
+            for (int i = 0; i < 24; i++) {
+               double sum = 0.0;
+               for (int v = 0; v < 6; v++) {
+                  sum += B[v + 6 * i] * KB[v];
+               }
+               A(i, j, s) += sum;
+            }
+         }
+      }
+   });
+}
+
+void MechOperatorLORAMG::Update(const Operator & /*grad*/, const Vector & /*diag*/)
+{
+   CALI_CXX_MARK_SCOPE("lor_amg_update");
+   AssembleSubElements();
+   FillElementCSR(lor_data, csr_offsets, csr_sources, *loc_mat);
+
+   OperatorHandle lor_grad(Operator::Hypre_ParCSR);
+   ParallelAssembleLocal(&fes, loc_mat, lor_grad);
+   OperatorHandle lor_grad_e;
+   lor_grad_e.EliminateRowsCols(lor_grad, ess_tdof_list);
+   // We take over ownership of the matrix so it outlives our handle
+   lor_grad.SetOperatorOwner(false);
+   HypreParMatrix *new_mat = lor_grad.As<HypreParMatrix>();
+   amg->SetOperator(*new_mat);
+   delete lor_mat;
+   lor_mat = new_mat;
+}
+
+void MechOperatorLORAMG::Mult(const Vector &x, Vector &y) const
+{
+   CALI_CXX_MARK_SCOPE("lor_amg_mult");
+   amg->Mult(x, y);
+}
+
+MechOperatorMultigrid::MechOperatorMultigrid(int s, const int _smooth_iters)
+   : MechOperatorPreconditioner(s), smooth_iters(_smooth_iters), coarse_solver(nullptr)
+{
+   // empty
+}
+
+void MechOperatorMultigrid::SetLevelSizes(const Array<int> &tsizes)
+{
+   const int nlevels = tsizes.Size();
+   level_opers.assign(nlevels, nullptr);
+   level_smoothers.assign(nlevels, nullptr);
+   level_ess_tdofs.assign(nlevels, nullptr);
+   level_prolongs.assign(nlevels - 1, nullptr);
+   level_x.resize(nlevels);
+   level_b.resize(nlevels);
+   level_r.resize(nlevels);
+   for (int lev = 0; lev < nlevels; lev++) {
+      level_x[lev].SetSize(tsizes[lev], Device::GetMemoryType());
+      level_b[lev].SetSize(tsizes[lev], Device::GetMemoryType());
+      level_r[lev].SetSize(tsizes[lev], Device::GetMemoryType());
+      level_x[lev].UseDevice(true);
+      level_b[lev].UseDevice(true);
+      level_r[lev].UseDevice(true);
+   }
+}
+
+void MechOperatorMultigrid::Cycle(int lev, const Vector &b, Vector &x) const
+{
+   if (lev == 0) {
+      coarse_solver->Mult(b, x);
+      return;
+   }
+
+   const Operator &oper = *level_opers[lev];
+   Solver &smoother = *level_smoothers[lev];
+   Vector &r = level_r[lev];
+   Vector &coarse_b = level_b[lev - 1];
+   Vector &coarse_x = level_x[lev - 1];
+
+   x = 0.0;
+   for (int i = 0; i < smooth_iters; i++) {
+      smoother.Mult(b, x);
+   }
+
+   oper.Mult(x, r);
+   subtract(b, r, r);
+   level_prolongs[lev - 1]->MultTranspose(r, coarse_b);
+   {
+      // Our coarse operator is the identity on its essential true dofs
+      const Array<int> &ess_tdofs = *level_ess_tdofs[lev - 1];
+      auto I = ess_tdofs.Read();
+      auto B = coarse_b.ReadWrite();
+      MFEM_FORALL(i, ess_tdofs.Size(), B[I[i]] = 0.0; );
+   }
+   Cycle(lev - 1, coarse_b, coarse_x);
+   level_prolongs[lev - 1]->Mult(coarse_x, r);
+   x += r;
+
+   for (int i = 0; i < smooth_iters; i++) {
+      smoother.Mult(b, x);
+   }
+}
+
+void MechOperatorMultigrid::Mult(const Vector &x, Vector &y) const
+{
+   CALI_CXX_MARK_SCOPE("mech_mg_mult");
+   MFEM_VERIFY(level_opers.back(), "Update must be called before our multigrid preconditioner can be applied");
+   Cycle(GetNumLevels() - 1, x, y);
+}
+
+MechOperatorGMG::CoarseLevel::~CoarseLevel()
+{
+   delete smoother;
+   delete mat;
+   delete loc_mat;
+   delete inject;
+   delete prolong;
+   delete fes;
+}
+
+MechOperatorGMG::MechOperatorGMG(ParFiniteElementSpace &_fes,
+                                 ExaModel *_model,
+                                 const ParGridFunction &_x_cur,
+                                 const Array<int> &ess_tdofs,
+                                 const Array<ParMesh*> &coarse_meshes,
+                                 const Array<int> &ess_bdr,
+                                 const Array2D<bool> &_ess_bdr_comps,
+                                 const int _smooth_iters,
+                                 const SmootherType smoother_type,
+                                 const int cheb_order,
+                                 const int cheb_power_iters)
+   : MechOperatorMultigrid(_fes.GetTrueVSize(), _smooth_iters),
+   fes(_fes),
+   model(_model),
+   x_cur(_x_cur),
+   ess_bdr_comps(_ess_bdr_comps),
+   fine_smoother(nullptr),
+   amg(nullptr)
+{
+   CALI_CXX_MARK_SCOPE("gmg_setup");
+   MFEM_VERIFY(coarse_meshes.Size() > 0,
+               "The geometric multigrid preconditioner requires at least one parallel refinement level");
+   const FiniteElement &el = *fes.GetFE(0);
+   MFEM_VERIFY(el.GetGeomType() == Geometry::CUBE,
+               "The geometric multigrid preconditioner requires hexahedral elements");
+   const IntegrationRule *ir = &(IntRules.Get(el.GetGeomType(), 2 * el.GetOrder() + 1));
+
+   nqpts = ir->GetNPoints();
+   nnodes = el.GetDof();
+   const int elem_dofs = 3 * nnodes;
+
+   qpts_dshape.SetSize(nnodes * 3 * nqpts);
+   qpts_wts.SetSize(nqpts);
+   {
+      DenseMatrix DSh;
+      double *qpts_dshape_data = qpts_dshape.HostWrite();
+      double *wts = qpts_wts.HostWrite();
+      for (int i = 0; i < nqpts; i++) {
+         const IntegrationPoint &ip = ir->IntPoint(i);
+         DSh.UseExternalData(&qpts_dshape_data[nnodes * 3 * i], nnodes, 3);
+         el.CalcDShape(ip, DSh);
+         wts[i] = ip.weight;
+      }
+   }
+   qpts_dshape.UseDevice(true);
+   qpts_wts.UseDevice(true);
+
+   fine_tan.SetSize(36 * fes.GetNE(), Device::GetMemoryType());
+   fine_tan.UseDevice(true);
+   {
+      Vector ones(height);
+      ones = 1.0;
+      fine_smoother = NewMGSmoother(fes.GetComm(), ones, ess_tdofs, smoother_type, cheb_order, cheb_power_iters);
+   }
+
+   const int nlevels = coarse_meshes.Size();
+   levels.resize(nlevels);
+   Array<int> c_vdofs, f_vdofs;
+   for (int lev = nlevels - 1; lev >= 0; lev--) {
+      CoarseLevel *level = new CoarseLevel();
+      levels[lev] = level;
+      const ParFiniteElementSpace &fine_fes = (lev == nlevels - 1) ? fes : *levels[lev + 1]->fes;
+      level->fes = new ParFiniteElementSpace(coarse_meshes[lev], fes.FEColl(), fes.GetVDim(), fes.GetOrdering());
+      level->prolong = new TrueTransferOperator(*level->fes, fine_fes);
+      const int NE = level->fes->GetNE();
+
+      // Each of the next finer level's elements knows which of our elements it came from
+      // and where it lives within it.
+      const CoarseFineTransformations &rtrans = fine_fes.GetMesh()->GetRefinementTransforms();
+      const DenseTensor &pmats = rtrans.point_matrices[el.GetGeomType()];
+      DenseTensor loc_restrict(nnodes, nnodes, pmats.SizeK());
+      {
+         IsoparametricTransformation isotr;
+         isotr.SetIdentityTransformation(el.GetGeomType());
+         for (int i = 0; i < pmats.SizeK(); i++) {
+            isotr.SetPointMat(pmats(i));
+            el.GetLocalRestriction(isotr, loc_restrict(i));
+         }
+      }
+
+      level->children.SetSize(8 * NE);
+      Array<int> nchildren(NE);
+      nchildren = 0;
+      level->inject = new SparseMatrix(level->fes->GetVSize(), fine_fes.GetVSize());
+      Array<bool> injected(level->fes->GetVSize());
+      injected = false;
+      for (int fe = 0; fe < fine_fes.GetNE(); fe++) {
+         const Embedding &emb = rtrans.embeddings[fe];
+         MFEM_VERIFY(nchildren[emb.parent] < 8, "The geometric multigrid preconditioner requires uniform refinement");
+         level->children[nchildren[emb.parent]++ + 8 * emb.parent] = fe;
+
+         // Our nodes are the nodes of the fine elements they lie within, so only
+         // the first fine element containing each node needs to contribute.
+         level->fes->GetElementVDofs(emb.parent, c_vdofs);
+         fine_fes.GetElementVDofs(fe, f_vdofs);
+         const DenseMatrix &lr = loc_restrict(emb.matrix);
+         for (int i = 0; i < elem_dofs; i++) {
+            const int n = i % nnodes;
+            const int d = i / nnodes;
+            if (injected[c_vdofs[i]] || !std::isfinite(lr(n, 0))) { continue; }
+            injected[c_vdofs[i]] = true;
+            for (int j = 0; j < nnodes; j++) {
+               if (lr(n, j) != 0.0) {
+                  level->inject->Set(c_vdofs[i], f_vdofs[j + nnodes * d], lr(n, j));
+               }
+            }
+         }
+      }
+      level->inject->Finalize();
+
+      Array<int> elem_vdofs(NE * elem_dofs);
+      for (int e = 0; e < NE; e++) {
+         level->fes->GetElementVDofs(e, c_vdofs);
+         for (int i = 0; i < elem_dofs; i++) {
+            elem_vdofs[i + e * elem_dofs] = c_vdofs[i];
+         }
+      }
+      level->loc_mat = SetupElementCSRGather(elem_vdofs, elem_dofs, level->fes->GetVSize(),
+                                             level->csr_offsets, level->csr_sources);
+
+      const int tsize = level->fes->GetTrueVSize();
+      level->crds.SetSize(level->fes->GetVSize(), Device::GetMemoryType());
+      level->el_crds.SetSize(NE * elem_dofs, Device::GetMemoryType());
+      level->elem_tan.SetSize(36 * NE, Device::GetMemoryType());
+      level->ea_data.SetSize(NE * elem_dofs * elem_dofs, Device::GetMemoryType());
+      level->diag.SetSize(tsize, Device::GetMemoryType());
+      level->crds.UseDevice(true);
+      level->el_crds.UseDevice(true);
+      level->elem_tan.UseDevice(true);
+      level->ea_data.UseDevice(true);
+      level->diag.UseDevice(true);
+      level->diag = 1.0;
+
+      // Our coarsest level is solved with AMG rather than smoothed
+      if (lev > 0) {
+         level->smoother = NewMGSmoother(fes.GetComm(), level->diag, level->ess_tdofs, smoother_type,
+                                         cheb_order, cheb_power_iters);
+      }
+   }
+
+   UpdateEssTDofs(ess_bdr);
+
+   amg = new HypreBoomerAMG();
+   amg->SetPrintLevel(0);
+   amg->SetSystemsOptions(3, fes.GetOrdering() == Ordering::byNODES);
+   amg->iterative_mode = false;
+
+   Array<int> tsizes(nlevels + 1);
+   for (int lev = 0; lev < nlevels; lev++) {
+      tsizes[lev] = levels[lev]->fes->GetTrueVSize();
+   }
+   tsizes[nlevels] = height;
+   SetLevelSizes(tsizes);
+   for (int lev = 0; lev < nlevels; lev++) {
+      level_smoothers[lev] = levels[lev]->smoother;
+      level_ess_tdofs[lev] = &levels[lev]->ess_tdofs;
+      level_prolongs[lev] = levels[lev]->prolong;
+   }
+   level_smoothers[nlevels] = fine_smoother;
+   level_ess_tdofs[nlevels] = &ess_tdofs;
+   coarse_solver = amg;
+}
+
+MechOperatorGMG::~MechOperatorGMG()
+{
+   delete amg;
+   delete fine_smoother;
+   for (auto level : levels) {
+      delete level;
+   }
+}
+
+void MechOperatorGMG::UpdateEssTDofs(const Array<int> &ess_bdr)
+{
+   for (auto level : levels) {
+      level->fes->GetEssentialTrueDofs(ess_bdr, level->ess_tdofs, ess_bdr_comps);
+   }
+}
+
+void MechOperatorGMG::AssembleLevel(int lev, const Vector &fine_crds, const Vector &fine_elem_tan)
+{
+   CALI_CXX_MARK_SCOPE("gmg_assemble_level");
+   CoarseLevel &level = *levels[lev];
+   const int NE = level.fes->GetNE();
+   const int nnodes_ = nnodes;
+   const int nqpts_ = nqpts;
+   const int elem_dofs = 3 * nnodes;
+
+   // Each element makes use of the average material tangent of its children
+   {
+      auto CH = Reshape(level.children.Read(), 8, NE);
+      auto KF = fine_elem_tan.Read();
+      auto KC = Reshape(level.elem_tan.Write(), 36, NE);
+      MFEM_FORALL(i_elems, NE, {
+         for (int k = 0; k < 36; k++) {
+            double sum = 0.0;
+            for (int c = 0; c < 8; c++) {
+               sum += KF[k + 36 * CH(c, i_elems)];
+            }
+            KC(k, i_elems) = 0.125 * sum;
+         }
+      });
+   }
+
+   level.inject->Mult(fine_crds, level.crds);
+   level.fes->GetElementRestriction(ElementDofOrdering::NATIVE)->Mult(level.crds, level.el_crds);
+
+   const double dt = model->GetModelDt();
+   auto X = Reshape(level.el_crds.Read(), nnodes, 3, NE);
+   auto G = Reshape(qpts_dshape.Read(), nnodes, 3, nqpts);
+   auto W = qpts_wts.Read();
+   auto KE = Reshape(level.elem_tan.Read(), 36, NE);
+   auto A = Reshape(level.ea_data.Write(), elem_dofs, elem_dofs, NE);
+   MFEM_FORALL(i_elems, NE, {
+      for (int j = 0; j < 3 * nnodes_; j++) {
+         for (int i = 0; i < 3 * nnodes_; i++) {
+            A(i, j, i_elems) = 0.0;
+         }
+      }
+
+      for (int j_qpts = 0; j_qpts < nqpts_; j_qpts++) {
+         // J[l + 3k] = dx_l / dxi_k
+         double J[9];
+         for (int k = 0; k < 3; k++) {
+            for (int l = 0; l < 3; l++) {
+               double sum = 0.0;
+               for (int n = 0; n < nnodes_; n++) {
+                  sum += X(n, l, i_elems) * G(n, k, j_qpts);
+               }
+               J[l + 3 * k] = sum;
+            }
+         }
+         const double detJ = J[0] * (J[4] * J[8] - J[5] * J[7]) -
+                             /* */ J[3] * (J[1] * J[8] - J[2] * J[7]) +
+                             /* */ J[6] * (J[1] * J[5] - J[2] * J[4]);
+         const double idetJ = 1.0 / detJ;
+         // Jinv[k + 3l] = dxi_k / dx_l
+         double Jinv[9];
+         Jinv[0] = idetJ * (J[4] * J[8] - J[5] * J[7]);
+         Jinv[1] = idetJ * (J[2] * J[7] - J[1] * J[8]);
+         Jinv[2] = idetJ * (J[1] * J[5] - J[2] * J[4]);
+         Jinv[3] = idetJ * (J[5] * J[6] - J[3] * J[8]);
+         Jinv[4] = idetJ * (J[0] * J[8] - J[2] * J[6]);
+         Jinv[5] = idetJ * (J[2] * J[3] - J[0] * J[5]);
+         Jinv[6] = idetJ * (J[3] * J[7] - J[4] * J[6]);
+         Jinv[7] = idetJ * (J[1] * J[6] - J[0] * J[7]);
+         Jinv[8] = idetJ * (J[0] * J[4] - J[1] * J[3]);
+
+         const double wts = W[j_qpts] * detJ * dt;
+         // We follow the same conventions as our EA kernels where the Voigt ordering is
+         // 11, 22, 33, 23, 13, 12 with engineering shear strains and dof n + nnodes * a
+         // is node n and component a.
+         for (int jn = 0; jn < nnodes_; jn++) {
+            double gj[3];
+            for (int l = 0; l < 3; l++) {
+               gj[l] = G(jn, 0, j_qpts) * Jinv[3 * l] + G(jn, 1, j_qpts) * Jinv[1 + 3 * l]
+                       + G(jn, 2, j_qpts) * Jinv[2 + 3 * l];
+            }
+            for (int b = 0; b < 3; b++) {
+               double Bj[6] = { 0.0, 0.0, 0.0, 0.0, 0.0, 0.0 };
+               if (b == 0) { Bj[0] = gj[0]; Bj[4] = gj[2]; Bj[5] = gj[1]; }
+               else if (b == 1) { Bj[1] = gj[1]; Bj[3] = gj[2]; Bj[5] = gj[0]; }
+               else { Bj[2] = gj[2]; Bj[3] = gj[1]; Bj[4] = gj[0]; }
+               double KB[6];
+               for (int v = 0; v < 6; v++) {
+                  double sum = 0.0;
+                  for (int w = 0; w < 6; w++) {
+                     sum += KE(v + 6 * w, i_elems) * Bj[w];
+                  }
+                  KB[v] = wts * sum;
+               }
+               for (int in = 0; in < nnodes_; in++) {
+                  double gi[3];
+                  for (int l = 0; l < 3; l++) {
+                     gi[l] = G(in, 0, j_qpts) * Jinv[3 * l] + G(in, 1, j_qpts) * Jinv[1 + 3 * l]
+                             + G(in, 2, j_qpts) * Jinv[2 + 3 * l];
+                  }
+                  A(in, jn + nnodes_ * b, i_elems) += gi[0] * KB[0] + gi[2] * KB[4] + gi[1] * KB[5];
+                  A(in + nnodes_, jn + nnodes_ * b, i_elems) += gi[1] * KB[1] + gi[2] * KB[3] + gi[0] * KB[5];
+                  A(in + 2 * nnodes_, jn + nnodes_ * b, i_elems) += gi[2] * KB[2] + gi[1] * KB[3] + gi[0] * KB[4];
+               }
+            }
+         }
+      }
+   });
+
+   FillElementCSR(level.ea_data, level.csr_offsets, level.csr_sources, *level.loc_mat);
+   OperatorHandle grad(Operator::Hypre_ParCSR);
+   ParallelAssembleLocal(level.fes, level.loc_mat, grad);
+   OperatorHandle grad_e;
+   grad_e.EliminateRowsCols(grad, level.ess_tdofs);
+   // We take over ownership of the matrix so it outlives our handle
+   grad.SetOperatorOwner(false);
+   HypreParMatrix *new_mat = grad.As<HypreParMatrix>();
+   if (lev == 0) {
+      amg->SetOperator(*new_mat);
+   }
+   else {
+      new_mat->GetDiag(level.diag);
+      level.smoother->SetOperator(*new_mat);
+      level.smoother->Setup(level.diag);
+   }
+   delete level.mat;
+   level.mat = new_mat;
+   level_opers[lev] = new_mat;
+}
+
+void MechOperatorGMG::Update(const Operator &grad, const Vector &diag)
+{
+   CALI_CXX_MARK_SCOPE("gmg_update");
+   level_opers.back() = &grad;
+   fine_smoother->SetOperator(grad);
+   fine_smoother->Setup(diag);
+
+   ElementAverageTangent(model, nqpts, fes.GetNE(), fine_tan);
+   const int nlevels = (int) levels.size();
+   for (int lev = nlevels - 1; lev >= 0; lev--) {
+      if (lev == nlevels - 1) {
+         AssembleLevel(lev, x_cur, fine_tan);
+      }
+      else {
+         AssembleLevel(lev, levels[lev + 1]->crds, levels[lev + 1]->elem_tan);
+      }
+   }
+}
+
+MechOperatorPMG::MechOperatorPMG(ParFiniteElementSpace &_fes,
+                                 ExaModel *model,
+                                 Vector &el_jac,
+                                 const Array<int> &ess_tdofs,
+                                 const Array<int> &ess_bdr,
+                                 const Array2D<bool> &_ess_bdr_comps,
+                                 const AssemblyLevel assembly,
+                                 const int _smooth_iters,
+                                 const SmootherType smoother_type,
+                                 const int cheb_order,
+                                 const int cheb_power_iters)
+   : MechOperatorMultigrid(_fes.GetTrueVSize(), _smooth_iters),
+   fes(_fes),
+   ess_bdr_comps(_ess_bdr_comps),
+   coarse_assembler(nullptr),
+   amg(nullptr)
+{
+   CALI_CXX_MARK_SCOPE("pmg_setup");
+   const FiniteElement &el = *fes.GetFE(0);
+   const int order = el.GetOrder();
+   MFEM_VERIFY(order > 1, "The p-multigrid preconditioner requires p_refinement > 1");
+   // Our lower order levels are evaluated at the quadrature points of our fine level
+   const IntegrationRule *ir = &(IntRules.Get(el.GetGeomType(), 2 * order + 1));
+
+   const int nlevels = order;
+   Array<int> tsizes(nlevels);
+   for (int lev = 0; lev < nlevels - 1; lev++) {
+      fecs.push_back(new H1_FECollection(lev + 1, fes.GetMesh()->Dimension()));
+      spaces.push_back(new ParFiniteElementSpace(fes.GetParMesh(), fecs[lev], fes.GetVDim(), fes.GetOrdering()));
+
+      ExaNLFIntegrator *integ = new ExaNLFIntegrator(model);
+      integ->SetIntRule(ir);
+      integ->SetSharedJacobian(el_jac);
+      // The form owns the integrator
+      ParNonlinearForm *form = new ParNonlinearForm(spaces[lev]);
+      form->AddDomainIntegrator(integ);
+      // Our first order level is assembled by coarse_assembler instead
+      if (lev > 0) {
+         form->SetAssemblyLevel(assembly, ElementDofOrdering::NATIVE);
+      }
+      forms.push_back(form);
+      tsizes[lev] = spaces[lev]->GetTrueVSize();
+   }
+   tsizes[nlevels - 1] = height;
+   SetLevelSizes(tsizes);
+   UpdateEssTDofs(ess_bdr);
+
+   for (int lev = 0; lev < nlevels - 1; lev++) {
+      const ParFiniteElementSpace &fine_space = (lev == nlevels - 2) ? fes : *spaces[lev + 1];
+      prolongs.push_back(new TrueTransferOperator(*spaces[lev], fine_space));
+      level_prolongs[lev] = prolongs[lev];
+      level_ess_tdofs[lev] = &forms[lev]->GetEssentialTrueDofs();
+   }
+   level_ess_tdofs[nlevels - 1] = &ess_tdofs;
+
+   smoothers.assign(nlevels, nullptr);
+   diags.resize(nlevels);
+   for (int lev = 1; lev < nlevels; lev++) {
+      diags[lev].SetSize(tsizes[lev], Device::GetMemoryType());
+      diags[lev].UseDevice(true);
+      diags[lev] = 1.0;
+      smoothers[lev] = NewMGSmoother(fes.GetComm(), diags[lev], *level_ess_tdofs[lev], smoother_type,
+                                     cheb_order, cheb_power_iters);
+      level_smoothers[lev] = smoothers[lev];
+   }
+
+   coarse_assembler = new FullMechOperatorGradAssembler(forms[0]);
+   amg = new HypreBoomerAMG();
+   amg->SetPrintLevel(0);
+   amg->SetSystemsOptions(3, fes.GetOrdering() == Ordering::byNODES);
+   amg->iterative_mode = false;
+   coarse_solver = amg;
+}
+
+MechOperatorPMG::~MechOperatorPMG()
+{
+   delete amg;
+   delete coarse_assembler;
+   for (auto smoother : smoothers) {
+      delete smoother;
+   }
+   for (auto prolong : prolongs) {
+      delete prolong;
+   }
+   for (auto form : forms) {
+      delete form;
+   }
+   for (auto space : spaces) {
+      delete space;
+   }
+   for (auto fec : fecs) {
+      delete fec;
+   }
+}
+
+void MechOperatorPMG::UpdateEssTDofs(const Array<int> &ess_bdr)
+{
+   for (auto form : forms) {
+      form->SetEssentialBC(ess_bdr, ess_bdr_comps, nullptr);
+   }
+}
+
+void MechOperatorPMG::Update(const Operator &grad, const Vector &diag)
+{
+   CALI_CXX_MARK_SCOPE("pmg_update");
+   const int nlevels = GetNumLevels();
+   level_opers[nlevels - 1] = &grad;
+   smoothers[nlevels - 1]->SetOperator(grad);
+   smoothers[nlevels - 1]->Setup(diag);
+
+   for (int lev = nlevels - 2; lev > 0; lev--) {
+      // Our gradient operator doesn't depend on the state it's evaluated at
+      level_x[lev] = 0.0;
+      Operator &level_grad = forms[lev]->GetGradient(level_x[lev]);
+      level_grad.AssembleDiagonal(diags[lev]);
+      smoothers[lev]->SetOperator(level_grad);
+      smoothers[lev]->Setup(diags[lev]);
+      level_opers[lev] = &level_grad;
+   }
+
+   coarse_assembler->Assemble();
+   HypreParMatrix &coarse_mat = coarse_assembler->EliminateBC(forms[0]->GetEssentialTrueDofs());
+   amg->SetOperator(coarse_mat);
+   level_opers[0] = &coarse_mat;
+}
+
+MechOperatorBlockJacobi::MechOperatorBlockJacobi(NonlinearForm *_oper_mech,
+                                                 const Array<int> &ess_tdofs)
+   : MechOperatorPreconditioner(_oper_mech->FESpace()->GetTrueVSize()),
+   oper_mech(_oper_mech),
+   ess_tdof_list(ess_tdofs)
+{
+   const FiniteElementSpace *fes = oper_mech->FESpace();
+   MFEM_VERIFY(fes->GetVDim() == 3, "The block-Jacobi preconditioner requires 3 displacement components");
+   // So, we're going to originally support non tensor-product type elements originally.
+   const ElementDofOrdering ordering = ElementDofOrdering::NATIVE;
+   elem_restrict_lex = fes->GetElementRestriction(ordering);
+   P = fes->GetProlongationMatrix();
+   ntnodes = height / 3;
+   by_nodes = (fes->GetOrdering() == Ordering::byNODES);
+
+   blk_e.SetSize(3 * elem_restrict_lex->Height(), Device::GetMemoryType());
+   blk_l.SetSize(3 * elem_restrict_lex->Width(), Device::GetMemoryType());
+   blk_t.SetSize(3 * height, Device::GetMemoryType());
+   blk_inv.SetSize(9 * ntnodes, Device::GetMemoryType());
+   ess_mark.SetSize(height, Device::GetMemoryType());
+   blk_e.UseDevice(true);
+   blk_l.UseDevice(true);
+   blk_t.UseDevice(true);
+   blk_inv.UseDevice(true);
+   ess_mark.UseDevice(true);
+}
+
+void MechOperatorBlockJacobi::Update(const Operator & /*grad*/, const Vector & /*diag*/)
+{
+   CALI_CXX_MARK_SCOPE("block_jacobi_update");
+   blk_e = 0.0;
+   Array<NonlinearFormIntegrator*> &integrators = *oper_mech->GetDNFI();
+   const int num_int = integrators.Size();
+   for (int i = 0; i < num_int; ++i) {
+      ExaNLFIntegrator *integ = dynamic_cast<ExaNLFIntegrator*>(integrators[i]);
+      MFEM_VERIFY(integ, "The block-Jacobi preconditioner requires ExaNLFIntegrators");
+      integ->AssembleGradBlockDiagonalPA(blk_e);
+   }
+
+   // Each column of our nodal blocks is gathered to the true dofs independently of the others.
+   // A true node's components all live on the same rank, so this gives us the full block.
+   const int esize = elem_restrict_lex->Height();
+   const int lsize = elem_restrict_lex->Width();
+   const int tsize = height;
+   for (int b = 0; b < 3; b++) {
+      Vector col_e(blk_e, b * esize, esize);
+      Vector col_l(blk_l, b * lsize, lsize);
+      Vector col_t(blk_t, b * tsize, tsize);
+      elem_restrict_lex->MultTranspose(col_e, col_l);
+      P->MultTranspose(col_l, col_t);
+   }
+
+   ess_mark = 0.0;
+   {
+      auto I = ess_tdof_list.Read();
+      auto M = ess_mark.ReadWrite();
+      MFEM_FORALL(i, ess_tdof_list.Size(), M[I[i]] = 1.0; );
+   }
+
+   const int ntnodes_ = ntnodes;
+   const bool by_nodes_ = by_nodes;
+   auto T = blk_t.Read();
+   auto E = ess_mark.Read();
+   auto BI = blk_inv.Write();
+   MFEM_FORALL(n, ntnodes_, {
+      int idx[3];
+      for (int a = 0; a < 3; a++) {
+         idx[a] = by_nodes_ ? n + a * ntnodes_ : a + 3 * n;
+      }
+      // Our operator is the identity on the essential true dofs
+      double m[9];
+      for (int b = 0; b < 3; b++) {
+         for (int a = 0; a < 3; a++) {
+            if ((E[idx[a]] > 0.0) || (E[idx[b]] > 0.0)) {
+               m[a + 3 * b] = (a == b) ? 1.0 : 0.0;
+            }
+            else {
+               m[a + 3 * b] = T[idx[a] + tsize * b];
+            }
+         }
+      }
+      const double det = m[0] * (m[4] * m[8] - m[7] * m[5])
+                         - m[3] * (m[1] * m[8] - m[7] * m[2])
+                         + m[6] * (m[1] * m[5] - m[4] * m[2]);
+      const double idet = 1.0 / det;
+      double *bi = &BI[9 * n];
+      bi[0] = idet * (m[4] * m[8] - m[7] * m[5]);
+      bi[1] = idet * (m[7] * m[2] - m[1] * m[8]);
+      bi[2] = idet * (m[1] * m[5] - m[4] * m[2]);
+      bi[3] = idet * (m[6] * m[5] - m[3] * m[8]);
+      bi[4] = idet * (m[0] * m[8] - m[6] * m[2]);
+      bi[5] = idet * (m[3] * m[2] - m[0] * m[5]);
+      bi[6] = idet * (m[3] * m[7] - m[6] * m[4]);
+      bi[7] = idet * (m[6] * m[1] - m[0] * m[7]);
+      bi[8] = idet * (m[0] * m[4] - m[3] * m[1]);
+   });
+}
+
+void MechOperatorBlockJacobi::Mult(const Vector &x, Vector &y) const
+{
+   CALI_CXX_MARK_SCOPE("block_jacobi_mult");
+   const int ntnodes_ = ntnodes;
+   const bool by_nodes_ = by_nodes;
+   auto BI = blk_inv.Read();
+   auto X = x.Read();
+   auto Y = y.Write();
+   MFEM_FORALL(n, ntnodes_, {
+      int idx[3];
+      for (int a = 0; a < 3; a++) {
+         idx[a] = by_nodes_ ? n + a * ntnodes_ : a + 3 * n;
+      }
+      const double *bi = &BI[9 * n];
+      const double x0 = X[idx[0]];
+      const double x1 = X[idx[1]];
+      const double x2 = X[idx[2]];
+      for (int a = 0; a < 3; a++) {
+         Y[idx[a]] = bi[a] * x0 + bi[a + 3] * x1 + bi[a + 6] * x2;
+      }
+   });
+}
+
+MechOperatorElementSchwarz::MechOperatorElementSchwarz(NonlinearForm *_oper_mech,
+                                                       const Array<int> &ess_tdofs)
+   : MechOperatorPreconditioner(_oper_mech->FESpace()->GetTrueVSize()),
+   oper_mech(_oper_mech),
+   ess_tdof_list(ess_tdofs)
+{
+   const FiniteElementSpace *fes = oper_mech->FESpace();
+   // So, we're going to originally support non tensor-product type elements originally.
+   const ElementDofOrdering ordering = ElementDofOrdering::NATIVE;
+   elem_restrict_lex = fes->GetElementRestriction(ordering);
+   P = fes->GetProlongationMatrix();
+   NE = fes->GetNE();
+   elemDofs = fes->GetFE(0)->GetDof() * fes->GetVDim();
+
+   ea_inv.SetSize(NE * elemDofs * elemDofs, Device::GetMemoryType());
+   ess_mark.SetSize(height, Device::GetMemoryType());
+   diag_e.SetSize(elem_restrict_lex->Height(), Device::GetMemoryType());
+   ess_e.SetSize(elem_restrict_lex->Height(), Device::GetMemoryType());
+   localX.SetSize(elem_restrict_lex->Height(), Device::GetMemoryType());
+   localY.SetSize(elem_restrict_lex->Height(), Device::GetMemoryType());
+   px.SetSize(elem_restrict_lex->Width(), Device::GetMemoryType());
+   ea_inv.UseDevice(true);
+   ess_mark.UseDevice(true);
+   diag_e.UseDevice(true);
+   ess_e.UseDevice(true);
+   localX.UseDevice(true);
+   localY.UseDevice(true);
+   px.UseDevice(true);
+}
+
+void MechOperatorElementSchwarz::Update(const Operator & /*grad*/, const Vector &diag)
+{
+   CALI_CXX_MARK_SCOPE("elem_schwarz_update");
+   const FiniteElementSpace *fes = oper_mech->FESpace();
+   ea_inv = 0.0;
+   Array<NonlinearFormIntegrator*> &integrators = *oper_mech->GetDNFI();
+   const int num_int = integrators.Size();
+   for (int i = 0; i < num_int; ++i) {
+      integrators[i]->AssemblePA(*fes);
+      integrators[i]->AssembleEA(*fes, ea_inv);
+   }
+
+   P->Mult(diag, px);
+   elem_restrict_lex->Mult(px, diag_e);
+
+   ess_mark = 0.0;
+   {
+      auto I = ess_tdof_list.Read();
+      auto M = ess_mark.ReadWrite();
+      MFEM_FORALL(i, ess_tdof_list.Size(), M[I[i]] = 1.0; );
+   }
+   P->Mult(ess_mark, px);
+   elem_restrict_lex->Mult(px, ess_e);
+
+   // The element matrices are small and dense, so they're just inverted on the host.
+   // Our EA data is stored as the transpose of each element matrix, and the inverse of
+   // that is then the transpose of the inverse that we want, which is what Mult expects.
+   const int ndofs = elemDofs;
+   const double *D = diag_e.HostRead();
+   const double *EM = ess_e.HostRead();
+   double *A = ea_inv.HostReadWrite();
+   DenseMatrix elmat, elinv(ndofs);
+   for (int e = 0; e < NE; e++) {
+      elmat.UseExternalData(&A[e * ndofs * ndofs], ndofs, ndofs);
+      for (int i = 0; i < ndofs; i++) {
+         elmat(i, i) = D[i + ndofs * e];
+      }
+      for (int i = 0; i < ndofs; i++) {
+         if (EM[i + ndofs * e] > 0.0) {
+            for (int j = 0; j < ndofs; j++) {
+               elmat(i, j) = 0.0;
+               elmat(j, i) = 0.0;
+            }
+            elmat(i, i) = 1.0;
+         }
+      }
+      DenseMatrixInverse elmat_inv(elmat);
+      elmat_inv.GetInverseMatrix(elinv);
+      std::copy(elinv.Data(), elinv.Data() + ndofs * ndofs, &A[e * ndofs * ndofs]);
+   }
+}
+
+void MechOperatorElementSchwarz::Mult(const Vector &x, Vector &y) const
+{
+   CALI_CXX_MARK_SCOPE("elem_schwarz_mult");
+   P->Mult(x, px);
+   elem_restrict_lex->Mult(px, localX);
+
+   const int NDOFS = elemDofs;
+   auto X = Reshape(localX.Read(), NDOFS, NE);
+   auto Y = Reshape(localY.Write(), NDOFS, NE);
+   auto A = Reshape(ea_inv.Read(), NDOFS, NDOFS, NE);
+   const int elemDofs_ = elemDofs;
+   MFEM_FORALL(glob_j, NE * NDOFS,
+   {
+      const int NDOFS = elemDofs_;
+      const int e = glob_j / NDOFS;
+      const int j = glob_j % NDOFS;
+      double res = 0.0;
+      for (int i = 0; i < NDOFS; i++) {
+         res += A(i, j, e) * X(i, e);
+      }
+      Y(j, e) = res;
+   });
+
+   elem_restrict_lex->MultTranspose(localY, px);
+   P->MultTranspose(px, y);
+
+   // Our operator is the identity on the essential true dofs
+   auto I = ess_tdof_list.Read();
+   auto XT = x.Read();
+   auto YT = y.ReadWrite();
+   MFEM_FORALL(i, ess_tdof_list.Size(), YT[I[i]] = XT[I[i]]; );
+}
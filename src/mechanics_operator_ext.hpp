@@ -3,6 +3,9 @@
 
 #include "mfem.hpp"
 #include "mechanics_integrators.hpp"
+#include "option_types.hpp"
+
+#include <vector>
 
 // The NonlinearMechOperatorExt class contains all of the relevant info related to our
 // partial assembly class.
@@ -36,17 +39,38 @@ class PANonlinearMechOperatorGradExt : public NonlinearMechOperatorExt
       const mfem::Operator *elem_restrict_lex; // Not owned
       const mfem::Operator *P;
       const mfem::Array<int> &ess_tdof_list;
+      // Used to overlap the halo exchange of P->Mult with the work of the elements that
+      // only touch dofs we own. gc is nullptr whenever this overlap isn't possible.
+      const mfem::GroupCommunicator *gc; // Not owned
+      mfem::Array<int> external_ldofs;
+      mfem::Array<int> interior_elems, boundary_elems;
+      bool use_overlap;
+
+      void SetupHaloOverlap();
+      /// Takes the E-vector diagonal in localY (or diag itself when we have no element
+      /// restriction) to our true dofs and applies our essential boundary conditions to it.
+      void FinalizeDiagonal(mfem::Vector &diag);
    public:
       PANonlinearMechOperatorGradExt(mfem::NonlinearForm *_mech_operator,
                                      const mfem::Array<int> &ess_tdofs);
 
       virtual void Assemble();
       virtual void AssembleDiagonal(mfem::Vector &diag);
+      /// Assembles the PA data of our gradient operator. If diag is provided, the diagonal
+      /// of our gradient is formed in the same pass over the quadrature points, which saves
+      /// the separate sweep over our material tangent of AssembleDiagonal.
+      void AssembleGradient(mfem::Vector *diag);
       template<bool local_action>
       void TMult(const mfem::Vector &x, mfem::Vector &y) const;
       virtual void Mult(const mfem::Vector &x, mfem::Vector &y) const;
       virtual void LocalMult(const mfem::Vector &x, mfem::Vector &y) const;
       virtual void MultVec(const mfem::Vector &x, mfem::Vector &y) const;
+
+      /// Turns the overlap of our halo exchange with the work of our interior elements
+      /// on or off. It's on by default wherever it's possible.
+      void SetHaloOverlap(const bool overlap) { use_overlap = overlap; }
+      /// Whether our mat-vec overlaps its halo exchange with our interior elements
+      bool OverlapHalo() const;
 };
 
 // We'll pass this on through the GetGradient method which can be used
@@ -57,6 +81,10 @@ class EANonlinearMechOperatorGradExt : public PANonlinearMechOperatorGradExt
       int NE;
       int elemDofs;
       mfem::Vector ea_data;
+      // Upper triangle of each element matrix stored column by column. This is used
+      // instead of ea_data whenever all of our element matrices are symmetric.
+      mfem::Vector ea_packed;
+      bool ea_sym;
       int nf_int, nf_bdr;
       int faceDofs;
    public:
@@ -74,6 +102,331 @@ class EANonlinearMechOperatorGradExt : public PANonlinearMechOperatorGradExt
 
       using PANonlinearMechOperatorGradExt::MultVec;
       // void MultVec(const mfem::Vector &x, mfem::Vector &y) const;
+
+      /// Whether our element matrices are stored in their packed upper triangular form
+      bool PackedStorage() const { return ea_sym; }
+};
+
+/// Builds the globally assembled gradient matrix used with Assembly::FULL from the
+/// element matrices of our EA kernels rather than the element by element
+/// AssembleElementGrad path. The sparsity pattern of the local matrix and the map
+/// from element matrix entries to its CSR entries only depend on the mesh
+/// connectivity, so they're formed once. Each reassembly is then just the EA
+/// kernels followed by a threaded gather of the element contributions into each
+/// CSR entry and the parallel P^T A P product.
+class FullMechOperatorGradAssembler
+{
+   protected:
+      mfem::ParNonlinearForm *oper_mech; // Not owned
+      int NE;
+      int elemDofs;
+      mfem::Vector ea_data;
+      // Local (L-vector sized) matrix whose data we refill on each assembly
+      mfem::SparseMatrix *loc_mat;
+      // For CSR entry i of loc_mat the ea_data entries that sum into it are
+      // csr_sources[csr_offsets[i]] ... csr_sources[csr_offsets[i + 1] - 1]
+      mfem::Array<int> csr_offsets, csr_sources;
+      mfem::OperatorHandle pGrad;
+
+      void SetupSparsity();
+   public:
+      FullMechOperatorGradAssembler(mfem::ParNonlinearForm *_mech_operator);
+      ~FullMechOperatorGradAssembler();
+
+      /// Assembles the global gradient matrix without any essential BCs applied
+      mfem::HypreParMatrix &Assemble();
+      /// Eliminates the essential true dofs from our last assembled gradient matrix
+      /// by setting their rows and columns to those of the identity.
+      mfem::HypreParMatrix &EliminateBC(const mfem::Array<int> &ess_tdofs);
+};
+
+/// Base class of our smoothers that only need the action and the assembled diagonal
+/// of an operator, which lets them be used with our matrix-free gradient operators.
+class MechOperatorSmoother : public mfem::Solver
+{
+   public:
+      MechOperatorSmoother(int s) : mfem::Solver(s) {}
+      virtual ~MechOperatorSmoother() {}
+
+      /// Called whenever our operator or its assembled diagonal diag have changed
+      virtual void Setup(const mfem::Vector &diag) = 0;
+};
+
+/// Base class for the preconditioners of our matrix-free gradient operators that
+/// need to be refreshed whenever the material tangent or geometry change.
+class MechOperatorPreconditioner : public mfem::Solver
+{
+   public:
+      MechOperatorPreconditioner(int s) : mfem::Solver(s) {}
+      virtual ~MechOperatorPreconditioner() {}
+
+      /// Called by the NonlinearMechOperator each time it forms a new gradient
+      /// operator grad. diag is the assembled diagonal of that operator.
+      virtual void Update(const mfem::Operator &grad, const mfem::Vector &diag) = 0;
+
+      /// Called whenever the essential boundary attributes of our problem change.
+      /// Our gradient operator's own essential true dofs are always kept up to date
+      /// by the NonlinearMechOperator, so only preconditioners that make use of other
+      /// spaces need to do anything here.
+      virtual void UpdateEssTDofs(const mfem::Array<int> & /*ess_bdr*/) {}
+
+      /// Whether Update makes use of diag. If not, the NonlinearMechOperator skips
+      /// assembling it altogether.
+      virtual bool NeedsDiagonal() const { return true; }
+
+      /// The gradient operator is matrix-free so we don't make any use of it
+      virtual void SetOperator(const mfem::Operator & /*op*/) {}
+};
+
+/// AMG preconditioner applied to a low-order-refined (LOR) approximation of our
+/// gradient operator. Each tensor-product hexahedral element of order p is split
+/// into p^3 trilinear sub-elements whose vertices are the element's Gauss-Lobatto
+/// nodes. The sub-element stiffness matrices make use of the element averaged
+/// material tangent, and they're assembled straight onto the dofs of the
+/// high-order space so no separate LOR mesh or space is needed. The resulting
+/// sparse matrix is then handed off to BoomerAMG.
+class MechOperatorLORAMG : public MechOperatorPreconditioner
+{
+   protected:
+      mfem::ParFiniteElementSpace &fes;
+      ExaModel *model; // Not owned
+      const mfem::ParGridFunction &x_cur;
+      const mfem::Array<int> &ess_tdof_list;
+      const mfem::Operator *elem_restrict_lex; // Not owned
+      int NE, nsub_elem, nnodes, nqpts;
+      // For each sub-element the element local index of its 8 vertices
+      mfem::Array<int> sub_nodes;
+      mfem::Array<int> csr_offsets, csr_sources;
+      mfem::Vector lor_data, elem_tan, el_crds;
+      mfem::SparseMatrix *loc_mat;
+      mfem::HypreParMatrix *lor_mat;
+      mfem::HypreBoomerAMG *amg;
+
+      /// Forms the element averaged material tangents and the sub-element matrices
+      void AssembleSubElements();
+   public:
+      MechOperatorLORAMG(mfem::ParFiniteElementSpace &fes,
+                         ExaModel *model,
+                         const mfem::ParGridFunction &x_cur,
+                         const mfem::Array<int> &ess_tdofs);
+      virtual ~MechOperatorLORAMG();
+
+      virtual void Update(const mfem::Operator &grad, const mfem::Vector &diag);
+      virtual bool NeedsDiagonal() const { return false; }
+
+      virtual void Mult(const mfem::Vector &x, mfem::Vector &y) const;
+
+      /// Our LOR matrix with the essential BCs applied from the last Update call
+      const mfem::HypreParMatrix *GetLORMatrix() const { return lor_mat; }
+};
+
+/// Base class of our multigrid V-cycle preconditioners. Level 0 is our coarsest level,
+/// which is solved by coarse_solver, and the last level is that of our gradient operator.
+/// Derived classes provide the operator, smoother, and essential true dofs of each level
+/// along with the prolongations between them, none of which are owned by us.
+class MechOperatorMultigrid : public MechOperatorPreconditioner
+{
+   protected:
+      const int smooth_iters;
+      std::vector<const mfem::Operator*> level_opers;
+      std::vector<mfem::Solver*> level_smoothers;
+      std::vector<const mfem::Array<int>*> level_ess_tdofs;
+      /// Prolongation of the true dofs of level i to those of level i + 1
+      std::vector<const mfem::Operator*> level_prolongs;
+      mfem::Solver *coarse_solver;
+      mutable std::vector<mfem::Vector> level_x, level_b, level_r;
+
+      /// Sizes all of our level data given the number of true dofs on each level
+      void SetLevelSizes(const mfem::Array<int> &tsizes);
+      /// Applies one V-cycle on level lev
+      void Cycle(int lev, const mfem::Vector &b, mfem::Vector &x) const;
+   public:
+      MechOperatorMultigrid(int s, const int smooth_iters);
+      virtual ~MechOperatorMultigrid() {}
+
+      virtual void Mult(const mfem::Vector &x, mfem::Vector &y) const;
+
+      int GetNumLevels() const { return (int) level_opers.size(); }
+};
+
+/// Geometric multigrid V-cycle preconditioner built on the parallel uniform refinement
+/// hierarchy of our mesh. The finest level makes use of our matrix-free gradient operator.
+/// The material tangent only lives at the quadrature points of the finest level, so each
+/// coarser level is rediscretized with the element averaged material tangent of its
+/// children and the current nodal coordinates interpolated from the level above. These
+/// coarse levels are small enough that they're assembled from their element matrices.
+/// Each level is smoothed with either damped Jacobi sweeps or our Chebyshev smoother,
+/// and BoomerAMG is applied on the coarsest level.
+class MechOperatorGMG : public MechOperatorMultigrid
+{
+   protected:
+      /// All of the data related to one of our coarse levels
+      struct CoarseLevel
+      {
+         mfem::ParFiniteElementSpace *fes;
+         /// Prolongation of this level's true dofs to those of the next finer level
+         mfem::Operator *prolong;
+         /// Interpolates the next finer level's L-vectors onto this level's nodes
+         mfem::SparseMatrix *inject;
+         /// The 8 children of each element on the next finer level
+         mfem::Array<int> children;
+         mfem::Array<int> ess_tdofs;
+         mfem::Array<int> csr_offsets, csr_sources;
+         mfem::SparseMatrix *loc_mat;
+         mfem::HypreParMatrix *mat;
+         MechOperatorSmoother *smoother;
+         mfem::Vector crds, el_crds, elem_tan, ea_data, diag;
+
+         CoarseLevel() : fes(nullptr), prolong(nullptr), inject(nullptr), loc_mat(nullptr),
+            mat(nullptr), smoother(nullptr) {}
+         ~CoarseLevel();
+      };
+
+      mfem::ParFiniteElementSpace &fes;
+      ExaModel *model; // Not owned
+      const mfem::ParGridFunction &x_cur;
+      const mfem::Array2D<bool> &ess_bdr_comps;
+      int nqpts, nnodes;
+      /// Shape function gradients and weights at the quadrature points of our elements,
+      /// which are the same on every level
+      mfem::Vector qpts_dshape, qpts_wts;
+      /// Index 0 is our coarsest level and the last entry is the level just below our fine one
+      std::vector<CoarseLevel*> levels;
+      MechOperatorSmoother *fine_smoother;
+      mfem::Vector fine_tan;
+      mfem::HypreBoomerAMG *amg;
+
+      /// Forms the element averaged tangent, coordinates, and assembled operator of a level
+      void AssembleLevel(int lev, const mfem::Vector &fine_crds, const mfem::Vector &fine_elem_tan);
+   public:
+      /// coarse_meshes is ordered from coarsest to finest where each mesh was uniformly refined
+      /// to obtain the next one and the last of them was refined to obtain the mesh of fes.
+      MechOperatorGMG(mfem::ParFiniteElementSpace &fes,
+                      ExaModel *model,
+                      const mfem::ParGridFunction &x_cur,
+                      const mfem::Array<int> &ess_tdofs,
+                      const mfem::Array<mfem::ParMesh*> &coarse_meshes,
+                      const mfem::Array<int> &ess_bdr,
+                      const mfem::Array2D<bool> &ess_bdr_comps,
+                      const int smooth_iters,
+                      const SmootherType smoother_type = SmootherType::JACOBI,
+                      const int cheb_order = 3,
+                      const int cheb_power_iters = 10);
+      virtual ~MechOperatorGMG();
+
+      virtual void Update(const mfem::Operator &grad, const mfem::Vector &diag);
+
+      virtual void UpdateEssTDofs(const mfem::Array<int> &ess_bdr);
+
+      /// The assembled operator of coarse level lev from the last Update call
+      const mfem::HypreParMatrix *GetLevelMatrix(int lev) const { return levels[lev]->mat; }
+      /// The prolongation from coarse level lev to the next finer level
+      const mfem::Operator *GetLevelProlongation(int lev) const { return levels[lev]->prolong; }
+};
+
+/// p-multigrid V-cycle preconditioner for our high-order runs. Every level lives on our
+/// mesh with orders p, p - 1, ..., 1. Each lower order level makes use of the gradient
+/// operator of an ExaNLFIntegrator with the same assembly level as our fine operator. These
+/// integrators are evaluated at the quadrature points of our fine level, so they make use
+/// of the actual material tangent and our shared jacobian. The first order level is then
+/// assembled from its EA element matrices and solved with BoomerAMG, while the others are
+/// smoothed with either damped Jacobi sweeps or our Chebyshev smoother.
+class MechOperatorPMG : public MechOperatorMultigrid
+{
+   protected:
+      mfem::ParFiniteElementSpace &fes;
+      const mfem::Array2D<bool> &ess_bdr_comps;
+      /// The spaces, forms, and prolongations of our lower order levels where index 0 is
+      /// our first order level
+      std::vector<mfem::FiniteElementCollection*> fecs;
+      std::vector<mfem::ParFiniteElementSpace*> spaces;
+      std::vector<mfem::ParNonlinearForm*> forms;
+      std::vector<mfem::Operator*> prolongs;
+      /// Smoothers of every level but our first order one
+      std::vector<MechOperatorSmoother*> smoothers;
+      std::vector<mfem::Vector> diags;
+      FullMechOperatorGradAssembler *coarse_assembler;
+      mfem::HypreBoomerAMG *amg;
+   public:
+      MechOperatorPMG(mfem::ParFiniteElementSpace &fes,
+                      ExaModel *model,
+                      mfem::Vector &el_jac,
+                      const mfem::Array<int> &ess_tdofs,
+                      const mfem::Array<int> &ess_bdr,
+                      const mfem::Array2D<bool> &ess_bdr_comps,
+                      const mfem::AssemblyLevel assembly,
+                      const int smooth_iters,
+                      const SmootherType smoother_type = SmootherType::JACOBI,
+                      const int cheb_order = 3,
+                      const int cheb_power_iters = 10);
+      virtual ~MechOperatorPMG();
+
+      virtual void Update(const mfem::Operator &grad, const mfem::Vector &diag);
+
+      virtual void UpdateEssTDofs(const mfem::Array<int> &ess_bdr);
+
+      /// The gradient operator of level lev from the last Update call
+      const mfem::Operator *GetLevelOperator(int lev) const { return level_opers[lev]; }
+      /// The prolongation from level lev to the next finer level
+      const mfem::Operator *GetLevelProlongation(int lev) const { return level_prolongs[lev]; }
+};
+
+/// Block-Jacobi preconditioner built from the 3x3 diagonal blocks of each node of our
+/// gradient operator. These capture the coupling between the x, y, and z displacement
+/// components of a node, which the plain Jacobi preconditioner ignores and which can be
+/// strong with anisotropic crystal tangents. The blocks are assembled from the
+/// integrators' AssembleGradBlockDiagonalPA kernels, so they're available with either
+/// PA or EA.
+class MechOperatorBlockJacobi : public MechOperatorPreconditioner
+{
+   protected:
+      mfem::NonlinearForm *oper_mech; // Not owned
+      const mfem::Array<int> &ess_tdof_list;
+      const mfem::Operator *elem_restrict_lex; // Not owned
+      const mfem::Operator *P; // Not owned
+      int ntnodes;
+      bool by_nodes;
+      /// Our nodal blocks as E-vectors, L-vectors, and true vectors with one of each per column
+      mfem::Vector blk_e, blk_l, blk_t;
+      /// Inverse of the 3x3 block of each true node stored column major
+      mfem::Vector blk_inv;
+      mfem::Vector ess_mark;
+   public:
+      MechOperatorBlockJacobi(mfem::NonlinearForm *mech_operator,
+                              const mfem::Array<int> &ess_tdofs);
+      virtual ~MechOperatorBlockJacobi() {}
+
+      virtual void Update(const mfem::Operator &grad, const mfem::Vector &diag);
+      virtual bool NeedsDiagonal() const { return false; }
+
+      virtual void Mult(const mfem::Vector &x, mfem::Vector &y) const;
+};
+
+/// Additive Schwarz preconditioner for EA runs where each element is a subdomain:
+/// y = sum_e R_e^T M_e^{-1} R_e x. M_e is our element matrix with its diagonal swapped
+/// out for that of the assembled operator, which removes the rigid body modes that a
+/// lone element matrix would have. Essential true dofs are decoupled within M_e. The
+/// element inverses take up as much memory as our EA data.
+class MechOperatorElementSchwarz : public MechOperatorPreconditioner
+{
+   protected:
+      mfem::NonlinearForm *oper_mech; // Not owned
+      const mfem::Array<int> &ess_tdof_list;
+      const mfem::Operator *elem_restrict_lex; // Not owned
+      const mfem::Operator *P; // Not owned
+      int NE, elemDofs;
+      /// The element inverses
+      mfem::Vector ea_inv;
+      mfem::Vector ess_mark, diag_e, ess_e;
+      mutable mfem::Vector px, localX, localY;
+   public:
+      MechOperatorElementSchwarz(mfem::NonlinearForm *mech_operator,
+                                 const mfem::Array<int> &ess_tdofs);
+      virtual ~MechOperatorElementSchwarz() {}
+
+      virtual void Update(const mfem::Operator &grad, const mfem::Vector &diag);
+
+      virtual void Mult(const mfem::Vector &x, mfem::Vector &y) const;
 };
 
 /// Jacobi smoothing for a given bilinear form (no matrix necessary).
@@ -81,7 +434,7 @@ class EANonlinearMechOperatorGradExt : public PANonlinearMechOperatorGradExt
 /** Useful with tensorized, partially assembled operators. Can also be defined
     by given diagonal vector. This is basic Jacobi iteration; for tolerances,
     iteration control, etc. wrap with SLISolver. */
-class MechOperatorJacobiSmoother  : public mfem::Solver
+class MechOperatorJacobiSmoother  : public MechOperatorSmoother
 {
    public:
 
@@ -110,5 +463,58 @@ class MechOperatorJacobiSmoother  : public mfem::Solver
       const mfem::Operator *oper;
 };
 
+/// Chebyshev polynomial smoother of the Jacobi scaled operator D^{-1} A. It only needs
+/// the action and assembled diagonal of A, so it works with our PA and EA operators.
+/// The largest eigenvalue of D^{-1} A is estimated with power iterations during each
+/// Setup call. These start from the eigenvector of our previous estimate, so once the
+/// first Newton iteration is done only a couple of iterations are normally needed.
+/// The polynomial then damps the eigenvalues that lie within
+/// [lambda_max / eig_ratio, lambda_max] where lambda_max has a 10% safety factor.
+class MechOperatorChebyshevSmoother : public MechOperatorSmoother
+{
+   public:
+      /** The underlying operator is assumed to act as the identity on the entries
+          in ess_tdof_list just as with MechOperatorJacobiSmoother. A small eig_ratio
+          is suited to smoothing within multigrid, while a larger one makes for a
+          better standalone preconditioner. */
+      MechOperatorChebyshevSmoother(MPI_Comm comm,
+                                    const mfem::Vector &d,
+                                    const mfem::Array<int> &ess_tdofs,
+                                    const int order,
+                                    const int power_iters,
+                                    const double eig_ratio);
+      ~MechOperatorChebyshevSmoother() {}
+
+      void Mult(const mfem::Vector &x, mfem::Vector &y) const;
+
+      void SetOperator(const mfem::Operator &op) { oper = &op; }
+
+      /// Requires our operator to have already been set
+      void Setup(const mfem::Vector &diag);
+
+      /// Our last estimate of the largest eigenvalue of D^{-1} A
+      double GetMaxEigEstimate() const { return max_eig; }
+      /// The number of power iterations used by our last eigenvalue estimate
+      int GetNumPowerIterations() const { return num_power_iters; }
+
+   private:
+      MPI_Comm comm;
+      const int N;
+      const int order;
+      const int power_iters;
+      const double eig_ratio;
+      mfem::Vector dinv;
+      // Our current estimate of the eigenvector of the largest eigenvalue
+      mfem::Vector eig_vec;
+      double max_eig;
+      int num_power_iters;
+      const mfem::Array<int> &ess_tdof_list;
+      mutable mfem::Vector residual, dir, adir;
+
+      const mfem::Operator *oper;
+
+      void EstimateMaxEig();
+};
+
 
 #endif /* mechanics_operator_hpp */
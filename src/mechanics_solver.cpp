@@ -8,6 +8,7 @@
 #include <iomanip>
 #include <algorithm>
 #include <cmath>
+#include <limits>
 
 
 using namespace std;
@@ -36,6 +37,125 @@ void ExaNewtonSolver::SetOperator(const NonlinearForm &op)
    c.SetSize(width, Device::GetMemoryType()); c.UseDevice(true);
 }
 
+void ExaNewtonSolver::SetAdaptiveLinRtol(const int type, const double rtol0, const double rtol_max,
+                                         const double rtol_min, const double alpha, const double gamma)
+{
+   MFEM_VERIFY(type == 1 || type == 2, "The Eisenstat-Walker type must be either 1 or 2");
+   MFEM_VERIFY(rtol0 > 0.0 && rtol_max < 1.0 && rtol_min <= rtol_max,
+               "The Eisenstat-Walker tolerances must satisfy 0 < rtol0 and rtol_min <= rtol_max < 1");
+   lin_rtol_type = type;
+   lin_rtol0 = rtol0;
+   lin_rtol_max = rtol_max;
+   lin_rtol_min = rtol_min;
+   lin_rtol_alpha = alpha;
+   lin_rtol_gamma = gamma;
+}
+
+void ExaNewtonSolver::AdaptiveLinRtolPreSolve(const int it, const double fnorm, const double fnorm_exit) const
+{
+   if (!lin_rtol_type) {
+      return;
+   }
+
+   IterativeSolver *iter_solver = dynamic_cast<IterativeSolver*>(prec);
+   MFEM_VERIFY(iter_solver, "The adaptive Krylov tolerance requires an IterativeSolver");
+
+   double eta = lin_rtol0;
+   if (it > 0) {
+      double sg_eta;
+      if (lin_rtol_type == 1) {
+         eta = std::abs(fnorm - lnorm_last) / fnorm_last;
+         sg_eta = std::pow(eta_last, 0.5 * (1.0 + std::sqrt(5.0)));
+      }
+      else {
+         eta = lin_rtol_gamma * std::pow(fnorm / fnorm_last, lin_rtol_alpha);
+         sg_eta = lin_rtol_gamma * std::pow(eta_last, lin_rtol_alpha);
+      }
+      // Safeguard from Eisenstat and Walker to keep eta from dropping too quickly
+      if (sg_eta > 0.1) {
+         eta = std::max(eta, sg_eta);
+      }
+      // There's no point in solving our last iteration any more accurately than
+      // what's needed to get under our Newton exit tolerance.
+      eta = std::max(eta, 0.5 * fnorm_exit / fnorm);
+   }
+   eta = std::min(std::max(eta, lin_rtol_min), lin_rtol_max);
+   eta_last = eta;
+
+   iter_solver->SetRelTol(eta);
+   if (print_level >= 0) {
+      mfem::out << "Krylov solver rel. tol. for this iteration is " << eta << '\n';
+   }
+}
+
+void ExaNewtonSolver::AdaptiveLinRtolPostSolve(const Operator &grad, const double fnorm) const
+{
+   const IterativeSolver *lin_solver = dynamic_cast<const IterativeSolver *>(prec);
+   if (lin_solver) {
+      lin_iters += lin_solver->GetNumIterations();
+   }
+
+   if (!lin_rtol_type) {
+      return;
+   }
+
+   fnorm_last = fnorm;
+   // The 1st Eisenstat-Walker choice needs the true norm of our linear residual as our
+   // Krylov solvers only give us their preconditioned one.
+   if (lin_rtol_type == 1) {
+      lin_res.SetSize(r.Size(), Device::GetMemoryType());
+      lin_res.UseDevice(true);
+      grad.Mult(c, lin_res);
+      lin_res -= r;
+      lnorm_last = Norm(lin_res);
+   }
+}
+
+void ExaNewtonSolver::AdaptiveLinRtolReset() const
+{
+   if (!lin_rtol_type) {
+      return;
+   }
+   IterativeSolver *iter_solver = dynamic_cast<IterativeSolver*>(prec);
+   iter_solver->SetRelTol(lin_rtol_min);
+}
+
+void ExaNewtonSolver::SetJacobianReuse(const int max_reuse, const bool across_solves,
+                                       const double stall_ratio)
+{
+   MFEM_VERIFY(max_reuse >= 0, "The number of times a Jacobian is reused can't be negative");
+   MFEM_VERIFY(stall_ratio > 0.0 && stall_ratio < 1.0, "The Jacobian stall ratio must be within (0, 1)");
+   jac_reuse = max_reuse;
+   jac_reuse_solves = across_solves;
+   jac_stall_ratio = stall_ratio;
+}
+
+Operator &ExaNewtonSolver::GetJacobian(const Vector &x) const
+{
+   if (jac_grad && !jac_stalled && (jac_age < jac_reuse)) {
+      jac_age++;
+      if (print_level >= 0) {
+         mfem::out << "Reusing the Jacobian formed " << jac_age << " iteration(s) ago\n";
+      }
+      return *jac_grad;
+   }
+
+   jac_grad = &oper_mech->GetGradient(x);
+   jac_age = 0;
+   jac_stalled = false;
+   prec->SetOperator(*jac_grad);
+   return *jac_grad;
+}
+
+bool ExaNewtonSolver::JacobianStalled(const double norm_ratio) const
+{
+   if (norm_ratio > jac_stall_ratio) {
+      jac_stalled = true;
+      return jac_age > 0;
+   }
+   return false;
+}
+
 void ExaNewtonSolver::Mult(const Vector &b, Vector &x) const
 {
    CALI_CXX_MARK_SCOPE("NR_solver");
@@ -70,7 +190,11 @@ void ExaNewtonSolver::Mult(const Vector &b, Vector &x) const
    norm_max = std::max(rel_tol * norm, abs_tol);
 
    prec->iterative_mode = false;
+   lin_iters = 0;
    double scale = 1.0;
+   if (!jac_reuse_solves) {
+      ResetJacobian();
+   }
 
    // x_{i+1} = x_i - [DF(x_i)]^{-1} [F(x_i)-b]
    for (it = 0; true; it++) {
@@ -95,12 +219,14 @@ void ExaNewtonSolver::Mult(const Vector &b, Vector &x) const
          break;
       }
 
-      prec->SetOperator(oper_mech->GetGradient(x));
+      Operator &grad = GetJacobian(x);
+      AdaptiveLinRtolPreSolve(it, norm, norm_max);
       CALI_MARK_BEGIN("krylov_solver");
       prec->Mult(r, c); // c = [DF(x_i)]^{-1} [F(x_i)-b]
                         // ExaConstit may use GMRES here
 
       CALI_MARK_END("krylov_solver");
+      AdaptiveLinRtolPostSolve(grad, norm);
       const double c_scale = scale;
       if (c_scale == 0.0) {
          converged = 0;
@@ -127,7 +253,14 @@ void ExaNewtonSolver::Mult(const Vector &b, Vector &x) const
       // Eventually, we'll fix this in our scaling factor function.
       norm_ratio = norm / norm_prev;
 
-      if (norm_ratio > 5.0e-1) {
+      if (JacobianStalled(norm_ratio)) {
+         // The poor convergence here is due to our reused Jacobian, so a new one is all we need
+         scale = 1.0;
+         if (print_level >= 0) {
+            mfem::out << "The reused Jacobian stalled, so a new one will be formed\n";
+         }
+      }
+      else if (norm_ratio > 5.0e-1) {
          scale = 0.5;
          if (print_level >= 0) {
             mfem::out << "The relaxation factor for the next iteration has been reduced to " << scale << "\n";
@@ -138,12 +271,19 @@ void ExaNewtonSolver::Mult(const Vector &b, Vector &x) const
       }
    }
 
+   AdaptiveLinRtolReset();
+   // Whoever called us will most likely try again with a different state or time step
+   if (!converged) {
+      ResetJacobian();
+   }
    final_iter = it;
    final_norm = norm;
 }
 
 void ExaNewtonSolver::CGSolver(mfem::Operator &oper, const mfem::Vector &b, mfem::Vector &x) const
 {
+   // Our linear solver no longer corresponds to any gradient we might be reusing
+   ResetJacobian();
    prec->SetOperator(oper);
    CALI_MARK_BEGIN("krylov_solver");
    prec->Mult(b, x); // c = [DF(x_i)]^{-1} [F(x_i)-b]
@@ -186,7 +326,10 @@ void ExaNewtonLSSolver::Mult(const Vector &b, Vector &x) const
    norm_max = std::max(rel_tol * norm, abs_tol);
 
    prec->iterative_mode = false;
-   double scale = 1.0;
+   lin_iters = 0;
+   if (!jac_reuse_solves) {
+      ResetJacobian();
+   }
 
    // x_{i+1} = x_i - [DF(x_i)]^{-1} [F(x_i)-b]
    for (it = 0; true; it++) {
@@ -211,59 +354,207 @@ void ExaNewtonLSSolver::Mult(const Vector &b, Vector &x) const
          break;
       }
 
-      prec->SetOperator(oper_mech->GetGradient(x));
+      Operator &grad = GetJacobian(x);
+      AdaptiveLinRtolPreSolve(it, norm, norm_max);
       CALI_MARK_BEGIN("krylov_solver");
       prec->Mult(r, c); // c = [DF(x_i)]^{-1} [F(x_i)-b]
                         // ExaConstit may use GMRES here
       CALI_MARK_END("krylov_solver");
-      // This line search method is based on the quadratic variation of the norm
-      // of the residual line search described in this conference paper:
-      // https://doi.org/10.1007/978-3-642-01970-8_46 . We can probably do better
-      // than this one.
+      AdaptiveLinRtolPostSolve(grad, norm);
+      // Backtracking line search with an Armijo condition on the norm of our residual.
+      // The full Newton step is always tried first. Each probe leaves our operator set up
+      // at the probed point, so the residual of the accepted probe is our new residual and
+      // no further evaluations are needed. So, whenever the full step is accepted this only
+      // costs the one residual evaluation that plain Newton needs as well. Our residual
+      // evaluations also put off forming the material tangent until a gradient is needed.
+      const double norm_prev = norm;
       {
          CALI_CXX_MARK_SCOPE("Line Search");
          x_prev = x;
-         add(x, -1.0, c, x);
-         oper_mech->Mult(x, r);
-         if(have_b) {
-            r -= b;
+         double alpha = 1.0;
+         for (int ils = 0; true; ils++) {
+            add(x_prev, -alpha, c, x);
+            oper_mech->Mult(x, r);
+            if (have_b) {
+               r -= b;
+            }
+            norm = Norm(r);
+
+            if ((norm <= (1.0 - ls_armijo * alpha) * norm_prev) || (ils >= ls_max_backtracks)) {
+               break;
+            }
+            // Minimizer of the quadratic through ||r(0)||^2, its slope -2 ||r(0)||^2 for
+            // our Newton direction, and ||r(alpha)||^2 kept within [0.1, 0.5] alpha.
+            const double phi0 = norm_prev * norm_prev;
+            const double phia = norm * norm;
+            const double denom = phia - phi0 + 2.0 * phi0 * alpha;
+            double alpha_new = (denom > 0.0) ? (phi0 * alpha * alpha / denom) : 0.5 * alpha;
+            alpha_new = std::min(std::max(alpha_new, 0.1 * alpha), 0.5 * alpha);
+            alpha = alpha_new;
          }
-         double q1 = norm;
-         double q3 = Norm(r);
-         x = x_prev;
-         add(x, -0.5, c, x);
-         oper_mech->Mult(x, r);
-         if(have_b) {
-            r -= b;
+
+         if (print_level >= 0) {
+            mfem::out << "The relaxation factor for this iteration is " << alpha << std::endl;
          }
-         double q2 = Norm(r);
+      }
 
-         double eps = (3.0 * q1 - 4.0 * q2 + q3) / (4.0 * (q1 - 2.0 * q2 + q3));
+      if (JacobianStalled(norm / norm_prev) && print_level >= 0) {
+         mfem::out << "The reused Jacobian stalled, so a new one will be formed\n";
+      }
+   }
 
-         if ((q1 - 2.0 * q2 + q3) > 0 && eps > 0 && eps < 1) {
-            scale = eps;
-         } else if (q3 < q1) {
-            scale = 1.0;
-         } else {
-            // We should probably just quit if this is the case...
-            scale = 0.05;
-         }
+   AdaptiveLinRtolReset();
+   // Whoever called us will most likely try again with a different state or time step
+   if (!converged) {
+      ResetJacobian();
+   }
+   final_iter = it;
+   final_norm = norm;
+}
 
-         if (print_level >= 0) {
-            mfem::out << "The relaxation factor for this iteration is " << scale << std::endl;
-         }
+void ExaNewtonAndersonSolver::SetDepth(const int depth)
+{
+   MFEM_VERIFY(depth >= 1, "The Anderson mixing depth must be at least 1");
+   for (int i = 0; i < aa_dc.Size(); i++) {
+      delete aa_dc[i];
+      delete aa_dg[i];
+   }
+   aa_depth = depth;
+   aa_dc.SetSize(aa_depth);
+   aa_dg.SetSize(aa_depth);
+   for (int i = 0; i < aa_depth; i++) {
+      aa_dc[i] = new Vector();
+      aa_dg[i] = new Vector();
+   }
+}
+
+ExaNewtonAndersonSolver::~ExaNewtonAndersonSolver()
+{
+   for (int i = 0; i < aa_dc.Size(); i++) {
+      delete aa_dc[i];
+      delete aa_dg[i];
+   }
+}
+
+void ExaNewtonAndersonSolver::Mult(const Vector &b, Vector &x) const
+{
+   CALI_CXX_MARK_SCOPE("NRAA_solver");
+   MFEM_ASSERT(oper != NULL, "the Operator is not set (use SetOperator).");
+   MFEM_ASSERT(prec != NULL, "the Solver is not set (use SetSolver).");
+
+   int it;
+   double norm0, norm, norm_max, norm_prev;
+   const bool have_b = (b.Size() == Height());
 
-         x = x_prev;
+   if (c_prev.Size() != width) {
+      c_prev.SetSize(width, Device::GetMemoryType()); c_prev.UseDevice(true);
+      g_prev.SetSize(width, Device::GetMemoryType()); g_prev.UseDevice(true);
+      for (int i = 0; i < aa_depth; i++) {
+         aa_dc[i]->SetSize(width, Device::GetMemoryType()); aa_dc[i]->UseDevice(true);
+         aa_dg[i]->SetSize(width, Device::GetMemoryType()); aa_dg[i]->UseDevice(true);
       }
+   }
 
-      const double c_scale = scale;
-      if (c_scale == 0.0) {
+   if (!iterative_mode) {
+      x = 0.0;
+   }
+
+   oper_mech->Mult(x, r);
+   if (have_b) {
+      r -= b;
+   }
+
+   norm0 = norm = norm_prev = Norm(r);
+   // Set the value for the norm that we'll exit on
+   norm_max = std::max(rel_tol * norm, abs_tol);
+
+   prec->iterative_mode = false;
+   lin_iters = 0;
+   if (!jac_reuse_solves) {
+      ResetJacobian();
+   }
+
+   // Number of history columns currently stored and where the next one goes
+   int nhist = 0;
+   int next = 0;
+   DenseMatrix gram;
+   Vector rhs, gamma;
+
+   // With g(x_i) = x_i - [DF(x_i)]^{-1} [F(x_i)-b] our fixed-point residual is -c_i, so
+   // x_{i+1} = g(x_i) - sum_j gamma_j (g(x_j+1) - g(x_j)) where gamma minimizes
+   // || c_i - sum_j gamma_j (c_{j+1} - c_j) ||
+   for (it = 0; true; it++) {
+      // Make sure the norm is finite
+      MFEM_ASSERT(IsFinite(norm), "norm = " << norm);
+      if (print_level >= 0) {
+         mfem::out << "Newton iteration " << setw(2) << it
+                   << " : ||r|| = " << norm;
+         if (it > 0) {
+            mfem::out << ", ||r||/||r_0|| = " << norm / norm0;
+         }
+         mfem::out << '\n';
+      }
+      // See if our solution has converged and we can quit
+      if (norm <= norm_max) {
+         converged = 1;
+         break;
+      }
+      // See if we've gone over the max number of desired iterations
+      if (it >= max_iter) {
          converged = 0;
          break;
       }
 
-      add(x, -c_scale, c, x); // full update to the current config
-                              // ExaConstit (srw)
+      Operator &grad = GetJacobian(x);
+      AdaptiveLinRtolPreSolve(it, norm, norm_max);
+      CALI_MARK_BEGIN("krylov_solver");
+      prec->Mult(r, c); // c = [DF(x_i)]^{-1} [F(x_i)-b]
+                        // ExaConstit may use GMRES here
+
+      CALI_MARK_END("krylov_solver");
+      AdaptiveLinRtolPostSolve(grad, norm);
+
+      // The plain Newton iterate is our fixed-point iterate
+      Vector &dc = *aa_dc[next];
+      Vector &dg = *aa_dg[next];
+      if (it > 0) {
+         // dc = c_i - c_{i-1} and dg = g_i - g_{i-1} = x_i - c_i - g_{i-1}
+         subtract(c, c_prev, dc);
+         subtract(x, g_prev, dg);
+         dg.Add(-1.0, c);
+         next = (next + 1) % aa_depth;
+         nhist = std::min(nhist + 1, aa_depth);
+      }
+      c_prev = c;
+      subtract(x, c, g_prev);
+      x = g_prev;
+
+      if (nhist > 0) {
+         CALI_CXX_MARK_SCOPE("anderson_mixing");
+         // The least squares problem is small enough that we can just solve its normal equations
+         gram.SetSize(nhist);
+         rhs.SetSize(nhist);
+         gamma.SetSize(nhist);
+         double trace = 0.0;
+         for (int i = 0; i < nhist; i++) {
+            rhs(i) = Dot(*aa_dc[i], c);
+            for (int j = 0; j <= i; j++) {
+               gram(i, j) = Dot(*aa_dc[i], *aa_dc[j]);
+               gram(j, i) = gram(i, j);
+            }
+            trace += gram(i, i);
+         }
+         // A small amount of regularization keeps things well behaved when our
+         // differences become close to linearly dependent
+         for (int i = 0; i < nhist; i++) {
+            gram(i, i) += 1.0e-10 * trace / nhist + std::numeric_limits<double>::min();
+         }
+         DenseMatrixInverse gram_inv(gram);
+         gram_inv.Mult(rhs, gamma);
+         for (int i = 0; i < nhist; i++) {
+            x.Add(-gamma(i), *aa_dg[i]);
+         }
+      }
 
       // We now get our new residual
       oper_mech->Mult(x, r);
@@ -271,11 +562,379 @@ void ExaNewtonLSSolver::Mult(const Vector &b, Vector &x) const
          r -= b;
       }
 
-      // Find our new norm
+      // Find our new norm and save our previous time step value.
+      norm_prev = norm;
       norm = Norm(r);
 
+      if (JacobianStalled(norm / norm_prev) && print_level >= 0) {
+         mfem::out << "The reused Jacobian stalled, so a new one will be formed\n";
+      }
+      // Our history is no longer doing us any favors so we start over with a plain Newton step
+      if (norm > norm_prev && nhist > 0) {
+         nhist = 0;
+         next = 0;
+         if (print_level >= 0) {
+            mfem::out << "The residual increased, so the Anderson mixing history has been cleared\n";
+         }
+      }
    }
 
+   AdaptiveLinRtolReset();
+   // Whoever called us will most likely try again with a different state or time step
+   if (!converged) {
+      ResetJacobian();
+   }
    final_iter = it;
    final_norm = norm;
-}
\ No newline at end of file
+}
+
+namespace {
+// Generates the Givens rotation that zeros out dy in (dx, dy)
+void GeneratePlaneRotation(const double dx, const double dy, double &cs, double &sn)
+{
+   if (dy == 0.0) {
+      cs = 1.0;
+      sn = 0.0;
+   }
+   else if (fabs(dy) > fabs(dx)) {
+      const double temp = dx / dy;
+      sn = 1.0 / sqrt(1.0 + temp * temp);
+      cs = temp * sn;
+   }
+   else {
+      const double temp = dy / dx;
+      cs = 1.0 / sqrt(1.0 + temp * temp);
+      sn = temp * cs;
+   }
+}
+
+void ApplyPlaneRotation(double &dx, double &dy, const double cs, const double sn)
+{
+   const double temp = cs * dx + sn * dy;
+   dy = -sn * dx + cs * dy;
+   dx = temp;
+}
+} // end of private namespace
+
+void ExaGCROSolver::SetOperator(const Operator &op)
+{
+   IterativeSolver::SetOperator(op);
+   // Our recycled subspace U is still a good one, but C = A U needs to be formed again
+   rec_stale = true;
+}
+
+void ExaGCROSolver::SetKDim(const int dim)
+{
+   MFEM_VERIFY(dim >= 1, "The GCRO restart length must be at least 1");
+   for (int i = 0; i < V.Size(); i++) { delete V[i]; }
+   for (int i = 0; i < Z.Size(); i++) { delete Z[i]; }
+   V.SetSize(0);
+   Z.SetSize(0);
+   kdim = dim;
+}
+
+void ExaGCROSolver::SetRecycleDim(const int dim)
+{
+   MFEM_VERIFY(dim >= 0, "The GCRO recycled subspace dimension can't be negative");
+   for (int i = 0; i < U.Size(); i++) {
+      delete U[i];
+      delete C[i];
+   }
+   U.SetSize(0);
+   C.SetSize(0);
+   rdim = dim;
+   ClearRecycledSubspace();
+}
+
+ExaGCROSolver::~ExaGCROSolver()
+{
+   for (int i = 0; i < V.Size(); i++) { delete V[i]; }
+   for (int i = 0; i < Z.Size(); i++) { delete Z[i]; }
+   for (int i = 0; i < U.Size(); i++) {
+      delete U[i];
+      delete C[i];
+   }
+}
+
+void ExaGCROSolver::AllocateVectors() const
+{
+   if (r.Size() != width) {
+      for (int i = 0; i < V.Size(); i++) { delete V[i]; }
+      for (int i = 0; i < Z.Size(); i++) { delete Z[i]; }
+      for (int i = 0; i < U.Size(); i++) {
+         delete U[i];
+         delete C[i];
+      }
+      V.SetSize(0);
+      Z.SetSize(0);
+      U.SetSize(0);
+      C.SetSize(0);
+      ClearRecycledSubspace();
+      r.SetSize(width, Device::GetMemoryType()); r.UseDevice(true);
+      w.SetSize(width, Device::GetMemoryType()); w.UseDevice(true);
+   }
+
+   auto allocate = [&](Array<Vector *> &vecs, const int nvecs) {
+      if (vecs.Size() == nvecs) { return; }
+      vecs.SetSize(nvecs);
+      for (int i = 0; i < nvecs; i++) {
+         vecs[i] = new Vector(width, Device::GetMemoryType());
+         vecs[i]->UseDevice(true);
+      }
+   };
+   allocate(V, kdim + 1);
+   allocate(Z, kdim);
+   allocate(U, rdim);
+   allocate(C, rdim);
+}
+
+void ExaGCROSolver::RefreshRecycledSubspace() const
+{
+   CALI_CXX_MARK_SCOPE("gcro_refresh_recycle");
+   int nkeep = 0;
+   for (int i = 0; i < nrec; i++) {
+      // Keep our vectors packed at the front as we go
+      if (nkeep != i) {
+         std::swap(U[nkeep], U[i]);
+         std::swap(C[nkeep], C[i]);
+      }
+      Vector &u = *U[nkeep];
+      Vector &c = *C[nkeep];
+      oper->Mult(u, c);
+      const double cnorm0 = Norm(c);
+      for (int j = 0; j < nkeep; j++) {
+         const double alpha = Dot(*C[j], c);
+         c.Add(-alpha, *C[j]);
+         u.Add(-alpha, *U[j]);
+      }
+      const double cnorm = Norm(c);
+      // The direction is (close to) already in our recycled subspace
+      if (cnorm <= 1.0e-12 * cnorm0 || cnorm == 0.0) { continue; }
+      c *= 1.0 / cnorm;
+      u *= 1.0 / cnorm;
+      nkeep++;
+   }
+   nrec = nkeep;
+   rec_next = nrec % std::max(rdim, 1);
+   rec_stale = false;
+}
+
+void ExaGCROSolver::Mult(const Vector &b, Vector &x) const
+{
+   CALI_CXX_MARK_SCOPE("gcro_solver");
+   MFEM_ASSERT(oper != NULL, "the Operator is not set (use SetOperator).");
+   AllocateVectors();
+
+   if (iterative_mode) {
+      oper->Mult(x, r);
+      subtract(b, r, r);
+   }
+   else {
+      x = 0.0;
+      r = b;
+   }
+
+   double beta = Norm(r);
+   const double tol = std::max(rel_tol * beta, abs_tol);
+
+   // Start by taking care of the part of our residual that lies in our recycled subspace
+   if (nrec > 0) {
+      if (rec_stale) {
+         RefreshRecycledSubspace();
+      }
+      for (int i = 0; i < nrec; i++) {
+         const double alpha = Dot(*C[i], r);
+         x.Add(alpha, *U[i]);
+         r.Add(-alpha, *C[i]);
+      }
+      beta = Norm(r);
+   }
+   else {
+      rec_stale = false;
+   }
+
+   if (print_level == 1) {
+      mfem::out << "   Pass : " << setw(2) << 1
+                << "   Iteration : " << setw(3) << 0
+                << "  ||r|| = " << beta << '\n';
+   }
+
+   DenseMatrix H(kdim + 1, kdim), Hr(kdim + 1, kdim), B(std::max(rdim, 1), kdim);
+   Vector g(kdim + 1), cs(kdim), sn(kdim), y(kdim), hy(kdim + 1), by(std::max(rdim, 1));
+   final_iter = 0;
+   converged = 0;
+   for (int pass = 1; true; pass++) {
+      if (beta <= tol) {
+         converged = 1;
+         break;
+      }
+      if (final_iter >= max_iter) {
+         break;
+      }
+
+      V[0]->Set(1.0 / beta, r);
+      g = 0.0;
+      g(0) = beta;
+      H = 0.0;
+      int j = 0;
+      // Our flexible GMRES cycle on (I - C C^T) A M^{-1}
+      while (j < kdim && final_iter < max_iter) {
+         if (prec) {
+            prec->Mult(*V[j], *Z[j]);
+         }
+         else {
+            *Z[j] = *V[j];
+         }
+         Vector &v = *V[j + 1];
+         oper->Mult(*Z[j], v);
+         for (int i = 0; i < nrec; i++) {
+            B(i, j) = Dot(*C[i], v);
+            v.Add(-B(i, j), *C[i]);
+         }
+         for (int i = 0; i <= j; i++) {
+            H(i, j) = Dot(*V[i], v);
+            v.Add(-H(i, j), *V[i]);
+         }
+         H(j + 1, j) = Norm(v);
+         if (H(j + 1, j) > 0.0) {
+            v *= 1.0 / H(j + 1, j);
+         }
+
+         for (int i = 0; i <= j + 1; i++) {
+            Hr(i, j) = H(i, j);
+         }
+         for (int i = 0; i < j; i++) {
+            ApplyPlaneRotation(Hr(i, j), Hr(i + 1, j), cs(i), sn(i));
+         }
+         GeneratePlaneRotation(Hr(j, j), Hr(j + 1, j), cs(j), sn(j));
+         ApplyPlaneRotation(Hr(j, j), Hr(j + 1, j), cs(j), sn(j));
+         ApplyPlaneRotation(g(j), g(j + 1), cs(j), sn(j));
+
+         j++;
+         final_iter++;
+         const double resid = fabs(g(j));
+         if (print_level == 1) {
+            mfem::out << "   Pass : " << setw(2) << pass
+                      << "   Iteration : " << setw(3) << final_iter
+                      << "  ||r|| = " << resid << '\n';
+         }
+         if (resid <= tol || H(j, j - 1) == 0.0) {
+            break;
+         }
+      }
+
+      // Back substitution for our least squares solution y of this cycle
+      for (int i = j - 1; i >= 0; i--) {
+         y(i) = g(i);
+         for (int k = i + 1; k < j; k++) {
+            y(i) -= Hr(i, k) * y(k);
+         }
+         y(i) /= Hr(i, i);
+      }
+
+      // Our correction is u = Z y - U B y and since A U = C we have A u = V_{j+1} H y
+      Vector &u = w;
+      u = 0.0;
+      for (int i = 0; i < j; i++) {
+         u.Add(y(i), *Z[i]);
+      }
+      for (int i = 0; i < nrec; i++) {
+         by(i) = 0.0;
+         for (int k = 0; k < j; k++) {
+            by(i) += B(i, k) * y(k);
+         }
+         u.Add(-by(i), *U[i]);
+      }
+      x += u;
+
+      for (int i = 0; i <= j; i++) {
+         hy(i) = 0.0;
+         for (int k = 0; k < j; k++) {
+            hy(i) += H(i, k) * y(k);
+         }
+      }
+
+      if (rdim > 0) {
+         // The new recycled vector goes to our oldest slot. A u is already orthogonal to
+         // all of C, so it just needs to be normalized.
+         Vector &c = *C[rec_next];
+         c = 0.0;
+         for (int i = 0; i <= j; i++) {
+            c.Add(hy(i), *V[i]);
+         }
+         r -= c;
+         const double cnorm = Norm(c);
+         if (cnorm > 0.0) {
+            c *= 1.0 / cnorm;
+            U[rec_next]->Set(1.0 / cnorm, u);
+            rec_next = (rec_next + 1) % rdim;
+            nrec = std::min(nrec + 1, rdim);
+         }
+      }
+      else {
+         for (int i = 0; i <= j; i++) {
+            r.Add(-hy(i), *V[i]);
+         }
+      }
+      beta = Norm(r);
+   }
+
+   final_norm = beta;
+   if (print_level == 2) {
+      mfem::out << "GCRO: Number of iterations: " << final_iter
+                << "  ||r|| = " << final_norm << '\n';
+   }
+   if (!converged && print_level >= 0) {
+      mfem::out << "GCRO: No convergence!\n";
+   }
+}
+
+void ExaBoomerAMG::SetReuse(const int _max_reuse, const double _refresh_ratio)
+{
+   MFEM_VERIFY(_max_reuse >= 0, "The number of times an AMG hierarchy is reused can't be negative");
+   MFEM_VERIFY(_refresh_ratio >= 1.0, "The AMG refresh ratio must be at least 1");
+   max_reuse = _max_reuse;
+   refresh_ratio = _refresh_ratio;
+}
+
+void ExaBoomerAMG::SetOperator(const Operator &op)
+{
+   const HypreParMatrix *new_A = dynamic_cast<const HypreParMatrix *>(&op);
+   MFEM_VERIFY(new_A != NULL, "ExaBoomerAMG requires a HypreParMatrix");
+
+   // Finish off our bookkeeping of the solve that made use of our last operator
+   if (fresh_setup && napply > 0) {
+      napply_setup = napply;
+      fresh_setup = false;
+   }
+   const bool degraded = !fresh_setup && (napply > refresh_ratio * napply_setup);
+
+   if (setup_called && !force_setup && (nreuse < max_reuse) && !degraded &&
+       (new_A->GetGlobalNumRows() == glob_rows) && (new_A->Height() == loc_rows)) {
+      CALI_CXX_MARK_SCOPE("amg_reuse");
+      // Our coarse levels stay as they are, and hypre picks up our new finest level
+      // operator when it's handed to the solve. Our work vectors were built around the
+      // old operator's row partitioning, so they need to be built again.
+      A = new_A;
+      delete B;
+      delete X;
+      B = X = NULL;
+      nreuse++;
+   }
+   else {
+      CALI_CXX_MARK_SCOPE("amg_setup");
+      HypreBoomerAMG::SetOperator(op);
+      nreuse = 0;
+      fresh_setup = true;
+      force_setup = false;
+      glob_rows = new_A->GetGlobalNumRows();
+      loc_rows = new_A->Height();
+   }
+   napply = 0;
+}
+
+void ExaBoomerAMG::Mult(const Vector &b, Vector &x) const
+{
+   napply++;
+   HypreBoomerAMG::Mult(b, x);
+}
@@ -3,6 +3,9 @@
 #define MECHANICS_SOLVER
 
 #include "mfem/linalg/solvers.hpp"
+#include "mfem/linalg/hypre.hpp"
+
+#include <cmath>
 
 
 /// Newton's method for solving F(x)=b for a given operator F.
@@ -15,11 +18,54 @@ class ExaNewtonSolver : public mfem::IterativeSolver
       mutable mfem::Vector r, c;
       const mfem::NonlinearForm* oper_mech;
 
+      // Eisenstat-Walker forcing term parameters of our adaptive Krylov relative tolerance.
+      // lin_rtol_type = 0 means that our Krylov solver's tolerance is left alone.
+      int lin_rtol_type;
+      double lin_rtol0, lin_rtol_max, lin_rtol_min;
+      double lin_rtol_alpha, lin_rtol_gamma;
+      mutable double fnorm_last, lnorm_last, eta_last;
+      mutable mfem::Vector lin_res;
+
+      /// Sets the relative tolerance of our Krylov solver for Newton iteration it based on
+      /// our current residual norm fnorm and the norm we exit our Newton iterations at.
+      void AdaptiveLinRtolPreSolve(const int it, const double fnorm, const double fnorm_exit) const;
+      /// Saves off the residual history needed by AdaptiveLinRtolPreSolve once the Krylov
+      /// solve of grad c = r has finished. The iterations of that solve are also added to
+      /// our count of linear iterations.
+      void AdaptiveLinRtolPostSolve(const mfem::Operator &grad, const double fnorm) const;
+
+      // Total number of Krylov iterations taken during our last call to Mult
+      mutable int lin_iters;
+      /// Swaps our Krylov solver back to its fixed relative tolerance
+      void AdaptiveLinRtolReset() const;
+
+      // Modified Newton settings. Our gradient is reused for up to jac_reuse more Newton
+      // iterations after the one it was formed on, and if jac_reuse_solves is set it's also
+      // carried over to our next call of Mult.
+      int jac_reuse;
+      bool jac_reuse_solves;
+      double jac_stall_ratio;
+      mutable mfem::Operator *jac_grad;
+      mutable int jac_age;
+      mutable bool jac_stalled;
+
+      /// Returns the gradient for our current Newton iteration. Depending on our Jacobian
+      /// reuse policy this is either our last gradient, or a new one formed at x which our
+      /// linear solver is then set up with.
+      mfem::Operator &GetJacobian(const mfem::Vector &x) const;
+      /// Lets our Jacobian reuse policy know the residual norm ratio of our last Newton
+      /// iteration. Returns true if a reused gradient wasn't reducing our residual enough,
+      /// in which case a new one is formed on our next iteration.
+      bool JacobianStalled(const double norm_ratio) const;
+
    public:
-      ExaNewtonSolver() { }
+      ExaNewtonSolver() : lin_rtol_type(0), lin_iters(0), jac_reuse(0), jac_reuse_solves(false),
+         jac_stall_ratio(0.5), jac_grad(nullptr), jac_age(0), jac_stalled(false) { }
 
 #ifdef MFEM_USE_MPI
-      ExaNewtonSolver(MPI_Comm _comm) : IterativeSolver(_comm) { }
+      ExaNewtonSolver(MPI_Comm _comm) : IterativeSolver(_comm), lin_rtol_type(0), lin_iters(0),
+         jac_reuse(0), jac_reuse_solves(false), jac_stall_ratio(0.5), jac_grad(nullptr),
+         jac_age(0), jac_stalled(false) { }
 
 #endif
       virtual void SetOperator(const mfem::Operator &op);
@@ -29,6 +75,37 @@ class ExaNewtonSolver : public mfem::IterativeSolver
       /** This method is equivalent to calling SetPreconditioner(). */
       virtual void SetSolver(mfem::Solver &solver) { prec = &solver; }
 
+      /** @brief Sets the relative tolerance of our Krylov solver each Newton iteration from
+          the Eisenstat-Walker forcing terms, so early iterations aren't solved more
+          accurately than they need to be.
+
+          type = 1 uses | ||r_k|| - ||r_{k-1} - J_{k-1} c_{k-1}|| | / ||r_{k-1}|| and
+          type = 2 uses gamma (||r_k|| / ||r_{k-1}||)^alpha as the forcing term. rtol0 is
+          used on the 1st iteration and every forcing term is kept within [rtol_min, rtol_max].
+          rtol_min is also the fixed tolerance our Krylov solver is reset to afterwards.
+          The linear solver set through SetSolver must be an mfem::IterativeSolver. */
+      void SetAdaptiveLinRtol(const int type, const double rtol0, const double rtol_max,
+                              const double rtol_min, const double alpha = 0.5 * (1.0 + std::sqrt(5.0)),
+                              const double gamma = 1.0);
+
+      /** @brief Sets our Jacobian reuse policy (modified Newton).
+
+          A gradient and the linear solver / preconditioner set up with it are reused for up to
+          max_reuse Newton iterations after the one it was formed on. If across_solves is set it
+          can also be reused by our following calls to Mult, such as those of later time steps.
+          A new gradient is formed as soon as a reused one reduces our residual norm by less than
+          stall_ratio over an iteration. max_reuse = 0 is the standard Newton method. */
+      void SetJacobianReuse(const int max_reuse, const bool across_solves = false,
+                            const double stall_ratio = 0.5);
+
+      /// Forces a new gradient to be formed on our next Newton iteration. This needs to be called
+      /// whenever our gradient operator is changed or formed outside of our Mult, such as after
+      /// our boundary conditions change.
+      void ResetJacobian() const { jac_grad = nullptr; }
+
+      /// Returns the total number of Krylov iterations taken during our last call to Mult
+      int GetNumLinearIterations() const { return lin_iters; }
+
       virtual void CGSolver(mfem::Operator &oper, const mfem::Vector &b, mfem::Vector &x) const;
 
       /// Solve the nonlinear system with right-hand side @a b.
@@ -51,13 +128,31 @@ class ExaNewtonSolver : public mfem::IterativeSolver
     the action of the inverse gradient of the operator. */
 class ExaNewtonLSSolver : public ExaNewtonSolver
 {
+   protected:
+      // Sufficient decrease parameter of our Armijo condition and the max number of
+      // times we backtrack from the full Newton step
+      double ls_armijo;
+      int ls_max_backtracks;
+
    public:
-      ExaNewtonLSSolver() { }
+      ExaNewtonLSSolver() : ls_armijo(1.0e-4), ls_max_backtracks(4) { }
 
 #ifdef MFEM_USE_MPI
-      ExaNewtonLSSolver(MPI_Comm _comm) : ExaNewtonSolver(_comm) { }
+      ExaNewtonLSSolver(MPI_Comm _comm) : ExaNewtonSolver(_comm), ls_armijo(1.0e-4),
+         ls_max_backtracks(4) { }
 #endif
 
+      /// Sets the sufficient decrease parameter of our Armijo condition
+      /// ||r(x - alpha c)|| <= (1 - armijo alpha) ||r(x)|| and the max number of times
+      /// we backtrack from the full Newton step before taking the last step we tried.
+      void SetLineSearch(const double armijo, const int max_backtracks)
+      {
+         MFEM_VERIFY(armijo > 0.0 && armijo < 1.0, "The Armijo parameter must be within (0, 1)");
+         MFEM_VERIFY(max_backtracks >= 0, "The number of line search backtracks can't be negative");
+         ls_armijo = armijo;
+         ls_max_backtracks = max_backtracks;
+      }
+
       using ExaNewtonSolver::SetOperator;
 
       using ExaNewtonSolver::SetSolver;
@@ -70,4 +165,152 @@ class ExaNewtonLSSolver : public ExaNewtonSolver
 
 };
 
+/// Newton's method for solving F(x)=b for a given operator F accelerated with
+/// Anderson mixing.
+/** The Newton update x - [DF(x)]^{-1} [F(x)-b] is treated as a fixed-point map
+    and the new iterate is the combination of the last few fixed-point iterates
+    that minimizes the l2 norm of their fixed-point residuals. This is mainly of use
+    for plastic-transition steps where plain Newton tends to oscillate, and for
+    when our Jacobian is being reused (modified Newton) and its steps are no
+    longer quadratically convergent.
+    The method GetGradient() must be implemented for the operator F.
+    The preconditioner is used (in non-iterative mode) to evaluate
+    the action of the inverse gradient of the operator. */
+class ExaNewtonAndersonSolver : public ExaNewtonSolver
+{
+   protected:
+      // Number of previous iterates used in our mixing
+      int aa_depth;
+      // Differences of the Newton corrections and of the fixed-point iterates
+      // between consecutive iterations stored in a circular buffer
+      mutable mfem::Array<mfem::Vector *> aa_dc, aa_dg;
+      mutable mfem::Vector c_prev, g_prev;
+
+   public:
+      ExaNewtonAndersonSolver() : aa_depth(0) { SetDepth(5); }
+
+#ifdef MFEM_USE_MPI
+      ExaNewtonAndersonSolver(MPI_Comm _comm) : ExaNewtonSolver(_comm), aa_depth(0) { SetDepth(5); }
+#endif
+
+      using ExaNewtonSolver::SetOperator;
+
+      using ExaNewtonSolver::SetSolver;
+      virtual void SetSolver(mfem::Solver &solver) { prec = &solver; }
+
+      /// Sets the number of previous iterates used in our Anderson mixing
+      void SetDepth(const int depth);
+
+      using ExaNewtonSolver::CGSolver;
+      /// Solve the nonlinear system with right-hand side @a b.
+      /** If `b.Size() != Height()`, then @a b is assumed to be zero. */
+      virtual void Mult(const mfem::Vector &b, mfem::Vector &x) const;
+
+      virtual ~ExaNewtonAndersonSolver();
+};
+
+/// BoomerAMG that can keep its hierarchy around for a number of operators.
+/** Setting up the AMG hierarchy of our assembled Jacobian is often more expensive than
+    the Krylov solve it's used in, while the Jacobian itself changes very little between
+    Newton iterations and time steps. So, when given a new operator we can just swap out
+    the finest level operator and keep our coarse levels as is. A new hierarchy is set up
+    once it's been reused max_reuse times, or once the number of times we were applied
+    during the last solve grew past refresh_ratio times the number we were applied during
+    the first solve after our last setup. */
+class ExaBoomerAMG : public mfem::HypreBoomerAMG
+{
+   protected:
+      int max_reuse;
+      double refresh_ratio;
+      // Number of operators our hierarchy has been reused for
+      int nreuse;
+      // Number of times we were applied since our last SetOperator call, and during
+      // the first solve after our last setup
+      mutable int napply;
+      int napply_setup;
+      // Whether we've been set up since the last time we were given an operator
+      bool fresh_setup;
+      // Whether the next operator we're given needs a new hierarchy
+      bool force_setup;
+      // Row counts of the operators our hierarchy is for. Our old operator has normally
+      // been freed by the time we're given a new one, so it can't be checked against.
+      HYPRE_BigInt glob_rows;
+      int loc_rows;
+
+   public:
+      ExaBoomerAMG() : mfem::HypreBoomerAMG(), max_reuse(0), refresh_ratio(1.5), nreuse(0),
+         napply(0), napply_setup(0), fresh_setup(false), force_setup(false),
+         glob_rows(-1), loc_rows(-1) { }
+
+      /// Sets how many operators our hierarchy can be reused for and how much worse
+      /// our convergence can get before a new hierarchy is set up
+      void SetReuse(const int max_reuse, const double refresh_ratio);
+
+      /// The operator must be a HypreParMatrix
+      virtual void SetOperator(const mfem::Operator &op) override;
+
+      using mfem::HypreBoomerAMG::Mult;
+      virtual void Mult(const mfem::Vector &b, mfem::Vector &x) const override;
+
+      /// Forces a new hierarchy to be set up for the next operator we're given, such as
+      /// when our time step changes and the operators no longer resemble the old ones
+      void ResetReuse() { force_setup = true; }
+
+      /// Returns the number of operators our current hierarchy has been reused for
+      int GetNumReuses() const { return nreuse; }
+};
+
+/// Restarted GMRES with Krylov subspace recycling (GCRO) for solving A x = b.
+/** A small subspace U along with C = A U, which has orthonormal columns, is kept
+    between restarts and between calls to Mult. Each solve first removes the part of
+    our residual that lies in C and then runs flexible GMRES cycles on the operator
+    (I - C C^T) A M^{-1}. The correction of each GMRES cycle is added to our recycled
+    subspace, which replaces its oldest vectors once it's full (GCROT style).
+    Since the linear systems of successive Newton iterations and time steps change
+    very little, the directions that were slow to converge in earlier solves no
+    longer need to be rediscovered by every new solve.
+    Whenever our operator changes C = A U is formed again on the next solve, which costs
+    one action of our operator per recycled vector. */
+class ExaGCROSolver : public mfem::IterativeSolver
+{
+   protected:
+      // Restart length and max dimension of our recycled subspace
+      int kdim, rdim;
+      mutable mfem::Array<mfem::Vector *> V, Z, U, C;
+      mutable mfem::Vector r, w;
+      // Number of recycled vectors we currently have and where the next one goes
+      mutable int nrec, rec_next;
+      // Whether C = A U needs to be formed again since our operator changed
+      mutable bool rec_stale;
+
+      /// Makes sure all of our work vectors are allocated for our current operator
+      void AllocateVectors() const;
+      /// Forms C = A U with our current operator and orthonormalizes it, applying the
+      /// same operations to U. Vectors that are no longer linearly independent are dropped.
+      void RefreshRecycledSubspace() const;
+
+   public:
+      ExaGCROSolver() : kdim(50), rdim(5), nrec(0), rec_next(0), rec_stale(false) { }
+
+#ifdef MFEM_USE_MPI
+      ExaGCROSolver(MPI_Comm _comm) : IterativeSolver(_comm), kdim(50), rdim(5), nrec(0),
+         rec_next(0), rec_stale(false) { }
+#endif
+
+      virtual void SetOperator(const mfem::Operator &op);
+
+      /// Sets the restart length of our GMRES cycles
+      void SetKDim(const int dim);
+      /// Sets the max number of vectors kept in our recycled subspace
+      void SetRecycleDim(const int dim);
+      /// Throws away our recycled subspace
+      void ClearRecycledSubspace() const { nrec = 0; rec_next = 0; }
+      /// Returns the number of vectors currently in our recycled subspace
+      int GetRecycledDim() const { return nrec; }
+
+      virtual void Mult(const mfem::Vector &b, mfem::Vector &x) const;
+
+      virtual ~ExaGCROSolver();
+};
+
 #endif
@@ -519,6 +519,21 @@ void ExaOptions::get_time_steps()
       }
       dt_min = toml::find_or<double>(auto_table, "dt_min", 1.0);
       t_final = toml::find_or<double>(auto_table, "t_final", 1.0);
+      dt_max = toml::find_or<double>(auto_table, "dt_max", t_final);
+      if (dt_max < dt_min) {
+         MFEM_ABORT("dt_max for auto time stepping can't be less than dt_min.");
+      }
+      // The controller limits below are all off by default so that existing inputs keep
+      // the dt history of the Newton iteration based controller
+      dt_max_growth = toml::find_or<double>(auto_table, "dt_max_growth", 0.0);
+      if ((dt_max_growth != 0.0) && (dt_max_growth < 1.0)) {
+         MFEM_ABORT("dt_max_growth for auto time stepping needs to be at least 1 or 0 to turn it off.");
+      }
+      dt_pl_strain_inc = toml::find_or<double>(auto_table, "pl_strain_inc", 0.0);
+      if (dt_pl_strain_inc < 0.0) {
+         MFEM_ABORT("pl_strain_inc for auto time stepping can't be negative.");
+      }
+      dt_krylov = toml::find_or<bool>(auto_table, "krylov_factor", false);
       dt_file = toml::find_or<std::string>(auto_table, "auto_dt_file", "auto_dt_out.txt");
    }
    // Time to look at our custom time table stuff
@@ -589,6 +604,7 @@ void ExaOptions::get_solvers()
       MFEM_ABORT("Solvers.assembly was not provided a valid type.");
       assembly = Assembly::NOTYPE;
    }
+   full_from_ea = toml::find_or<bool>(table, "full_from_ea", true);
 
    std::string _rtmodel = toml::find_or<std::string>(table, "rtmodel", "CPU");
    if ((_rtmodel == "CPU") || (_rtmodel == "cpu")) {
@@ -622,13 +638,61 @@ void ExaOptions::get_solvers()
       else if ((_solver == "nrls") || (_solver == "NRLS")) {
          nl_solver = NLSolver::NRLS;
       }
+      else if ((_solver == "nraa") || (_solver == "NRAA")) {
+         nl_solver = NLSolver::NRAA;
+      }
       else {
          MFEM_ABORT("Solvers.NR.nl_solver was not provided a valid type.");
          nl_solver = NLSolver::NOTYPE;
       }
       newton_iter = toml::find_or<int>(nr_table, "iter", 25);
+      aa_depth = toml::find_or<int>(nr_table, "aa_depth", 5);
+      if (aa_depth < 1) {
+         MFEM_ABORT("Solvers.NR.aa_depth must be at least 1.");
+      }
+      ls_armijo = toml::find_or<double>(nr_table, "ls_armijo", 1.0e-4);
+      if (ls_armijo <= 0.0 || ls_armijo >= 1.0) {
+         MFEM_ABORT("Solvers.NR.ls_armijo must be within (0, 1).");
+      }
+      ls_max_backtracks = toml::find_or<int>(nr_table, "ls_max_backtracks", 4);
+      if (ls_max_backtracks < 0) {
+         MFEM_ABORT("Solvers.NR.ls_max_backtracks can't be negative.");
+      }
       newton_rel_tol = toml::find_or<double>(nr_table, "rel_tol", 1e-5);
       newton_abs_tol = toml::find_or<double>(nr_table, "abs_tol", 1e-10);
+      newton_ew = toml::find_or<bool>(nr_table, "adaptive_krylov_tol", false);
+      ew_type = toml::find_or<int>(nr_table, "ew_type", 2);
+      if (ew_type != 1 && ew_type != 2) {
+         MFEM_ABORT("Solvers.NR.ew_type must be either 1 or 2.");
+      }
+      ew_rtol0 = toml::find_or<double>(nr_table, "ew_rtol0", 0.5);
+      ew_rtol_max = toml::find_or<double>(nr_table, "ew_rtol_max", 0.9);
+      if (ew_rtol0 <= 0.0 || ew_rtol_max >= 1.0 || ew_rtol0 > ew_rtol_max) {
+         MFEM_ABORT("Solvers.NR.ew_rtol0 and ew_rtol_max must satisfy 0 < ew_rtol0 <= ew_rtol_max < 1.");
+      }
+      jac_reuse = toml::find_or<int>(nr_table, "jacobian_reuse", 0);
+      if (jac_reuse < 0) {
+         MFEM_ABORT("Solvers.NR.jacobian_reuse can't be negative.");
+      }
+      jac_reuse_steps = toml::find_or<bool>(nr_table, "jacobian_reuse_steps", false);
+      jac_stall_ratio = toml::find_or<double>(nr_table, "jacobian_stall_ratio", 0.5);
+      if (jac_stall_ratio <= 0.0 || jac_stall_ratio >= 1.0) {
+         MFEM_ABORT("Solvers.NR.jacobian_stall_ratio must be within (0, 1).");
+      }
+      std::string _predictor = toml::find_or<std::string>(nr_table, "predictor", "none");
+      if ((_predictor == "none") || (_predictor == "NONE")) {
+         vel_predictor = VelocityPredictor::NONE;
+      }
+      else if ((_predictor == "linear") || (_predictor == "LINEAR")) {
+         vel_predictor = VelocityPredictor::LINEAR;
+      }
+      else if ((_predictor == "quadratic") || (_predictor == "QUADRATIC")) {
+         vel_predictor = VelocityPredictor::QUADRATIC;
+      }
+      else {
+         MFEM_ABORT("Solvers.NR.predictor was not provided a valid type.");
+         vel_predictor = VelocityPredictor::NOTYPE;
+      }
    } // end of NR info
 
    std::string _integ_model = toml::find_or<std::string>(table, "integ_model", "FULL");
@@ -659,10 +723,98 @@ void ExaOptions::get_solvers()
       else if ((_solver == "MINRES") || (_solver == "minres")) {
          solver = KrylovSolver::MINRES;
       }
+      else if ((_solver == "GCRO") || (_solver == "gcro")) {
+         solver = KrylovSolver::GCRO;
+      }
       else {
          MFEM_ABORT("Solvers.Krylov.solver was not provided a valid type.");
          solver = KrylovSolver::NOTYPE;
       }
+      krylov_kdim = toml::find_or<int>(iter_table, "kdim", 50);
+      if (krylov_kdim < 1) {
+         MFEM_ABORT("Solvers.Krylov.kdim must be at least 1.");
+      }
+      krylov_recycle_dim = toml::find_or<int>(iter_table, "recycle_dim", 5);
+      if (krylov_recycle_dim < 0) {
+         MFEM_ABORT("Solvers.Krylov.recycle_dim can't be negative.");
+      }
+      std::string _amg_profile = toml::find_or<std::string>(iter_table, "amg_profile", "SCHWARZ");
+      if ((_amg_profile == "SCHWARZ") || (_amg_profile == "schwarz")) {
+         amg_profile = AMGProfile::SCHWARZ;
+      }
+      else if ((_amg_profile == "SYSTEMS") || (_amg_profile == "systems")) {
+         amg_profile = AMGProfile::SYSTEMS;
+      }
+      else {
+         MFEM_ABORT("Solvers.Krylov.amg_profile was not provided a valid type.");
+         amg_profile = AMGProfile::NOTYPE;
+      }
+      amg_strong_threshold = toml::find_or<double>(iter_table, "amg_strong_threshold",
+                                                   (amg_profile == AMGProfile::SCHWARZ) ? 0.9 : 0.5);
+      if (amg_strong_threshold <= 0.0 || amg_strong_threshold >= 1.0) {
+         MFEM_ABORT("Solvers.Krylov.amg_strong_threshold must be within (0, 1).");
+      }
+      amg_agg_levels = toml::find_or<int>(iter_table, "amg_agg_levels", 0);
+      if (amg_agg_levels < 0) {
+         MFEM_ABORT("Solvers.Krylov.amg_agg_levels can't be negative.");
+      }
+      amg_reuse = toml::find_or<int>(iter_table, "amg_reuse", 0);
+      if (amg_reuse < 0) {
+         MFEM_ABORT("Solvers.Krylov.amg_reuse can't be negative.");
+      }
+      amg_refresh_ratio = toml::find_or<double>(iter_table, "amg_refresh_ratio", 1.5);
+      if (amg_refresh_ratio < 1.0) {
+         MFEM_ABORT("Solvers.Krylov.amg_refresh_ratio must be at least 1.");
+      }
+      std::string _precond = toml::find_or<std::string>(iter_table, "preconditioner", "JACOBI");
+      if ((_precond == "JACOBI") || (_precond == "jacobi")) {
+         precond = PreconditionerType::JACOBI;
+      }
+      else if ((_precond == "CHEBYSHEV") || (_precond == "chebyshev")) {
+         precond = PreconditionerType::CHEBYSHEV;
+      }
+      else if ((_precond == "BLOCKJACOBI") || (_precond == "blockjacobi")) {
+         precond = PreconditionerType::BLOCKJACOBI;
+      }
+      else if ((_precond == "SCHWARZ") || (_precond == "schwarz")) {
+         precond = PreconditionerType::SCHWARZ;
+      }
+      else if ((_precond == "LORAMG") || (_precond == "loramg")) {
+         precond = PreconditionerType::LORAMG;
+      }
+      else if ((_precond == "GMG") || (_precond == "gmg")) {
+         precond = PreconditionerType::GMG;
+      }
+      else if ((_precond == "PMG") || (_precond == "pmg")) {
+         precond = PreconditionerType::PMG;
+      }
+      else {
+         MFEM_ABORT("Solvers.Krylov.preconditioner was not provided a valid type.");
+         precond = PreconditionerType::NOTYPE;
+      }
+      mg_smooth_iters = toml::find_or<int>(iter_table, "mg_smooth_iters", 2);
+      if (mg_smooth_iters < 1) {
+         MFEM_ABORT("Solvers.Krylov.mg_smooth_iters must be at least 1.");
+      }
+      std::string _smoother = toml::find_or<std::string>(iter_table, "mg_smoother", "JACOBI");
+      if ((_smoother == "JACOBI") || (_smoother == "jacobi")) {
+         mg_smoother = SmootherType::JACOBI;
+      }
+      else if ((_smoother == "CHEBYSHEV") || (_smoother == "chebyshev")) {
+         mg_smoother = SmootherType::CHEBYSHEV;
+      }
+      else {
+         MFEM_ABORT("Solvers.Krylov.mg_smoother was not provided a valid type.");
+         mg_smoother = SmootherType::NOTYPE;
+      }
+      cheb_order = toml::find_or<int>(iter_table, "cheb_order", 3);
+      if (cheb_order < 1) {
+         MFEM_ABORT("Solvers.Krylov.cheb_order must be at least 1.");
+      }
+      cheb_power_iters = toml::find_or<int>(iter_table, "cheb_power_iters", 10);
+      if (cheb_power_iters < 1) {
+         MFEM_ABORT("Solvers.Krylov.cheb_power_iters must be at least 1.");
+      }
    } // end of krylov solver info
 } // end of solver parsing
 
@@ -721,6 +873,22 @@ void ExaOptions::get_mesh()
          MFEM_ABORT("Mesh file does not exist");
       }
    }
+
+   // Locality preserving reordering of our elements
+   std::string eorder = toml::find_or<std::string>(table, "element_ordering", "none");
+   if ((eorder == "none") || (eorder == "None") || (eorder == "NONE")) {
+      elem_ordering = ElementOrdering::NONE;
+   }
+   else if ((eorder == "hilbert") || (eorder == "Hilbert") || (eorder == "HILBERT")) {
+      elem_ordering = ElementOrdering::HILBERT;
+   }
+   else if ((eorder == "morton") || (eorder == "Morton") || (eorder == "MORTON")) {
+      elem_ordering = ElementOrdering::MORTON;
+   }
+   else {
+      MFEM_ABORT("Mesh.element_ordering was not provided a valid type.");
+      elem_ordering = ElementOrdering::NOTYPE;
+   }
 } // End of mesh parsing
 
 void ExaOptions::print_options()
@@ -741,6 +909,18 @@ void ExaOptions::print_options()
    std::cout << "Edge dimensions (mx, my, mz): " << mxyz[0] << " " << mxyz[1] << " " << mxyz[2] << std::endl;
    std::cout << "Number of cells on an edge (nx, ny, nz): " << nxyz[0] << " " << nxyz[1] << " " << nxyz[2] << std::endl;
 
+   std::cout << "Element ordering: ";
+   if (elem_ordering == ElementOrdering::HILBERT) {
+      std::cout << "hilbert";
+   }
+   else if (elem_ordering == ElementOrdering::MORTON) {
+      std::cout << "morton";
+   }
+   else {
+      std::cout << "none";
+   }
+   std::cout << std::endl;
+
    std::cout << "Serial Refinement level: " << ser_ref_levels << std::endl;
    std::cout << "Parallel Refinement level: " << par_ref_levels << std::endl;
    std::cout << "P-refinement level: " << order << std::endl;
@@ -758,6 +938,10 @@ void ExaOptions::print_options()
       std::cout << "Initial time step (dt): " << dt << std::endl;
       std::cout << "Minimum time step (dt): " << dt_min << std::endl;
       std::cout << "Time step scale factor: " << dt_scale << std::endl;
+      std::cout << "Maximum time step (dt): " << dt_max << std::endl;
+      std::cout << "Maximum time step growth factor: " << dt_max_growth << std::endl;
+      std::cout << "Targeted max plastic strain increment: " << dt_pl_strain_inc << std::endl;
+      std::cout << "Krylov iterations scale time step: " << dt_krylov << std::endl;
       std::cout << "Auto time step output file: " << dt_file << std::endl;
    }
    else
@@ -794,11 +978,38 @@ void ExaOptions::print_options()
    }
    else if (nl_solver == NLSolver::NRLS) {
       std::cout << "Nonlinear Solver is Newton Raphson with a line search" << std::endl;
+      std::cout << "Line search Armijo parameter: " << ls_armijo << std::endl;
+      std::cout << "Line search max # of backtracks: " << ls_max_backtracks << std::endl;
+   }
+   else if (nl_solver == NLSolver::NRAA) {
+      std::cout << "Nonlinear Solver is Newton Raphson with Anderson acceleration" << std::endl;
+      std::cout << "Anderson acceleration depth: " << aa_depth << std::endl;
    }
 
    std::cout << "Newton Raphson rel. tol.: " << newton_rel_tol << std::endl;
    std::cout << "Newton Raphson abs. tol.: " << newton_abs_tol << std::endl;
    std::cout << "Newton Raphson # of iter.: " << newton_iter << std::endl;
+   std::cout << "Newton Raphson adaptive Krylov tol.: " << newton_ew << std::endl;
+   if (newton_ew) {
+      std::cout << "Eisenstat-Walker type: " << ew_type << std::endl;
+      std::cout << "Eisenstat-Walker initial rel. tol.: " << ew_rtol0 << std::endl;
+      std::cout << "Eisenstat-Walker max rel. tol.: " << ew_rtol_max << std::endl;
+   }
+   std::cout << "Newton Raphson Jacobian reuse: " << jac_reuse << std::endl;
+   if (jac_reuse > 0) {
+      std::cout << "Newton Raphson Jacobian reuse across steps: " << jac_reuse_steps << std::endl;
+      std::cout << "Newton Raphson Jacobian stall ratio: " << jac_stall_ratio << std::endl;
+   }
+   std::cout << "Newton Raphson initial guess predictor: ";
+   if (vel_predictor == VelocityPredictor::LINEAR) {
+      std::cout << "Linear extrapolation" << std::endl;
+   }
+   else if (vel_predictor == VelocityPredictor::QUADRATIC) {
+      std::cout << "Quadratic extrapolation" << std::endl;
+   }
+   else {
+      std::cout << "None" << std::endl;
+   }
    std::cout << "Newton Raphson grad debug: " << grad_debug << std::endl;
 
    if (integ_type == IntegrationType::FULL) {
@@ -815,6 +1026,10 @@ void ExaOptions::print_options()
    else if (solver == KrylovSolver::PCG) {
       std::cout << "PCG";
    }
+   else if (solver == KrylovSolver::GCRO) {
+      std::cout << "GCRO with " << krylov_recycle_dim << " recycled vectors and a restart length of "
+                << krylov_kdim;
+   }
    else {
       std::cout << "MINRES";
    }
@@ -824,9 +1039,64 @@ void ExaOptions::print_options()
    std::cout << "Krylov solver abs. tol.: " << krylov_abs_tol << std::endl;
    std::cout << "Krylov solver # of iter.: " << krylov_iter << std::endl;
 
+   if (assembly != Assembly::FULL) {
+      std::cout << "Krylov solver preconditioner: ";
+      if (precond == PreconditionerType::JACOBI) {
+         std::cout << "Jacobi" << std::endl;
+      }
+      else if (precond == PreconditionerType::CHEBYSHEV) {
+         std::cout << "Chebyshev" << std::endl;
+      }
+      else if (precond == PreconditionerType::BLOCKJACOBI) {
+         std::cout << "Nodal block-Jacobi" << std::endl;
+      }
+      else if (precond == PreconditionerType::SCHWARZ) {
+         std::cout << "Element additive Schwarz" << std::endl;
+      }
+      else if (precond == PreconditionerType::LORAMG) {
+         std::cout << "LOR AMG" << std::endl;
+      }
+      else if (precond == PreconditionerType::GMG) {
+         std::cout << "Geometric multigrid" << std::endl;
+      }
+      else if (precond == PreconditionerType::PMG) {
+         std::cout << "p-multigrid" << std::endl;
+      }
+
+      if ((precond == PreconditionerType::GMG) || (precond == PreconditionerType::PMG)) {
+         std::cout << "Multigrid smoothing sweeps: " << mg_smooth_iters << std::endl;
+         std::cout << "Multigrid smoother: ";
+         if (mg_smoother == SmootherType::JACOBI) {
+            std::cout << "Jacobi" << std::endl;
+         }
+         else {
+            std::cout << "Chebyshev" << std::endl;
+         }
+      }
+
+      if ((precond == PreconditionerType::CHEBYSHEV) ||
+          (((precond == PreconditionerType::GMG) || (precond == PreconditionerType::PMG)) &&
+           (mg_smoother == SmootherType::CHEBYSHEV))) {
+         std::cout << "Chebyshev polynomial order: " << cheb_order << std::endl;
+         std::cout << "Chebyshev max power iterations: " << cheb_power_iters << std::endl;
+      }
+   }
+
    std::cout << "Matrix Assembly is: ";
    if (assembly == Assembly::FULL) {
       std::cout << "Full Assembly" << std::endl;
+      std::cout << "Full Assembly formed from EA kernels: " << full_from_ea << std::endl;
+      std::cout << "BoomerAMG profile: ";
+      if (amg_profile == AMGProfile::SCHWARZ) {
+         std::cout << "Schwarz" << std::endl;
+      }
+      else {
+         std::cout << "Systems" << std::endl;
+      }
+      std::cout << "BoomerAMG strong threshold: " << amg_strong_threshold << std::endl;
+      std::cout << "BoomerAMG aggressive coarsening levels: " << amg_agg_levels << std::endl;
+      std::cout << "BoomerAMG max setup reuses: " << amg_reuse << std::endl;
+      std::cout << "BoomerAMG setup refresh ratio: " << amg_refresh_ratio << std::endl;
    }
    else if (assembly == Assembly::PA) {
       std::cout << "Partial Assembly" << std::endl;
@@ -19,6 +19,8 @@ class ExaOptions {
       MeshType mesh_type;
       double mxyz[3]; // edge dimensions (mx, my, mz)
       int  nxyz[3]; // number of cells on an edge (nx, ny, nz)
+      // space-filling curve the mesh elements are reordered along
+      ElementOrdering elem_ordering;
 
 
       // serial and parallel refinement levels
@@ -34,6 +36,11 @@ class ExaOptions {
       double dt;
       double dt_min;
       double dt_scale;
+      // Auto time stepping controller limits
+      double dt_max;
+      double dt_max_growth;
+      double dt_pl_strain_inc;
+      bool dt_krylov;
       // We have a custom dt flag
       bool dt_cust;
       bool dt_auto;
@@ -67,6 +74,22 @@ class ExaOptions {
       double newton_abs_tol;
       int newton_iter;
       NLSolver nl_solver;
+      // Number of previous iterates used by our Anderson accelerated solver
+      int aa_depth;
+      // Armijo backtracking parameters of our line search solver
+      double ls_armijo;
+      int ls_max_backtracks;
+      // Eisenstat-Walker adaptive Krylov tolerance of our Newton solver
+      bool newton_ew;
+      int ew_type;
+      double ew_rtol0;
+      double ew_rtol_max;
+      // Jacobian reuse policy (modified Newton) of our Newton solver
+      int jac_reuse;
+      bool jac_reuse_steps;
+      double jac_stall_ratio;
+      // Initial guess of our velocity field for each time step
+      VelocityPredictor vel_predictor;
 
       // Integration type
       IntegrationType integ_type;
@@ -80,6 +103,24 @@ class ExaOptions {
       int krylov_iter;
 
       KrylovSolver solver;
+      // Restart length and recycled subspace dimension of our GCRO solver
+      int krylov_kdim;
+      int krylov_recycle_dim;
+      // BoomerAMG configuration and setup reuse policy when using FULL assembly
+      AMGProfile amg_profile;
+      double amg_strong_threshold;
+      int amg_agg_levels;
+      int amg_reuse;
+      double amg_refresh_ratio;
+      PreconditionerType precond;
+      // Number of smoothing sweeps applied before and after the coarse grid
+      // correction on each level of our multigrid preconditioners
+      int mg_smooth_iters;
+      SmootherType mg_smoother;
+      // Polynomial order of our Chebyshev smoother and the max number of power
+      // iterations used to estimate the largest eigenvalue of our operator
+      int cheb_order;
+      int cheb_power_iters;
 
       // input arg to specify crystal plasticity
       bool cp;
@@ -139,6 +180,8 @@ class ExaOptions {
 
       RTModel rtmodel;
       Assembly assembly;
+      // Whether the FULL assembly path builds its matrix from our EA kernels
+      bool full_from_ea;
 
       ExaOptions(std::string _floc) : floc{_floc}
       {
@@ -176,12 +219,35 @@ class ExaOptions {
          krylov_rel_tol = 1.0e-10;
          krylov_abs_tol = 1.0e-30;
          krylov_iter = 200;
+         krylov_kdim = 50;
+         krylov_recycle_dim = 5;
+         amg_profile = AMGProfile::SCHWARZ;
+         amg_strong_threshold = 0.9;
+         amg_agg_levels = 0;
+         amg_reuse = 0;
+         amg_refresh_ratio = 1.5;
+         precond = PreconditionerType::JACOBI;
+         mg_smooth_iters = 2;
+         mg_smoother = SmootherType::JACOBI;
+         cheb_order = 3;
+         cheb_power_iters = 10;
 
          // NR parameters
          newton_rel_tol = 1.0e-5;
          newton_abs_tol = 1.0e-10;
          newton_iter = 25;
          nl_solver = NLSolver::NR;
+         aa_depth = 5;
+         ls_armijo = 1.0e-4;
+         ls_max_backtracks = 4;
+         newton_ew = false;
+         ew_type = 2;
+         ew_rtol0 = 0.5;
+         ew_rtol_max = 0.9;
+         jac_reuse = 0;
+         jac_reuse_steps = false;
+         jac_stall_ratio = 0.5;
+         vel_predictor = VelocityPredictor::NONE;
          grad_debug = false;
 
          // Integration type parameters
@@ -205,6 +271,11 @@ class ExaOptions {
          t_final = 1.0;
          dt = 1.0;
          dt_min = dt;
+         dt_scale = 0.25;
+         dt_max = t_final;
+         dt_max_growth = 0.0;
+         dt_pl_strain_inc = 0.0;
+         dt_krylov = false;
          dt_cust = false;
          dt_auto = false;
          nsteps = 1;
@@ -225,7 +296,10 @@ class ExaOptions {
          nxyz[1] = 1;
          nxyz[2] = 1;
 
+         elem_ordering = ElementOrdering::NONE;
+
          assembly = Assembly::FULL;
+         full_from_ea = true;
          rtmodel = RTModel::CPU;
       } // End of ExaOptions constructor
 
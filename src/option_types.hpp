@@ -2,9 +2,13 @@
 #define OPTION_TYPES
 
 // Taking advantage of C++11 to make it much clearer that we're using enums
-enum class KrylovSolver { GMRES, PCG, MINRES, NOTYPE };
+// GCRO is a restarted GMRES that recycles a small Krylov subspace between solves
+enum class KrylovSolver { GMRES, PCG, MINRES, GCRO, NOTYPE };
 enum class OriType { EULER, QUAT, CUSTOM, NOTYPE };
 enum class MeshType { CUBIT, AUTO, OTHER, NOTYPE };
+// The locality preserving ordering we can apply to the elements (and with them our dofs)
+// of our mesh. NONE keeps whatever ordering the mesh came with.
+enum class ElementOrdering { NONE, HILBERT, MORTON, NOTYPE };
 // Later on we'll want to support multiple different types here like
 // BCC and HCP at a minimum. However, we'll need to wait on that support reaching
 // ExaCMech
@@ -37,10 +41,33 @@ enum class RTModel { CPU, GPU, OPENMP, NOTYPE };
 enum class Assembly { PA, EA, FULL, NOTYPE };
 
 // The nonlinear solver we're making use of to solve everything.
-// The current options are Newton-Raphson or Newton-Raphson with a line search
-enum class NLSolver { NR, NRLS, NOTYPE };
+// The current options are Newton-Raphson, Newton-Raphson with a line search, or
+// Newton-Raphson accelerated with Anderson mixing
+enum class NLSolver { NR, NRLS, NRAA, NOTYPE };
+
+// The initial guess used for the velocity field at the start of each time step's
+// nonlinear solve. NONE starts from the last converged velocity field, while LINEAR
+// and QUADRATIC extrapolate in time from the last two or three converged velocity fields.
+enum class VelocityPredictor { NONE, LINEAR, QUADRATIC, NOTYPE };
 
 // Integration formulation that we want to use
 enum class IntegrationType { FULL, BBAR, NOTYPE };
 
+// The preconditioner used by our Krylov solvers for the matrix-free PA and EA
+// assembly types. JACOBI makes use of the assembled diagonal of our operator,
+// CHEBYSHEV applies a Chebyshev polynomial of the Jacobi scaled operator,
+// BLOCKJACOBI inverts the 3x3 diagonal block of each node, SCHWARZ is an EA only
+// element-block additive Schwarz method, LORAMG applies BoomerAMG to a low-order-refined sparse approximation of it,
+// GMG is a geometric multigrid V-cycle over our parallel refinement levels, and
+// PMG is a p-multigrid V-cycle over the polynomial orders p, p - 1, ..., 1.
+enum class PreconditionerType { JACOBI, CHEBYSHEV, BLOCKJACOBI, SCHWARZ, LORAMG, GMG, PMG, NOTYPE };
+
+// The BoomerAMG configuration used with FULL assembly. SCHWARZ makes use of Schwarz
+// smoothers on the finest levels, while SYSTEMS is the cheaper to set up systems AMG
+// where each velocity component is interpolated separately.
+enum class AMGProfile { SCHWARZ, SYSTEMS, NOTYPE };
+
+// The smoother applied on each level of our multigrid preconditioners
+enum class SmootherType { JACOBI, CHEBYSHEV, NOTYPE };
+
 #endif
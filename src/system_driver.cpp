@@ -7,6 +7,7 @@
 #include "BCData.hpp"
 #include "BCManager.hpp"
 
+#include <algorithm>
 #include <iostream>
 #include <limits>
 #include "ECMech_const.h"
@@ -35,7 +36,8 @@ SystemDriver::SystemDriver(ParFiniteElementSpace &fes,
                            ParGridFunction &beg_crds,
                            ParGridFunction &end_crds,
                            Vector &matProps,
-                           int nStateVars)
+                           int nStateVars,
+                           const Array<ParMesh*> &coarse_meshes)
    : fe_space(fes), def_grad(q_kinVars0), evec(q_evec), vgrad_origin_flag(options.vgrad_origin_flag)
 {
    CALI_CXX_MARK_SCOPE("system_driver_init");
@@ -45,9 +47,21 @@ SystemDriver::SystemDriver(ParFiniteElementSpace &fes,
       dt_min = options.dt_min;
       dt_class = options.dt;
       dt_scale = options.dt_scale;
+      dt_max = options.dt_max;
+      dt_max_growth = options.dt_max_growth;
+      dt_pl_strain_inc = options.dt_pl_strain_inc;
+      dt_krylov = options.dt_krylov;
       auto_dt_fname = options.dt_file;
    }
 
+   vel_predictor = options.vel_predictor;
+   if (vel_predictor != VelocityPredictor::NONE) {
+      for (int i = 0; i < 3; i++) {
+         vel_hist[i].SetSize(fe_space.TrueVSize());
+         vel_hist[i].UseDevice(true);
+      }
+   }
+
    mech_type = options.mech_type;
    class_device = options.rtmodel;
    avg_stress_fname = options.avg_stress_fname;
@@ -99,7 +113,7 @@ SystemDriver::SystemDriver(ParFiniteElementSpace &fes,
                                              q_sigma0, q_sigma1, q_matGrad,
                                              q_kinVars0, q_vonMises, ref_crds,
                                              beg_crds, end_crds, matProps,
-                                             nStateVars);
+                                             nStateVars, coarse_meshes);
    model = mech_operator->GetModel();
 
    MPI_Comm_rank(MPI_COMM_WORLD, &myid);
@@ -112,32 +126,41 @@ SystemDriver::SystemDriver(ParFiniteElementSpace &fes,
       J_prec = mech_operator->GetPAPreconditioner();
    }
    else {
-      if (options.solver == KrylovSolver::GMRES || options.solver == KrylovSolver::PCG) {
-         HypreBoomerAMG *prec_amg = new HypreBoomerAMG();
+      if (options.solver == KrylovSolver::GMRES || options.solver == KrylovSolver::PCG ||
+          options.solver == KrylovSolver::GCRO) {
+         ExaBoomerAMG *prec_amg = new ExaBoomerAMG();
          HYPRE_Solver h_amg = (HYPRE_Solver) * prec_amg;
-         HYPRE_Real st_val = 0.90;
-         HYPRE_Real rt_val = -10.0;
-         // HYPRE_Real om_val = 1.0;
-         //
-         int ml = HYPRE_BoomerAMGSetMaxLevels(h_amg, 30);
-         ml = HYPRE_BoomerAMGSetCoarsenType(h_amg, 0);
-         ml = HYPRE_BoomerAMGSetMeasureType(h_amg, 0);
-         ml = HYPRE_BoomerAMGSetStrongThreshold(h_amg, st_val);
-         ml = HYPRE_BoomerAMGSetNumSweeps(h_amg, 3);
-         ml = HYPRE_BoomerAMGSetRelaxType(h_amg, 8);
-         // int rwt = HYPRE_BoomerAMGSetRelaxWt(h_amg, rt_val);
-         // int ro = HYPRE_BoomerAMGSetOuterWt(h_amg, om_val);
-         // Dimensionality of our problem
-         ml = HYPRE_BoomerAMGSetNumFunctions(h_amg, 3);
-         ml = HYPRE_BoomerAMGSetSmoothType(h_amg, 3);
-         ml = HYPRE_BoomerAMGSetSmoothNumLevels(h_amg, 3);
-         ml = HYPRE_BoomerAMGSetSmoothNumSweeps(h_amg, 3);
-         ml = HYPRE_BoomerAMGSetVariant(h_amg, 0);
-         ml = HYPRE_BoomerAMGSetOverlap(h_amg, 0);
-         ml = HYPRE_BoomerAMGSetDomainType(h_amg, 1);
-         ml = HYPRE_BoomerAMGSetSchwarzRlxWeight(h_amg, rt_val);
-         // Just to quite the compiler warnings...
-         ml++;
+         if (options.amg_profile == AMGProfile::SCHWARZ) {
+            HYPRE_Real rt_val = -10.0;
+            // HYPRE_Real om_val = 1.0;
+            //
+            int ml = HYPRE_BoomerAMGSetMaxLevels(h_amg, 30);
+            ml = HYPRE_BoomerAMGSetCoarsenType(h_amg, 0);
+            ml = HYPRE_BoomerAMGSetMeasureType(h_amg, 0);
+            ml = HYPRE_BoomerAMGSetNumSweeps(h_amg, 3);
+            ml = HYPRE_BoomerAMGSetRelaxType(h_amg, 8);
+            // int rwt = HYPRE_BoomerAMGSetRelaxWt(h_amg, rt_val);
+            // int ro = HYPRE_BoomerAMGSetOuterWt(h_amg, om_val);
+            // Dimensionality of our problem
+            ml = HYPRE_BoomerAMGSetNumFunctions(h_amg, 3);
+            ml = HYPRE_BoomerAMGSetSmoothType(h_amg, 3);
+            ml = HYPRE_BoomerAMGSetSmoothNumLevels(h_amg, 3);
+            ml = HYPRE_BoomerAMGSetSmoothNumSweeps(h_amg, 3);
+            ml = HYPRE_BoomerAMGSetVariant(h_amg, 0);
+            ml = HYPRE_BoomerAMGSetOverlap(h_amg, 0);
+            ml = HYPRE_BoomerAMGSetDomainType(h_amg, 1);
+            ml = HYPRE_BoomerAMGSetSchwarzRlxWeight(h_amg, rt_val);
+            // Just to quite the compiler warnings...
+            ml++;
+         }
+         else {
+            // Systems AMG where the interpolation of each velocity component is done separately,
+            // which keeps our setup cost down compared to the Schwarz smoothers above.
+            prec_amg->SetSystemsOptions(3, fe_space.GetOrdering() == Ordering::byNODES);
+         }
+         HYPRE_BoomerAMGSetStrongThreshold(h_amg, options.amg_strong_threshold);
+         HYPRE_BoomerAMGSetAggNumLevels(h_amg, options.amg_agg_levels);
+         prec_amg->SetReuse(options.amg_reuse, options.amg_refresh_ratio);
 
          prec_amg->SetPrintLevel(0);
          J_prec = prec_amg;
@@ -176,6 +199,17 @@ SystemDriver::SystemDriver(ParFiniteElementSpace &fes,
       J_pcg->SetPreconditioner(*J_prec);
       J_solver = J_pcg;
    }
+   else if (options.solver == KrylovSolver::GCRO) {
+      ExaGCROSolver *J_gcro = new ExaGCROSolver(fe_space.GetComm());
+      J_gcro->SetRelTol(options.krylov_rel_tol);
+      J_gcro->SetAbsTol(options.krylov_abs_tol);
+      J_gcro->SetMaxIter(options.krylov_iter);
+      J_gcro->SetKDim(options.krylov_kdim);
+      J_gcro->SetRecycleDim(options.krylov_recycle_dim);
+      J_gcro->SetPrintLevel(0);
+      J_gcro->SetPreconditioner(*J_prec);
+      J_solver = J_gcro;
+   }
    else {
       MINRESSolver *J_minres = new MINRESSolver(fe_space.GetComm());
       J_minres->SetRelTol(options.krylov_rel_tol);
@@ -189,11 +223,19 @@ SystemDriver::SystemDriver(ParFiniteElementSpace &fes,
    // for the 1st time step. We'll want to swap back to the old one after this
    // step.
    newton_iter = options.newton_iter;
+   krylov_iter = options.krylov_iter;
    if (options.nl_solver == NLSolver::NR) {
       newton_solver = new ExaNewtonSolver(fes.GetComm());
    }
    else if (options.nl_solver == NLSolver::NRLS) {
-      newton_solver = new ExaNewtonLSSolver(fes.GetComm());
+      ExaNewtonLSSolver *ls_solver = new ExaNewtonLSSolver(fes.GetComm());
+      ls_solver->SetLineSearch(options.ls_armijo, options.ls_max_backtracks);
+      newton_solver = ls_solver;
+   }
+   else if (options.nl_solver == NLSolver::NRAA) {
+      ExaNewtonAndersonSolver *aa_solver = new ExaNewtonAndersonSolver(fes.GetComm());
+      aa_solver->SetDepth(options.aa_depth);
+      newton_solver = aa_solver;
    }
 
    // Set the newton solve parameters
@@ -204,6 +246,11 @@ SystemDriver::SystemDriver(ParFiniteElementSpace &fes,
    newton_solver->SetRelTol(options.newton_rel_tol);
    newton_solver->SetAbsTol(options.newton_abs_tol);
    newton_solver->SetMaxIter(options.newton_iter);
+   if (options.newton_ew) {
+      newton_solver->SetAdaptiveLinRtol(options.ew_type, options.ew_rtol0, options.ew_rtol_max,
+                                        options.krylov_rel_tol);
+   }
+   newton_solver->SetJacobianReuse(options.jac_reuse, options.jac_reuse_steps, options.jac_stall_ratio);
    if (options.visit || options.conduit || options.paraview || options.adios2) {
       postprocessing = true;
       CalcElementAvg(evec, model->GetMatVars0());
@@ -227,64 +274,190 @@ void SystemDriver::Solve(Vector &x)
       if (solVars.GetLastStep()) {
          dt_class = solVars.GetDTime();
       }
-      const double dt_old = dt_class;
-      Vector xprev(x); x.UseDevice(true);
+      const double dt_old = solVars.GetDTime();
+      // Every attempt at this step starts from the same time
+      const double t_start = solVars.GetTime() - dt_old;
+      double dt = dt_old;
+      double t = solVars.GetTime();
+      Vector xprev(x); xprev.UseDevice(true);
+      // Anything a failed attempt at this step leaves behind gets rolled back to this
+      mech_operator->SaveEndState();
       // We provide an initial guess for what our current coordinates will look like
       // based on what our last time steps solution was for our velocity field.
       // The end nodes are updated before the 1st step of the solution here so we're good.
+      PredictVelocity(x);
       newton_solver->Mult(zero, x);
-      if (!newton_solver->GetConverged())
-      {
-         int iter = 0;
-         while (!newton_solver->GetConverged() && (iter < 2)) {
+      int ncuts = 0;
+      while (!newton_solver->GetConverged()) {
+         // There's nothing left to cut back to so we carry on with what we have
+         if (!CutTimeStep(t_start, dt_scale, dt_min, dt, t)) {
             if (myid == 0) {
-               MFEM_WARNING("Solution did not converge decreasing dt by input scale factor");
+               MFEM_WARNING("Solution did not converge even with the minimum time step Time.Auto.dt_min, accepting the step as is");
             }
-            x = xprev;
-            // Decrease it by a quarter and try again
-            dt_class *= dt_scale;
-            if (dt_class < dt_min) { dt_class = dt_min; }
-            SetDt(dt_class);
-            newton_solver->Mult(zero, x);
-            iter += 1;
-         } // Do final converge check outside of this while loop
-         const double old_time = solVars.GetTime();
-         const double new_time = old_time - dt_old + dt_class;
-         solVars.SetTime(new_time);
-         solVars.SetDt(dt_class);
+            break;
+         }
+         if (myid == 0) {
+            MFEM_WARNING("Solution did not converge rolling back the step and decreasing dt by input scale factor");
+         }
+         x = xprev;
+         mech_operator->RestoreEndState();
+         // Our Jacobian was formed with our old dt and so was any AMG hierarchy being reused
+         newton_solver->ResetJacobian();
+         ResetPreconditionerReuse();
+         SetTime(t);
+         SetDt(dt);
+         // Our extrapolated guess depends on dt so it needs to be redone
+         PredictVelocity(x);
+         newton_solver->Mult(zero, x);
+         ncuts++;
       }
 
       // Now we're going to save off the current dt value
-      if (myid == 0 && newton_solver->GetConverged()) {
+      if (myid == 0) {
          std::ofstream file;
          file.open(auto_dt_fname, std::ios_base::app);
-         file << std::setprecision(12) << dt_class << std::endl;
+         file << std::setprecision(12) << dt << std::endl;
       }
 
-      // update the dt
-      const double niter_scale = ((double) newton_iter) * dt_scale;
-      const double nr_iter = (double) newton_solver->GetNumIterations();
-      // Will approach dt_scale as nr_iter -> newton_iter
-      // dt increases as long as nr_iter > niter_scale
-      const  double factor = niter_scale / nr_iter;
-      dt_class *= factor;
-      if (dt_class < dt_min) { dt_class = dt_min; }
-      if (myid == 0 && newton_solver->GetConverged()) {
-         std::cout << "Time "<< solVars.GetTime() << " dt old was " << solVars.GetDTime() << " dt has been updated to " << dt_class << " and changed by a factor of " << factor << std::endl;
+      const double factor = ComputeDtFactor(ncuts > 0);
+      dt_class = std::min(std::max(dt * factor, dt_min), dt_max);
+      if (myid == 0) {
+         std::cout << "Time "<< solVars.GetTime() << " dt old was " << dt << " dt has been updated to " << dt_class << " and changed by a factor of " << factor << std::endl;
       }
    }
    else {
       // We provide an initial guess for what our current coordinates will look like
       // based on what our last time steps solution was for our velocity field.
       // The end nodes are updated before the 1st step of the solution here so we're good.
+      PredictVelocity(x);
       newton_solver->Mult(zero, x);
+      MFEM_VERIFY(newton_solver->GetConverged(), "Newton Solver did not converge.");
    }
 
    // Just gotta be safe incase something in the solver wasn't playing nice and didn't swap things
    // back to the current configuration...
    // Once the system has finished solving, our current coordinates configuration are based on what our
    // converged velocity field ended up being equal to.
-   MFEM_VERIFY(newton_solver->GetConverged(), "Newton Solver did not converge.");
+   SaveVelocity(x);
+}
+
+double SystemDriver::ComputeDtFactor(const bool cut)
+{
+   // Each measure of how hard our step was suggests a factor to scale dt by. These
+   // approach dt_scale as the cost of our step approaches its limit. Only the Newton
+   // iteration one is used unless the others were asked for.
+   const double nr_iter = (double) std::max(newton_solver->GetNumIterations(), 1);
+   double factor = ((double) newton_iter) * dt_scale / nr_iter;
+
+   if (dt_krylov) {
+      const double lin_iter = ((double) newton_solver->GetNumLinearIterations()) / nr_iter;
+      if (lin_iter > 0.0) {
+         factor = std::min(factor, ((double) krylov_iter) * dt_scale / lin_iter);
+      }
+   }
+
+   if (dt_pl_strain_inc > 0.0) {
+      const double dpl = GetMaxPlasticStrainIncrement();
+      if (dpl > 0.0) {
+         factor = std::min(factor, dt_pl_strain_inc / dpl);
+      }
+   }
+
+   if (dt_max_growth > 0.0) {
+      factor = std::min(factor, dt_max_growth);
+   }
+   factor = std::max(factor, dt_scale);
+   // We just had to back off of a larger dt so we shouldn't jump right back to it
+   if (cut) {
+      factor = std::min(factor, 1.0);
+   }
+   return factor;
+}
+
+double SystemDriver::GetMaxPlasticStrainIncrement()
+{
+   if (mech_type != MechType::EXACMECH) {
+      return 0.0;
+   }
+
+   auto qf_mapping = model->GetQFMapping();
+   const int ind_pl = qf_mapping->find("shrEff")->second.first;
+   const QuadratureFunction *matVars0 = model->GetMatVars0();
+   const QuadratureFunction *matVars1 = model->GetMatVars1();
+   const int vdim = matVars0->GetVDim();
+   const int npts = matVars0->Size() / vdim;
+
+   Vector dpl(npts); dpl.UseDevice(true);
+   {
+      const auto MV0 = matVars0->Read();
+      const auto MV1 = matVars1->Read();
+      auto DPL = dpl.Write();
+      MFEM_FORALL(i, npts, DPL[i] = fabs(MV1[i * vdim + ind_pl] - MV0[i * vdim + ind_pl]); );
+   }
+
+   const double dpl_loc = (npts > 0) ? dpl.Max() : 0.0;
+   double dpl_max = 0.0;
+   MPI_Allreduce(&dpl_loc, &dpl_max, 1, MPI_DOUBLE, MPI_MAX, MPI_COMM_WORLD);
+   return dpl_max;
+}
+
+void SystemDriver::PredictVelocity(Vector &x) const
+{
+   if (vel_predictor == VelocityPredictor::NONE) { return; }
+   const int npts = std::min((vel_predictor == VelocityPredictor::QUADRATIC) ? 3 : 2, nvel_hist);
+   // Nothing to extrapolate from yet, so we stick with the last converged velocity field
+   if (npts < 2) { return; }
+
+   CALI_CXX_MARK_SCOPE("velocity_predictor");
+   // Lagrange polynomial through our last converged velocity fields at times
+   // t_n, t_n - dt_hist[0], and t_n - dt_hist[0] - dt_hist[1] evaluated at t_n + dt
+   const double dt = solVars.GetDTime();
+   const double h0 = dt_hist[0];
+   double c0, c1, c2 = 0.0;
+   if (npts == 2) {
+      c0 = 1.0 + dt / h0;
+      c1 = -dt / h0;
+   }
+   else {
+      const double h1 = dt_hist[1];
+      c0 = (dt + h0) * (dt + h0 + h1) / (h0 * (h0 + h1));
+      c1 = -dt * (dt + h0 + h1) / (h0 * h1);
+      c2 = dt * (dt + h0) / ((h0 + h1) * h1);
+   }
+
+   // Our essential true dofs were already set by UpdateVelocity so we need to hold onto them
+   const auto &ess_tdofs = mech_operator->GetEssentialTrueDofs();
+   const int ness = ess_tdofs.Size();
+   Vector ess_vals(ness); ess_vals.UseDevice(true);
+   {
+      const auto I = ess_tdofs.Read();
+      const auto X = x.Read();
+      auto E = ess_vals.Write();
+      MFEM_FORALL(i, ness, E[i] = X[I[i]]; );
+   }
+
+   const auto V0 = vel_hist[0].Read();
+   const auto V1 = vel_hist[1].Read();
+   // c2 is zero for our linear predictor so anything of the right size works here
+   const auto V2 = (npts > 2) ? vel_hist[2].Read() : V0;
+   auto X = x.ReadWrite();
+   MFEM_FORALL(i, x.Size(), X[i] = c0 * V0[i] + c1 * V1[i] + c2 * V2[i]; );
+
+   const auto I = ess_tdofs.Read();
+   const auto E = ess_vals.Read();
+   MFEM_FORALL(i, ness, X[I[i]] = E[i]; );
+}
+
+void SystemDriver::SaveVelocity(const Vector &x)
+{
+   if (vel_predictor == VelocityPredictor::NONE) { return; }
+   // Rotate our history so the oldest field gets overwritten
+   vel_hist[2].Swap(vel_hist[1]);
+   vel_hist[1].Swap(vel_hist[0]);
+   vel_hist[0] = x;
+   dt_hist[1] = dt_hist[0];
+   dt_hist[0] = solVars.GetDTime();
+   nvel_hist = std::min(nvel_hist + 1, 3);
 }
 
 // Solve the Newton system for the 1st time step
@@ -321,6 +494,10 @@ void SystemDriver::SolveInit(const Vector &xprev, Vector &x) const
 void SystemDriver::UpdateEssBdr() {
    BCManager::getInstance().updateBCData(ess_bdr, ess_bdr_scale, ess_velocity_gradient, ess_bdr_component);
    mech_operator->UpdateEssTDofs(ess_bdr["total"]);
+   // Any Jacobian we might be reusing has the old essential true dofs baked into it
+   newton_solver->ResetJacobian();
+   // Our velocity field is no longer smooth in time across this step
+   nvel_hist = 0;
 }
 
 // In the current form, we could honestly probably make use of velocity as our working array
@@ -886,11 +1063,24 @@ double SystemDriver::GetDt()
 
 void SystemDriver::SetDt(const double dt)
 {
+   // Our tangent stiffness scales with dt so the operators of the new step no longer
+   // look like the ones an AMG hierarchy might be getting reused for
+   if (dt != solVars.GetDTime()) {
+      ResetPreconditionerReuse();
+   }
    solVars.SetDt(dt);
    model->SetModelDt(dt);
    return;
 }
 
+void SystemDriver::ResetPreconditionerReuse()
+{
+   ExaBoomerAMG *prec_amg = dynamic_cast<ExaBoomerAMG *>(J_prec);
+   if (prec_amg != nullptr) {
+      prec_amg->ResetReuse();
+   }
+}
+
 SystemDriver::~SystemDriver()
 {
    delete ess_bdr_func;
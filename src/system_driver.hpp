@@ -7,6 +7,7 @@
 #include "mechanics_solver.hpp"
 #include "option_parser.hpp"
 #include <iostream>
+#include <algorithm>
 
 class SimVars
 {
@@ -43,6 +44,7 @@ class SystemDriver
       /// nonlinear model
       ExaModel *model;
       int newton_iter;
+      int krylov_iter;
       int myid;
       /// Variable telling us if we should use the UMAT specific
       /// stuff
@@ -55,6 +57,16 @@ class SystemDriver
       double dt_class = 0.0;
       double dt_min = 0.0;
       double dt_scale = 1.0;
+      double dt_max = 0.0;
+      double dt_max_growth = 0.0;
+      double dt_pl_strain_inc = 0.0;
+      bool dt_krylov = false;
+      VelocityPredictor vel_predictor = VelocityPredictor::NONE;
+      // The last few converged velocity fields with index 0 being the most recent one,
+      // and the time steps they were each obtained over.
+      mfem::Vector vel_hist[3];
+      double dt_hist[2] = { 0.0, 0.0 };
+      int nvel_hist = 0;
       mfem::QuadratureFunction &def_grad;
       std::string avg_stress_fname;
       std::string avg_pl_work_fname;
@@ -76,6 +88,22 @@ class SystemDriver
       const bool vgrad_origin_flag = false;
       mfem::Vector vgrad_origin;
 
+      /// Extrapolates our last converged velocity fields to the current time step to provide
+      /// our Newton solver with a better initial guess. The essential true dofs of x are left as is.
+      void PredictVelocity(mfem::Vector &x) const;
+      /// Saves off the converged velocity field of the current time step for our predictor
+      void SaveVelocity(const mfem::Vector &x);
+      /// Returns the factor our auto time stepping scales dt by for the next time step based
+      /// on the Newton and Krylov iterations along with the plastic strain increments of our
+      /// converged step. cut says whether dt had to be cut to obtain that step.
+      double ComputeDtFactor(const bool cut);
+      /// Returns the max increment in the effective plastic strain at any quadrature point
+      /// over the current time step. Models other than ExaCMech ones just return 0.
+      double GetMaxPlasticStrainIncrement();
+      /// Makes our AMG preconditioner, if it's reusing its hierarchy, set up a new one
+      /// for the next Jacobian
+      void ResetPreconditionerReuse();
+
    public:
       SystemDriver(mfem::ParFiniteElementSpace &fes,
                    ExaOptions &options,
@@ -91,7 +119,8 @@ class SystemDriver
                    mfem::ParGridFunction &beg_crds,
                    mfem::ParGridFunction &end_crds,
                    mfem::Vector &matProps,
-                   int nStateVars);
+                   int nStateVars,
+                   const mfem::Array<mfem::ParMesh*> &coarse_meshes);
 
       /// Get FE space
       const mfem::ParFiniteElementSpace *GetFESpace() { return &fe_space; }
@@ -102,6 +131,22 @@ class SystemDriver
       /// Driver for the newton solver
       void Solve(mfem::Vector &x);
 
+      /// Cuts dt back by dt_scale for another attempt at an auto time step starting at
+      /// t_start, whose last attempt with dt failed to converge, and sets t to the end time
+      /// of the new attempt. Once dt_min is reached there is nothing left to cut, and false
+      /// is returned with dt and t left as they are.
+      static bool CutTimeStep(const double t_start, const double dt_scale, const double dt_min,
+                              double &dt, double &t)
+      {
+         const double dt_cut = std::max(dt * dt_scale, dt_min);
+         if (dt_cut >= dt) {
+            return false;
+         }
+         dt = dt_cut;
+         t = t_start + dt;
+         return true;
+      }
+
       /// Solve the Newton system for the 1st time step
       /// It was found that for large meshes a ramp up to our desired applied BC might
       /// be needed. It should be noted that this is no longer a const function since
@@ -0,0 +1,153 @@
+
+#include "mfem.hpp"
+#include "mfem/general/forall.hpp"
+#include "mechanics_integrators.hpp"
+#include "mechanics_umat.hpp"
+#include "mechanics_operator_ext.hpp"
+#include <string>
+#include <sstream>
+#include "RAJA/RAJA.hpp"
+
+#include <gtest/gtest.h>
+
+using namespace std;
+using namespace mfem;
+
+static int outputLevel = 0;
+
+// This function compares the action of our PA gradient operator when the halo exchange of
+// P->Mult is overlapped with the work of the interior elements against the action when it
+// isn't. It needs to be run on more than 1 rank for the overlap to take place, and overlap
+// is set to whether it actually did. The difference between the two should be 0.0.
+double PAHaloOverlapTest(bool &overlap)
+{
+   int dim = 3;
+   int order = 2;
+   mfem::ParMesh *pmesh = nullptr;
+   {
+      // Enough elements so that every rank has some that don't touch any of its halo dofs
+      mfem::Mesh mesh = Mesh::MakeCartesian3D(4, 4, 4, Element::HEXAHEDRON, 1.0, 1.0, 1.0, false);
+      mesh.SetCurvature(order);
+      pmesh = new mfem::ParMesh(MPI_COMM_WORLD, mesh);
+   }
+   H1_FECollection fec(order, dim);
+
+   ParFiniteElementSpace fes(pmesh, &fec, dim);
+
+   // All of these Quadrature function variables are needed to instantiate our material model
+   // We can just ignore this marked section
+   /////////////////////////////////////////////////////////////////////////////////////////
+   int intOrder = 2 * order + 1;
+   QuadratureSpace qspace(pmesh, intOrder);
+   QuadratureFunction q_matVars0(&qspace, 1);
+   QuadratureFunction q_matVars1(&qspace, 1);
+   // Our PA operator also runs the PA setup of our integrators which reads the stress
+   QuadratureFunction q_sigma0(&qspace, 6);
+   QuadratureFunction q_sigma1(&qspace, 6);
+   QuadratureFunction q_matGrad(&qspace, 36);
+   QuadratureFunction q_kinVars0(&qspace, 9);
+   ParGridFunction beg_crds(&fes);
+   ParGridFunction end_crds(&fes);
+   Vector matProps(1);
+
+   VectorFunctionCoefficient crds_coeff(dim, [](const Vector &x, Vector &y) { y = x; });
+   end_crds.ProjectCoefficient(crds_coeff);
+   q_sigma1 = 1.0;
+
+   ExaModel *model = new AbaqusUmatModel(&q_sigma0, &q_sigma1, &q_matGrad, &q_matVars0, &q_matVars1,
+                                         &q_kinVars0, &beg_crds, &end_crds, &matProps, 1, 1, &fes,
+                                         Assembly::PA);
+   // Model time needs to be set.
+   model->SetModelDt(1.0);
+   /////////////////////////////////////////////////////////////////////////////
+   // Something resembling a cubic symmetry like material tangent
+   q_matGrad = 0.0;
+   {
+      const int npts = q_matGrad.Size() / q_matGrad.GetVDim();
+      double *cmat = q_matGrad.HostReadWrite();
+      for (int i = 0; i < npts; i++) {
+         double *c = &cmat[36 * i];
+         for (int j = 0; j < 3; j++) {
+            for (int k = 0; k < 3; k++) {
+               c[j + 6 * k] = (j == k) ? 100.0 : 75.0;
+            }
+            c[(j + 3) + 6 * (j + 3)] = 50.0;
+         }
+      }
+   }
+   // This takes our 2d cmat and transforms it into the 4d version
+   model->TransformMatGradTo4D();
+
+   // The nonlinear form owns the integrator
+   ParNonlinearForm nlf(&fes);
+   nlf.AddDomainIntegrator(new ExaNLFIntegrator(model));
+
+   // A field that differs on every rank so our halo values actually matter
+   Vector xtrue(fes.GetTrueVSize());
+   {
+      const HYPRE_BigInt offset = fes.GetMyTDofOffset();
+      for (int i = 0; i < xtrue.Size(); i++) {
+         xtrue(i) = sin(0.01 * (offset + i + 1));
+      }
+   }
+
+   Vector y_overlap(fes.GetTrueVSize());
+   Vector y_serial(fes.GetTrueVSize());
+
+   Array<int> ess_tdofs;
+   PANonlinearMechOperatorGradExt grad_pa(&nlf, ess_tdofs);
+   grad_pa.Assemble();
+   overlap = grad_pa.OverlapHalo();
+   grad_pa.Mult(xtrue, y_overlap);
+   grad_pa.SetHaloOverlap(false);
+   grad_pa.Mult(xtrue, y_serial);
+
+   double mag = ParNormlp(y_serial, 2, MPI_COMM_WORLD);
+   std::cout << "y_serial mag: " << mag << std::endl;
+   y_serial -= y_overlap;
+   double difference = ParNormlp(y_serial, 2, MPI_COMM_WORLD);
+   // Free up memory now.
+   delete model;
+   delete pmesh;
+
+   return difference / mag;
+}
+
+TEST(exaconstit, pa_halo_overlap)
+{
+   int num_procs;
+   MPI_Comm_size(MPI_COMM_WORLD, &num_procs);
+   bool overlap = false;
+   double difference = PAHaloOverlapTest(overlap);
+   std::cout << difference << std::endl;
+   if (num_procs > 1) {
+      EXPECT_TRUE(overlap) << "The halo exchange of our PA operator was not overlapped";
+   }
+   EXPECT_LT(fabs(difference), 1.0e-14) << "Did not get expected value for pa halo overlap";
+}
+
+int main(int argc, char *argv[])
+{
+   // Initialize MPI.
+   int num_procs, myid;
+   MPI_Init(&argc, &argv);
+   MPI_Comm_size(MPI_COMM_WORLD, &num_procs);
+   MPI_Comm_rank(MPI_COMM_WORLD, &myid);
+
+   // Our halo overlap is only done on the host
+   Device device("cpu");
+   printf("\n");
+   device.Print();
+
+   ::testing::InitGoogleTest(&argc, argv);
+   if (argc > 1) {
+      outputLevel = atoi(argv[1]);
+   }
+   std::cout << "got outputLevel : " << outputLevel << std::endl;
+
+   int i = RUN_ALL_TESTS();
+
+   MPI_Finalize();
+
+   return i;
+}
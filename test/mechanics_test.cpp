@@ -3,8 +3,13 @@
 #include "mfem/general/forall.hpp"
 #include "mechanics_integrators.hpp"
 #include "mechanics_umat.hpp"
+#include "mechanics_operator_ext.hpp"
+#include "mechanics_solver.hpp"
+#include "system_driver.hpp"
+#include "mechanics_mesh.hpp"
 #include <string>
 #include <sstream>
+#include <vector>
 #include "RAJA/RAJA.hpp"
 
 #include <gtest/gtest.h>
@@ -22,21 +27,27 @@ class test_model : public ExaModel
                  mfem::QuadratureFunction *q_matGrad, mfem::QuadratureFunction *q_matVars0,
                  mfem::QuadratureFunction *q_matVars1,
                  mfem::ParGridFunction* _beg_coords, mfem::ParGridFunction* _end_coords,
-                 mfem::Vector *props, int nProps, int nStateVars, Assembly _assembly) :
+                 mfem::Vector *props, int nProps, int nStateVars, Assembly _assembly,
+                 bool _sym_tan = false) :
          ExaModel(q_stress0,
                   q_stress1, q_matGrad, q_matVars0,
                   q_matVars1,
                   _beg_coords, _end_coords,
-                  props, nProps, nStateVars, _assembly) {}
+                  props, nProps, nStateVars, _assembly), sym_tan(_sym_tan) {}
 
       virtual ~test_model() {}
 
+      virtual bool SymmetricMatGrad() const { return sym_tan; }
+
       void UpdateModelVars() {}
 
       void ModelSetup(const int, const int, const int,
                       const int, const mfem::Vector &,
                       const mfem::Vector &, const mfem::Vector &) {}
       virtual void calcDpMat(mfem::QuadratureFunction & /*DpMat*/) const {};
+
+   private:
+      bool sym_tan;
 };
 
 // This function will either set our CMat array to all ones or something resembling a cubic symmetry like system.
@@ -47,7 +58,7 @@ void setCMat(QuadratureFunction &cmat_data);
 // by the necessary vector, and the matrix-free partial assembly formulation which avoids forming the matrix.
 // It's been tested on higher order elements and multiple elements. The difference in these two methods
 // should be 0.0.
-template<bool cmat_ones>
+template<bool cmat_ones, bool sym_tan = false, bool bbar = false>
 double ExaNLFIntegratorPATest()
 {
    int dim = 3;
@@ -89,14 +100,27 @@ double ExaNLFIntegratorPATest()
 
    ExaModel *model;
    // This doesn't really matter and is just needed for the integrator class.
-   model = new AbaqusUmatModel(&q_sigma0, &q_sigma1, &q_matGrad, &q_matVars0, &q_matVars1, &q_kinVars0,
-                               &beg_crds, &end_crds, &matProps, 1, 1, &fes, Assembly::PA);
+   // A model with a symmetric tangent lets the PA operator store only the unique entries of it.
+   if (sym_tan) {
+      model = new test_model(&q_sigma0, &q_sigma1, &q_matGrad, &q_matVars0, &q_matVars1,
+                             &beg_crds, &end_crds, &matProps, 1, 1, Assembly::PA, true);
+   }
+   else {
+      model = new AbaqusUmatModel(&q_sigma0, &q_sigma1, &q_matGrad, &q_matVars0, &q_matVars1, &q_kinVars0,
+                                  &beg_crds, &end_crds, &matProps, 1, 1, &fes, Assembly::PA);
+   }
    // Model time needs to be set.
    model->SetModelDt(1.0);
    /////////////////////////////////////////////////////////////////////////////
    ExaNLFIntegrator* nlf_int;
 
-   nlf_int = new ExaNLFIntegrator(dynamic_cast<AbaqusUmatModel*>(model));
+   // The Bbar integrator has its own PA gradient formulation
+   if (bbar) {
+      nlf_int = new ICExaNLFIntegrator(model);
+   }
+   else {
+      nlf_int = new ExaNLFIntegrator(model);
+   }
 
    const FiniteElement &el = *fes.GetFE(0);
    ElementTransformation *Ttr;
@@ -181,10 +205,9 @@ double ExaNLFIntegratorPATest()
 // by the necessary vector, and the matrix-free partial assembly formulation.
 // It's been tested on higher order elements and multiple elements. The difference in these two methods
 // should be 0.0.
-double ExaNLFIntegratorPAVecTest()
+double ExaNLFIntegratorPAVecTest(const int order)
 {
    int dim = 3;
-   int order = 6;
    mfem::ParMesh *pmesh = nullptr;
    {
       // Making this mesh and test real simple with 8 cubic element
@@ -302,6 +325,127 @@ double ExaNLFIntegratorPAVecTest()
    return difference / mag;
 }
 
+// This function compares the diagonal of the fully assembled element matrices to the
+// one obtained from our partial assembly formulation. The difference in these two
+// methods should be 0.0. If fused is set then the diagonal is formed along with the
+// PA tangent rather than afterwards.
+template<bool cmat_ones, bool sym_tan = false, bool fused = false>
+double ExaNLFIntegratorPADiagTest()
+{
+   int dim = 3;
+   int order = 3;
+   mfem::ParMesh *pmesh = nullptr;
+   {
+      // Making this mesh and test real simple with 8 cubic element
+      mfem::Mesh mesh = Mesh::MakeCartesian3D(2, 2, 2, Element::HEXAHEDRON, 1.0, 1.0, 1.0, false);
+      mesh.SetCurvature(order);
+      pmesh = new mfem::ParMesh(MPI_COMM_WORLD, mesh);
+   }
+   H1_FECollection fec(order, dim);
+
+   ParFiniteElementSpace fes(pmesh, &fec, dim);
+
+   // All of these Quadrature function variables are needed to instantiate our material model
+   // We can just ignore this marked section
+   /////////////////////////////////////////////////////////////////////////////////////////
+   // Define a quadrature space and material history variable QuadratureFunction.
+   int intOrder = 2 * order + 1;
+   QuadratureSpace qspace(pmesh, intOrder); // 3rd order polynomial for 2x2x2 quadrature
+   // for first order finite elements.
+   QuadratureFunction q_matVars0(&qspace, 1);
+   QuadratureFunction q_matVars1(&qspace, 1);
+   QuadratureFunction q_sigma0(&qspace, 1);
+   QuadratureFunction q_sigma1(&qspace, 1);
+   // This is our stiffness matrix and is a 6x6 due to major and minor symmetry
+   // of the 4th order tensor which has dimensions 3x3x3x3.
+   QuadratureFunction q_matGrad(&qspace, 36);
+   QuadratureFunction q_kinVars0(&qspace, 9);
+   QuadratureFunction q_vonMises(&qspace, 1);
+   ParGridFunction beg_crds(&fes);
+   ParGridFunction end_crds(&fes);
+   // We'll want to update this later in case we do anything more complicated.
+   Vector matProps(1);
+
+   end_crds = 1.0;
+
+   ExaModel *model;
+   // This doesn't really matter and is just needed for the integrator class.
+   // A model with a symmetric tangent lets the PA operator store only the unique entries of it.
+   if (sym_tan) {
+      model = new test_model(&q_sigma0, &q_sigma1, &q_matGrad, &q_matVars0, &q_matVars1,
+                             &beg_crds, &end_crds, &matProps, 1, 1, Assembly::PA, true);
+   }
+   else {
+      model = new AbaqusUmatModel(&q_sigma0, &q_sigma1, &q_matGrad, &q_matVars0, &q_matVars1, &q_kinVars0,
+                                  &beg_crds, &end_crds, &matProps, 1, 1, &fes, Assembly::PA);
+   }
+   // Model time needs to be set.
+   model->SetModelDt(1.0);
+   /////////////////////////////////////////////////////////////////////////////
+   ExaNLFIntegrator* nlf_int;
+
+   nlf_int = new ExaNLFIntegrator(model);
+
+   const FiniteElement &el = *fes.GetFE(0);
+   ElementTransformation *Ttr;
+
+   const ElementDofOrdering ordering = ElementDofOrdering::NATIVE;
+   const Operator *elem_restrict_lex;
+   elem_restrict_lex = fes.GetElementRestriction(ordering);
+
+   // All of our local global solution variables
+   Vector y_fa(end_crds.Size());
+   Vector local_y_fa(elem_restrict_lex->Height());
+   Vector local_y_pa(elem_restrict_lex->Height());
+   Vector y_pa(end_crds.Size());
+   y_fa = 0.0;
+   y_pa = 0.0;
+   local_y_pa = 0.0;
+   local_y_fa = 0.0;
+   // Variables used to kinda mimic what the NonlinearForm::GetGradient does.
+   int ndofs = el.GetDof() * el.GetDim();
+   Vector elfun(ndofs);
+   DenseMatrix elmat;
+
+   q_matGrad = 0.0;
+   setCMat<cmat_ones>(q_matGrad);
+   elfun.HostReadWrite();
+   local_y_fa.HostReadWrite();
+   for (int i = 0; i < fes.GetNE(); i++) {
+      Ttr = fes.GetElementTransformation(i);
+      nlf_int->AssembleElementGrad(el, *Ttr, elfun, elmat);
+      for (int j = 0; j < ndofs; j++) {
+         local_y_fa((i * ndofs) + j) = elmat(j, j);
+      }
+   }
+
+   // This takes our 2d cmat and transforms it into the 4d version
+   model->TransformMatGradTo4D();
+   // Perform the setup and diagonal assembly of our PA operation
+   if (fused) {
+      nlf_int->AssembleGradPADiagonal(fes, local_y_pa);
+   }
+   else {
+      nlf_int->AssembleGradPA(fes);
+      nlf_int->AssembleGradDiagonalPA(local_y_pa);
+   }
+
+   // Take all of our multiple elements and go back to the L vector.
+   elem_restrict_lex->MultTranspose(local_y_fa, y_fa);
+   elem_restrict_lex->MultTranspose(local_y_pa, y_pa);
+   // Find out how different our solutions were from one another.
+   double mag = y_fa.Norml2();
+   std::cout << "y_fa mag: " << mag << std::endl;
+   y_fa -= y_pa;
+   double difference = y_fa.Norml2();
+   // Free up memory now.
+   delete nlf_int;
+   delete model;
+   delete pmesh;
+
+   return difference / mag;
+}
+
 // This function compares the difference in the formation of the GetGradient operator and then multiplying it
 // by the necessary vector, and the matrix-free partial assembly formulation which avoids forming the matrix.
 // It's been tested on higher order elements and multiple elements. The difference in these two methods
@@ -745,72 +889,1412 @@ double ICExaNLFIntegratorPAVecTest()
    return difference / mag;
 }
 
-template<bool cmat_ones>
-void setCMat(QuadratureFunction &cmat_data)
+// This function compares the global gradient matrix formed by the nonlinear form's element by element
+// assembly with the one formed from our EA kernels by the FullMechOperatorGradAssembler class.
+// The difference in the action of these two matrices should be 0.0.
+template<bool cmat_ones, bool bbar>
+double FullEAAssemblyTest()
 {
-   int npts = cmat_data.Size() / cmat_data.GetVDim();
-   const int dim2 = 6;
+   int dim = 3;
+   int order = 2;
+   mfem::ParMesh *pmesh = nullptr;
+   {
+      // Making this mesh and test real simple with 8 cubic element
+      mfem::Mesh mesh = Mesh::MakeCartesian3D(2, 2, 2, Element::HEXAHEDRON, 1.0, 1.0, 1.0, false);
+      mesh.SetCurvature(order);
+      pmesh = new mfem::ParMesh(MPI_COMM_WORLD, mesh);
+   }
 
-   if (cmat_ones) {
-      cmat_data = 1.0;
+   H1_FECollection fec(order, dim);
+   ParFiniteElementSpace fes(pmesh, &fec, dim);
+
+   // All of these Quadrature function variables are needed to instantiate our material model
+   // We can just ignore this marked section
+   /////////////////////////////////////////////////////////////////////////////////////////
+   // Define a quadrature space and material history variable QuadratureFunction.
+   int intOrder = 2 * order + 1;
+   QuadratureSpace qspace(pmesh, intOrder);
+   QuadratureFunction q_matVars0(&qspace, 1);
+   QuadratureFunction q_matVars1(&qspace, 1);
+   // The assembler also runs the PA setup of our integrators which reads the stress
+   QuadratureFunction q_sigma0(&qspace, 6);
+   QuadratureFunction q_sigma1(&qspace, 6);
+   QuadratureFunction q_matGrad(&qspace, 36);
+   QuadratureFunction q_kinVars0(&qspace, 9);
+   QuadratureFunction q_vonMises(&qspace, 1);
+   ParGridFunction beg_crds(&fes);
+   ParGridFunction end_crds(&fes);
+   // We'll want to update this later in case we do anything more complicated.
+   Vector matProps(1);
+
+   end_crds = 1.0;
+   q_sigma1 = 1.0;
+
+   ExaModel *model;
+   // This doesn't really matter and is just needed for the integrator class.
+   model = new AbaqusUmatModel(&q_sigma0, &q_sigma1, &q_matGrad, &q_matVars0, &q_matVars1, &q_kinVars0,
+                               &beg_crds, &end_crds, &matProps, 1, 1, &fes, Assembly::FULL);
+   // Model time needs to be set.
+   model->SetModelDt(1.0);
+   /////////////////////////////////////////////////////////////////////////////
+   q_matGrad = 0.0;
+   setCMat<cmat_ones>(q_matGrad);
+
+   // The nonlinear form owns the integrator
+   ParNonlinearForm nlf(&fes);
+   if (bbar) {
+      nlf.AddDomainIntegrator(new ICExaNLFIntegrator(model));
    }
    else {
-      const int DIM3 = 3;
-      std::array<RAJA::idx_t, DIM3> perm3 {{ 2, 1, 0 } };
-      // bunch of helper RAJA views to make dealing with data easier down below in our kernel.
-      RAJA::Layout<DIM3> layout_2Dtensor = RAJA::make_permuted_layout({{ dim2, dim2, npts } }, perm3);
-      RAJA::View<double, RAJA::Layout<DIM3, RAJA::Index_type, 0> > cmat(cmat_data.HostReadWrite(), layout_2Dtensor);
-      for (int i = 0; i < npts; i++) {
-         cmat(0, 0, i) = 100.;
-         cmat(1, 1, i) = 100.;
-         cmat(2, 2, i) = 100.;
-         cmat(0, 1, i) = 75.;
-         cmat(1, 0, i) = 75.;
-         cmat(0, 2, i) = 75.;
-         cmat(2, 0, i) = 75.;
-         cmat(1, 2, i) = 75.;
-         cmat(2, 1, i) = 75.;
-         cmat(3, 3, i) = 50.;
-         cmat(4, 4, i) = 50.;
-         cmat(5, 5, i) = 50.;
-      } // end of pa style set ups
-   } // end of cmat set 1 or as cubic material
-}
+      nlf.AddDomainIntegrator(new ExaNLFIntegrator(model));
+   }
 
-TEST(exaconstit, partial_assembly)
-{
-   double difference = ExaNLFIntegratorPATest<false>();
-   std::cout << difference << std::endl;
-   EXPECT_LT(fabs(difference), 1.0e-14) << "Did not get expected value for pa false";
-   difference = ExaNLFIntegratorPATest<true>();
-   std::cout << difference << std::endl;
-   EXPECT_LT(fabs(difference), 1.0e-14) << "Did not get expected value for pa true";
-   difference = ExaNLFIntegratorPAVecTest();
-   std::cout << difference << std::endl;
-   EXPECT_LT(fabs(difference), 2e-14) << "Did not get expected value for pa vec";
-}
+   // Set our field variable to a linear spacing so 1 ... ndofs in field
+   Vector xtrue(fes.GetTrueVSize());
+   for (int i = 0; i < xtrue.Size(); i++) {
+      xtrue(i) = i + 1;
+   }
 
-TEST(exaconstit, ea_assembly)
-{
-   double difference = ExaNLFIntegratorEATest<false>();
-   std::cout << difference << std::endl;
-   EXPECT_LT(fabs(difference), 1.0e-14) << "Did not get expected value for ea false";
-   difference = ExaNLFIntegratorEATest<true>();
-   std::cout << difference << std::endl;
-   EXPECT_LT(fabs(difference), 1.0e-14) << "Did not get expected value for ea true";
+   Vector y_fa(fes.GetTrueVSize());
+   Vector y_ea(fes.GetTrueVSize());
+
+   Operator &grad_fa = nlf.GetGradient(xtrue);
+   grad_fa.Mult(xtrue, y_fa);
+
+   FullMechOperatorGradAssembler ea_assembler(&nlf);
+   HypreParMatrix &grad_ea = ea_assembler.Assemble();
+   grad_ea.Mult(xtrue, y_ea);
+
+   // Find out how different our solutions were from one another.
+   double mag = y_fa.Norml2();
+   std::cout << "y_fa mag: " << mag << std::endl;
+   y_fa -= y_ea;
+   double difference = y_fa.Norml2();
+   // Free up memory now.
+   delete model;
+   delete pmesh;
+
+   return difference / mag;
 }
 
-TEST(exaconstit, ic_ea_assembly)
+// This function compares the action and diagonal of our EA gradient operator with those of the
+// fully assembled gradient operator when our material tangent is symmetric. The EA operator then
+// only stores the packed upper triangle of each element matrix. The differences between the two
+// should be 0.0 to round-off. packed is set to whether the packed storage was actually used.
+template<bool cmat_ones>
+double EASymmetricTest(double &diag_diff, bool &packed)
 {
-   double difference = ICExaNLFIntegratorEATest<false>();
-   std::cout << difference << std::endl;
-   EXPECT_LT(fabs(difference), 1.0e-14) << "Did not get expected value for ea false";
-   difference = ICExaNLFIntegratorEATest<true>();
-   std::cout << difference << std::endl;
-   EXPECT_LT(fabs(difference), 1.0e-14) << "Did not get expected value for ea true";
-   difference = ICExaNLFIntegratorPAVecTest();
-   std::cout << difference << std::endl;
-   EXPECT_LT(fabs(difference), 2e-14) << "Did not get expected value for pa vec";
+   int dim = 3;
+   int order = 2;
+   mfem::ParMesh *pmesh = nullptr;
+   {
+      mfem::Mesh mesh = Mesh::MakeCartesian3D(2, 2, 2, Element::HEXAHEDRON, 1.0, 1.0, 1.0, false);
+      mesh.SetCurvature(order);
+      pmesh = new mfem::ParMesh(MPI_COMM_WORLD, mesh);
+   }
+
+   H1_FECollection fec(order, dim);
+   ParFiniteElementSpace fes(pmesh, &fec, dim);
+
+   // All of these Quadrature function variables are needed to instantiate our material model
+   // We can just ignore this marked section
+   /////////////////////////////////////////////////////////////////////////////////////////
+   int intOrder = 2 * order + 1;
+   QuadratureSpace qspace(pmesh, intOrder);
+   QuadratureFunction q_matVars0(&qspace, 1);
+   QuadratureFunction q_matVars1(&qspace, 1);
+   // Our EA operator also runs the PA setup of our integrators which reads the stress
+   QuadratureFunction q_sigma0(&qspace, 6);
+   QuadratureFunction q_sigma1(&qspace, 6);
+   QuadratureFunction q_matGrad(&qspace, 36);
+   QuadratureFunction q_kinVars0(&qspace, 9);
+   QuadratureFunction q_vonMises(&qspace, 1);
+   ParGridFunction beg_crds(&fes);
+   ParGridFunction end_crds(&fes);
+   Vector matProps(1);
+
+   end_crds = 1.0;
+   q_sigma1 = 1.0;
+
+   // Our symmetric tangent is what lets the EA operator use its packed storage
+   ExaModel *model;
+   model = new test_model(&q_sigma0, &q_sigma1, &q_matGrad, &q_matVars0, &q_matVars1,
+                          &beg_crds, &end_crds, &matProps, 1, 1, Assembly::EA, true);
+   // Model time needs to be set.
+   model->SetModelDt(1.0);
+   /////////////////////////////////////////////////////////////////////////////
+   q_matGrad = 0.0;
+   setCMat<cmat_ones>(q_matGrad);
+
+   // The nonlinear form owns the integrator
+   ParNonlinearForm nlf(&fes);
+   nlf.AddDomainIntegrator(new ExaNLFIntegrator(model));
+
+   Vector xtrue(fes.GetTrueVSize());
+   for (int i = 0; i < xtrue.Size(); i++) {
+      xtrue(i) = i + 1;
+   }
+
+   Vector y_fa(fes.GetTrueVSize());
+   Vector y_ea(fes.GetTrueVSize());
+   Vector diag_fa(fes.GetTrueVSize());
+   Vector diag_ea(fes.GetTrueVSize());
+
+   HypreParMatrix *grad_fa = dynamic_cast<HypreParMatrix *>(&nlf.GetGradient(xtrue));
+   grad_fa->Mult(xtrue, y_fa);
+   grad_fa->GetDiag(diag_fa);
+
+   Array<int> ess_tdofs;
+   EANonlinearMechOperatorGradExt grad_ea(&nlf, ess_tdofs);
+   grad_ea.Assemble();
+   grad_ea.Mult(xtrue, y_ea);
+   grad_ea.AssembleDiagonal(diag_ea);
+   packed = grad_ea.PackedStorage();
+
+   double mag = y_fa.Norml2();
+   std::cout << "y_fa mag: " << mag << std::endl;
+   y_fa -= y_ea;
+   double difference = y_fa.Norml2();
+
+   const double diag_mag = diag_fa.Norml2();
+   diag_fa -= diag_ea;
+   diag_diff = diag_fa.Norml2() / diag_mag;
+   // Free up memory now.
+   delete model;
+   delete pmesh;
+
+   return difference / mag;
+}
+
+// For linear elements our LOR approximation of the gradient operator should be identical
+// to the gradient operator formed by the nonlinear form, since the element averaged
+// material tangent is constant here. The difference in the action of the two should be 0.0.
+template<bool cmat_ones>
+double LORAMGTest()
+{
+   int dim = 3;
+   int order = 1;
+   mfem::ParMesh *pmesh = nullptr;
+   {
+      mfem::Mesh mesh = Mesh::MakeCartesian3D(2, 2, 2, Element::HEXAHEDRON, 1.0, 1.0, 1.0, false);
+      mesh.SetCurvature(order);
+      pmesh = new mfem::ParMesh(MPI_COMM_WORLD, mesh);
+   }
+
+   H1_FECollection fec(order, dim);
+   ParFiniteElementSpace fes(pmesh, &fec, dim);
+
+   // All of these Quadrature function variables are needed to instantiate our material model
+   // We can just ignore this marked section
+   /////////////////////////////////////////////////////////////////////////////////////////
+   int intOrder = 2 * order + 1;
+   QuadratureSpace qspace(pmesh, intOrder);
+   QuadratureFunction q_matVars0(&qspace, 1);
+   QuadratureFunction q_matVars1(&qspace, 1);
+   QuadratureFunction q_sigma0(&qspace, 1);
+   QuadratureFunction q_sigma1(&qspace, 1);
+   QuadratureFunction q_matGrad(&qspace, 36);
+   QuadratureFunction q_kinVars0(&qspace, 9);
+   QuadratureFunction q_vonMises(&qspace, 1);
+   ParGridFunction beg_crds(&fes);
+   ParGridFunction end_crds(&fes);
+   Vector matProps(1);
+
+   // Our LOR sub-elements make use of the current nodal coordinates
+   VectorFunctionCoefficient crds_coeff(dim, [](const Vector &x, Vector &y) { y = x; });
+   end_crds.ProjectCoefficient(crds_coeff);
+
+   ExaModel *model;
+   model = new AbaqusUmatModel(&q_sigma0, &q_sigma1, &q_matGrad, &q_matVars0, &q_matVars1, &q_kinVars0,
+                               &beg_crds, &end_crds, &matProps, 1, 1, &fes, Assembly::PA);
+   // Model time needs to be set.
+   model->SetModelDt(1.0);
+   /////////////////////////////////////////////////////////////////////////////
+   q_matGrad = 0.0;
+   setCMat<cmat_ones>(q_matGrad);
+
+   // The nonlinear form owns the integrator
+   ParNonlinearForm nlf(&fes);
+   nlf.AddDomainIntegrator(new ExaNLFIntegrator(model));
+
+   Vector xtrue(fes.GetTrueVSize());
+   for (int i = 0; i < xtrue.Size(); i++) {
+      xtrue(i) = i + 1;
+   }
+
+   Vector y_fa(fes.GetTrueVSize());
+   Vector y_lor(fes.GetTrueVSize());
+
+   Operator &grad_fa = nlf.GetGradient(xtrue);
+   grad_fa.Mult(xtrue, y_fa);
+
+   Array<int> ess_tdofs;
+   Vector diag;
+   MechOperatorLORAMG lor_prec(fes, model, end_crds, ess_tdofs);
+   lor_prec.Update(grad_fa, diag);
+   lor_prec.GetLORMatrix()->Mult(xtrue, y_lor);
+
+   double mag = y_fa.Norml2();
+   std::cout << "y_fa mag: " << mag << std::endl;
+   y_fa -= y_lor;
+   double difference = y_fa.Norml2();
+   // Free up memory now.
+   delete model;
+   delete pmesh;
+
+   return difference / mag;
+}
+
+// For quadratic elements our GLL nodes sit at {0, 0.5, 1} of each element, so the LOR sub-elements
+// are the elements of our mesh refined uniformly once. With a constant material tangent our LOR
+// matrix should then be identical to the gradient operator of linear elements on that refined mesh.
+// The dofs of the two are matched up through their nodal coordinates, and the largest difference
+// in their entries relative to the largest entry is returned, which should be 0.0 to round-off.
+template<bool cmat_ones>
+double LORAMGRefinedTest()
+{
+   int dim = 3;
+   int order = 2;
+   mfem::ParMesh *pmesh = nullptr;
+   mfem::ParMesh *pmesh_ref = nullptr;
+   {
+      mfem::Mesh mesh = Mesh::MakeCartesian3D(2, 2, 2, Element::HEXAHEDRON, 1.0, 1.0, 1.0, false);
+      mfem::Mesh mesh_ref(mesh);
+      mesh_ref.UniformRefinement();
+      mesh.SetCurvature(order);
+      mesh_ref.SetCurvature(1);
+      pmesh = new mfem::ParMesh(MPI_COMM_WORLD, mesh);
+      pmesh_ref = new mfem::ParMesh(MPI_COMM_WORLD, mesh_ref);
+   }
+
+   H1_FECollection fec(order, dim);
+   ParFiniteElementSpace fes(pmesh, &fec, dim);
+   H1_FECollection fec_ref(1, dim);
+   ParFiniteElementSpace fes_ref(pmesh_ref, &fec_ref, dim);
+
+   // All of these Quadrature function variables are needed to instantiate our material models
+   // We can just ignore this marked section
+   /////////////////////////////////////////////////////////////////////////////////////////
+   QuadratureSpace qspace(pmesh, 2 * order + 1);
+   QuadratureFunction q_matVars0(&qspace, 1);
+   QuadratureFunction q_matVars1(&qspace, 1);
+   QuadratureFunction q_sigma0(&qspace, 1);
+   QuadratureFunction q_sigma1(&qspace, 1);
+   QuadratureFunction q_matGrad(&qspace, 36);
+   QuadratureFunction q_kinVars0(&qspace, 9);
+   ParGridFunction beg_crds(&fes);
+   ParGridFunction end_crds(&fes);
+
+   QuadratureSpace qspace_ref(pmesh_ref, 3);
+   QuadratureFunction q_matVars0_ref(&qspace_ref, 1);
+   QuadratureFunction q_matVars1_ref(&qspace_ref, 1);
+   QuadratureFunction q_sigma0_ref(&qspace_ref, 1);
+   QuadratureFunction q_sigma1_ref(&qspace_ref, 1);
+   QuadratureFunction q_matGrad_ref(&qspace_ref, 36);
+   QuadratureFunction q_kinVars0_ref(&qspace_ref, 9);
+   ParGridFunction beg_crds_ref(&fes_ref);
+   ParGridFunction end_crds_ref(&fes_ref);
+   Vector matProps(1);
+
+   // Our LOR sub-elements make use of the current nodal coordinates
+   VectorFunctionCoefficient crds_coeff(dim, [](const Vector &x, Vector &y) { y = x; });
+   end_crds.ProjectCoefficient(crds_coeff);
+   end_crds_ref.ProjectCoefficient(crds_coeff);
+
+   ExaModel *model = new AbaqusUmatModel(&q_sigma0, &q_sigma1, &q_matGrad, &q_matVars0, &q_matVars1,
+                                         &q_kinVars0, &beg_crds, &end_crds, &matProps, 1, 1, &fes,
+                                         Assembly::PA);
+   ExaModel *model_ref = new AbaqusUmatModel(&q_sigma0_ref, &q_sigma1_ref, &q_matGrad_ref, &q_matVars0_ref,
+                                             &q_matVars1_ref, &q_kinVars0_ref, &beg_crds_ref, &end_crds_ref,
+                                             &matProps, 1, 1, &fes_ref, Assembly::FULL);
+   // Model time needs to be set.
+   model->SetModelDt(1.0);
+   model_ref->SetModelDt(1.0);
+   /////////////////////////////////////////////////////////////////////////////
+   q_matGrad = 0.0;
+   setCMat<cmat_ones>(q_matGrad);
+   q_matGrad_ref = 0.0;
+   setCMat<cmat_ones>(q_matGrad_ref);
+
+   Array<int> ess_tdofs;
+   Vector diag;
+   MechOperatorLORAMG lor_prec(fes, model, end_crds, ess_tdofs);
+   // Our LOR preconditioner doesn't make use of the gradient operator itself
+   lor_prec.Update(IdentityOperator(fes.GetTrueVSize()), diag);
+   SparseMatrix lor_diag;
+   lor_prec.GetLORMatrix()->GetDiag(lor_diag);
+   DenseMatrix lor_dense;
+   lor_diag.ToDenseMatrix(lor_dense);
+
+   // The nonlinear form owns the integrator
+   ParNonlinearForm nlf_ref(&fes_ref);
+   nlf_ref.AddDomainIntegrator(new ExaNLFIntegrator(model_ref));
+   Vector xtrue_ref(fes_ref.GetTrueVSize());
+   xtrue_ref = 1.0;
+   HypreParMatrix *grad_ref = dynamic_cast<HypreParMatrix *>(&nlf_ref.GetGradient(xtrue_ref));
+   SparseMatrix ref_diag;
+   grad_ref->GetDiag(ref_diag);
+   DenseMatrix ref_dense;
+   ref_diag.ToDenseMatrix(ref_dense);
+
+   // Both of our spaces are ordered byNODES and our nodes lie on a grid with a spacing of 0.25
+   const int nnodes = fes.GetNDofs();
+   const int nnodes_ref = fes_ref.GetNDofs();
+   auto node_key = [](const ParGridFunction &crds, const int nnodes, const int i) {
+      int key = 0;
+      for (int d = 2; d >= 0; d--) {
+         key = 5 * key + (int) std::lround(4.0 * crds(i + d * nnodes));
+      }
+      return key;
+   };
+   std::vector<int> key_to_ref(125, -1);
+   for (int i = 0; i < nnodes_ref; i++) {
+      key_to_ref[node_key(end_crds_ref, nnodes_ref, i)] = i;
+   }
+   Array<int> perm(3 * nnodes);
+   for (int i = 0; i < nnodes; i++) {
+      const int iref = key_to_ref[node_key(end_crds, nnodes, i)];
+      MFEM_VERIFY(iref >= 0, "LOR node was not found in the refined mesh");
+      for (int d = 0; d < dim; d++) {
+         perm[i + d * nnodes] = iref + d * nnodes_ref;
+      }
+   }
+
+   double difference = 0.0;
+   double mag = 0.0;
+   for (int j = 0; j < 3 * nnodes; j++) {
+      for (int i = 0; i < 3 * nnodes; i++) {
+         difference = std::max(difference, fabs(lor_dense(i, j) - ref_dense(perm[i], perm[j])));
+         mag = std::max(mag, fabs(ref_dense(perm[i], perm[j])));
+      }
+   }
+   // Free up memory now.
+   delete model;
+   delete model_ref;
+   delete pmesh;
+   delete pmesh_ref;
+
+   return difference / mag;
+}
+
+// For linear elements on an undeformed mesh with a constant material tangent the coarse
+// operator rediscretized by our geometric multigrid should be identical to the Galerkin
+// product P^T A P of the gradient operator formed by the nonlinear form.
+// The difference in the action of the two should be 0.0.
+template<bool cmat_ones>
+double GMGCoarseTest()
+{
+   int dim = 3;
+   int order = 1;
+   mfem::ParMesh *coarse_pmesh = nullptr;
+   {
+      mfem::Mesh mesh = Mesh::MakeCartesian3D(2, 2, 2, Element::HEXAHEDRON, 1.0, 1.0, 1.0, false);
+      mesh.SetCurvature(order);
+      coarse_pmesh = new mfem::ParMesh(MPI_COMM_WORLD, mesh);
+   }
+   // Our fine mesh needs to be refined from a copy of our coarse one
+   mfem::ParMesh *pmesh = new mfem::ParMesh(*coarse_pmesh);
+   pmesh->UniformRefinement();
+   Array<ParMesh*> coarse_meshes;
+   coarse_meshes.Append(coarse_pmesh);
+
+   H1_FECollection fec(order, dim);
+   ParFiniteElementSpace fes(pmesh, &fec, dim);
+
+   // All of these Quadrature function variables are needed to instantiate our material model
+   // We can just ignore this marked section
+   /////////////////////////////////////////////////////////////////////////////////////////
+   int intOrder = 2 * order + 1;
+   QuadratureSpace qspace(pmesh, intOrder);
+   QuadratureFunction q_matVars0(&qspace, 1);
+   QuadratureFunction q_matVars1(&qspace, 1);
+   QuadratureFunction q_sigma0(&qspace, 1);
+   QuadratureFunction q_sigma1(&qspace, 1);
+   QuadratureFunction q_matGrad(&qspace, 36);
+   QuadratureFunction q_kinVars0(&qspace, 9);
+   QuadratureFunction q_vonMises(&qspace, 1);
+   ParGridFunction beg_crds(&fes);
+   ParGridFunction end_crds(&fes);
+   Vector matProps(1);
+
+   // Our coarse level coordinates are interpolated from the current nodal coordinates
+   VectorFunctionCoefficient crds_coeff(dim, [](const Vector &x, Vector &y) { y = x; });
+   end_crds.ProjectCoefficient(crds_coeff);
+
+   ExaModel *model;
+   model = new AbaqusUmatModel(&q_sigma0, &q_sigma1, &q_matGrad, &q_matVars0, &q_matVars1, &q_kinVars0,
+                               &beg_crds, &end_crds, &matProps, 1, 1, &fes, Assembly::PA);
+   // Model time needs to be set.
+   model->SetModelDt(1.0);
+   /////////////////////////////////////////////////////////////////////////////
+   q_matGrad = 0.0;
+   setCMat<cmat_ones>(q_matGrad);
+
+   // The nonlinear form owns the integrator
+   ParNonlinearForm nlf(&fes);
+   nlf.AddDomainIntegrator(new ExaNLFIntegrator(model));
+
+   Vector xtrue(fes.GetTrueVSize());
+   xtrue = 0.0;
+   Operator &grad_fa = nlf.GetGradient(xtrue);
+
+   // No essential BCs are applied to any of our levels
+   Array<int> ess_tdofs;
+   Array<int> ess_bdr(pmesh->bdr_attributes.Max());
+   ess_bdr = 0;
+   Array2D<bool> ess_bdr_comps(pmesh->bdr_attributes.Max(), dim);
+   ess_bdr_comps = false;
+   Vector diag(fes.GetTrueVSize());
+   diag = 1.0;
+
+   double mag, difference;
+   // Our multigrid preconditioner needs to be cleaned up before our coarse mesh
+   {
+      MechOperatorGMG gmg(fes, model, end_crds, ess_tdofs, coarse_meshes, ess_bdr, ess_bdr_comps, 1);
+      gmg.Update(grad_fa, diag);
+
+      const Operator *prolong = gmg.GetLevelProlongation(0);
+      Vector xc(prolong->Width());
+      for (int i = 0; i < xc.Size(); i++) {
+         xc(i) = i + 1;
+      }
+      Vector px(prolong->Height());
+      Vector apx(prolong->Height());
+      Vector y_gal(prolong->Width());
+      Vector y_gmg(prolong->Width());
+
+      prolong->Mult(xc, px);
+      grad_fa.Mult(px, apx);
+      prolong->MultTranspose(apx, y_gal);
+      gmg.GetLevelMatrix(0)->Mult(xc, y_gmg);
+
+      mag = y_gal.Norml2();
+      std::cout << "y_gal mag: " << mag << std::endl;
+      y_gal -= y_gmg;
+      difference = y_gal.Norml2();
+   }
+   // Free up memory now.
+   delete model;
+   delete pmesh;
+   delete coarse_pmesh;
+
+   return difference / mag;
+}
+
+// This function compares the lower order operators of our p-multigrid preconditioner
+// against the Galerkin products P^T A P of our fine gradient operator. Our lower order
+// spaces are nested within our fine one, and their operators are evaluated at the same
+// quadrature points with the same tangent stiffness so the two should agree.
+template<bool cmat_ones>
+double PMGLevelTest()
+{
+   int dim = 3;
+   int order = 3;
+   mfem::ParMesh *pmesh = nullptr;
+   {
+      mfem::Mesh mesh = Mesh::MakeCartesian3D(1, 1, 1, Element::HEXAHEDRON, 1.0, 1.0, 1.0, false);
+      mesh.SetCurvature(order);
+      pmesh = new mfem::ParMesh(MPI_COMM_WORLD, mesh);
+   }
+
+   H1_FECollection fec(order, dim);
+   ParFiniteElementSpace fes(pmesh, &fec, dim);
+
+   // All of these Quadrature function variables are needed to instantiate our material model
+   // We can just ignore this marked section
+   /////////////////////////////////////////////////////////////////////////////////////////
+   int intOrder = 2 * order + 1;
+   QuadratureSpace qspace(pmesh, intOrder);
+   QuadratureFunction q_matVars0(&qspace, 1);
+   QuadratureFunction q_matVars1(&qspace, 1);
+   QuadratureFunction q_sigma0(&qspace, 1);
+   QuadratureFunction q_sigma1(&qspace, 1);
+   QuadratureFunction q_matGrad(&qspace, 36);
+   QuadratureFunction q_kinVars0(&qspace, 9);
+   QuadratureFunction q_vonMises(&qspace, 1);
+   ParGridFunction beg_crds(&fes);
+   ParGridFunction end_crds(&fes);
+   Vector matProps(1);
+   end_crds = 1.0;
+
+   ExaModel *model;
+   model = new AbaqusUmatModel(&q_sigma0, &q_sigma1, &q_matGrad, &q_matVars0, &q_matVars1, &q_kinVars0,
+                               &beg_crds, &end_crds, &matProps, 1, 1, &fes, Assembly::PA);
+   // Model time needs to be set.
+   model->SetModelDt(1.0);
+   /////////////////////////////////////////////////////////////////////////////
+   q_matGrad = 0.0;
+   setCMat<cmat_ones>(q_matGrad);
+   // This takes our 2d cmat and transforms it into the 4d version
+   model->TransformMatGradTo4D();
+
+   // Our lower order levels need the jacobian in the same layout as the NonlinearMechOperator
+   const IntegrationRule &ir = IntRules.Get(fes.GetFE(0)->GetGeomType(), intOrder);
+   const int nqpts = ir.GetNPoints();
+   const int nelems = fes.GetNE();
+   Vector el_jac(dim * dim * nqpts * nelems);
+   {
+      const GeometricFactors *geom = pmesh->GetGeometricFactors(ir, GeometricFactors::JACOBIANS);
+      const double *geom_j = geom->J.HostRead();
+      double *jac = el_jac.HostWrite();
+      for (int i = 0; i < nelems; i++) {
+         for (int j = 0; j < nqpts; j++) {
+            for (int k = 0; k < dim; k++) {
+               for (int l = 0; l < dim; l++) {
+                  jac[l + dim * (k + dim * (j + nqpts * i))] = geom_j[j + nqpts * (l + dim * (k + dim * i))];
+               }
+            }
+         }
+      }
+   }
+
+   // The nonlinear form owns the integrator
+   ParNonlinearForm nlf(&fes);
+   nlf.AddDomainIntegrator(new ExaNLFIntegrator(model));
+
+   Vector xtrue(fes.GetTrueVSize());
+   xtrue = 0.0;
+   Operator &grad_fa = nlf.GetGradient(xtrue);
+
+   // No essential BCs are applied to any of our levels
+   Array<int> ess_tdofs;
+   Array<int> ess_bdr(pmesh->bdr_attributes.Max());
+   ess_bdr = 0;
+   Array2D<bool> ess_bdr_comps(pmesh->bdr_attributes.Max(), dim);
+   ess_bdr_comps = false;
+   Vector diag(fes.GetTrueVSize());
+   diag = 1.0;
+
+   double mag = 0.0;
+   double difference = 0.0;
+   {
+      MechOperatorPMG pmg(fes, model, el_jac, ess_tdofs, ess_bdr, ess_bdr_comps, AssemblyLevel::PARTIAL, 1);
+      pmg.Update(grad_fa, diag);
+
+      // Compare each of our lower order levels to the Galerkin product of our fine operator
+      // formed by prolongating all the way up to our fine level.
+      for (int lev = pmg.GetNumLevels() - 2; lev >= 0; lev--) {
+         Vector xc(pmg.GetLevelOperator(lev)->Width());
+         for (int i = 0; i < xc.Size(); i++) {
+            xc(i) = i + 1;
+         }
+         Vector y_pmg(xc.Size());
+         pmg.GetLevelOperator(lev)->Mult(xc, y_pmg);
+
+         Vector px(xc);
+         for (int l = lev; l < pmg.GetNumLevels() - 1; l++) {
+            Vector tmp(pmg.GetLevelProlongation(l)->Height());
+            pmg.GetLevelProlongation(l)->Mult(px, tmp);
+            px = tmp;
+         }
+         Vector apx(px.Size());
+         grad_fa.Mult(px, apx);
+         for (int l = pmg.GetNumLevels() - 2; l >= lev; l--) {
+            Vector tmp(pmg.GetLevelProlongation(l)->Width());
+            pmg.GetLevelProlongation(l)->MultTranspose(apx, tmp);
+            apx = tmp;
+         }
+
+         const double lev_mag = apx.Norml2();
+         std::cout << "y_gal mag: " << lev_mag << std::endl;
+         apx -= y_pmg;
+         mag += lev_mag;
+         difference += apx.Norml2();
+      }
+   }
+   // Free up memory now.
+   delete model;
+   delete pmesh;
+
+   return difference / mag;
+}
+
+// This function checks the largest eigenvalue estimate of our Chebyshev smoother against
+// a long run of the power method, and it makes sure that a second setup of the smoother
+// with the same operator reuses its previous eigenvector.
+double ChebyshevEigTest(int &reuse_iters)
+{
+   int dim = 3;
+   int order = 2;
+   mfem::ParMesh *pmesh = nullptr;
+   {
+      mfem::Mesh mesh = Mesh::MakeCartesian3D(2, 2, 2, Element::HEXAHEDRON, 1.0, 1.0, 1.0, false);
+      mesh.SetCurvature(order);
+      pmesh = new mfem::ParMesh(MPI_COMM_WORLD, mesh);
+   }
+
+   H1_FECollection fec(order, dim);
+   ParFiniteElementSpace fes(pmesh, &fec, dim);
+
+   // All of these Quadrature function variables are needed to instantiate our material model
+   // We can just ignore this marked section
+   /////////////////////////////////////////////////////////////////////////////////////////
+   int intOrder = 2 * order + 1;
+   QuadratureSpace qspace(pmesh, intOrder);
+   QuadratureFunction q_matVars0(&qspace, 1);
+   QuadratureFunction q_matVars1(&qspace, 1);
+   QuadratureFunction q_sigma0(&qspace, 1);
+   QuadratureFunction q_sigma1(&qspace, 1);
+   QuadratureFunction q_matGrad(&qspace, 36);
+   QuadratureFunction q_kinVars0(&qspace, 9);
+   QuadratureFunction q_vonMises(&qspace, 1);
+   ParGridFunction beg_crds(&fes);
+   ParGridFunction end_crds(&fes);
+   Vector matProps(1);
+   end_crds = 1.0;
+
+   ExaModel *model;
+   model = new AbaqusUmatModel(&q_sigma0, &q_sigma1, &q_matGrad, &q_matVars0, &q_matVars1, &q_kinVars0,
+                               &beg_crds, &end_crds, &matProps, 1, 1, &fes, Assembly::PA);
+   // Model time needs to be set.
+   model->SetModelDt(1.0);
+   /////////////////////////////////////////////////////////////////////////////
+   q_matGrad = 0.0;
+   setCMat<false>(q_matGrad);
+
+   // The nonlinear form owns the integrator
+   ParNonlinearForm nlf(&fes);
+   nlf.AddDomainIntegrator(new ExaNLFIntegrator(model));
+
+   Vector xtrue(fes.GetTrueVSize());
+   xtrue = 0.0;
+   Operator &grad_fa = nlf.GetGradient(xtrue);
+   Vector diag(fes.GetTrueVSize());
+   grad_fa.AssembleDiagonal(diag);
+
+   Array<int> ess_tdofs;
+   MechOperatorChebyshevSmoother cheb(MPI_COMM_WORLD, diag, ess_tdofs, 3, 10, 30.0);
+   cheb.SetOperator(grad_fa);
+   cheb.Setup(diag);
+   const double est_eig = cheb.GetMaxEigEstimate();
+   cheb.Setup(diag);
+   reuse_iters = cheb.GetNumPowerIterations();
+
+   // A long run of the power method on D^{-1} A
+   Vector v(fes.GetTrueVSize());
+   Vector av(fes.GetTrueVSize());
+   v.Randomize(2);
+   double max_eig = 0.0;
+   for (int it = 0; it < 500; it++) {
+      v /= sqrt(InnerProduct(MPI_COMM_WORLD, v, v));
+      grad_fa.Mult(v, av);
+      for (int i = 0; i < av.Size(); i++) {
+         av(i) /= diag(i);
+      }
+      max_eig = sqrt(InnerProduct(MPI_COMM_WORLD, av, av));
+      v = av;
+   }
+   std::cout << "max eig: " << max_eig << std::endl;
+
+   // Free up memory now.
+   delete model;
+   delete pmesh;
+
+   return fabs(est_eig - max_eig) / max_eig;
+}
+
+// Shears our unit cube and then perturbs it a bit, so that the Jacobian of our elements is
+// neither diagonal nor symmetric and varies from point to point.
+void ShearPerturbMesh(const Vector &x, Vector &y)
+{
+   y.SetSize(x.Size());
+   y(0) = x(0) + 0.3 * x(1) + 0.1 * x(2) + 0.05 * sin(M_PI * x(1)) * x(2);
+   y(1) = x(1) + 0.2 * x(2) + 0.04 * sin(M_PI * x(0));
+   y(2) = x(2) + 0.15 * x(0) + 0.03 * x(0) * x(1);
+}
+
+// This function checks that the nodal blocks inverted by our block-Jacobi preconditioner
+// match the 3x3 nodal blocks of our fully assembled gradient matrix by applying the
+// assembled blocks to the output of the preconditioner. Our mesh is sheared and perturbed
+// so that the mapping to the physical gradients is exercised in full.
+template<bool bbar>
+double BlockJacobiTest()
+{
+   int dim = 3;
+   int order = 2;
+   mfem::ParMesh *pmesh = nullptr;
+   {
+      mfem::Mesh mesh = Mesh::MakeCartesian3D(2, 2, 2, Element::HEXAHEDRON, 1.0, 1.0, 1.0, false);
+      mesh.SetCurvature(order);
+      mesh.Transform(ShearPerturbMesh);
+      pmesh = new mfem::ParMesh(MPI_COMM_WORLD, mesh);
+   }
+
+   H1_FECollection fec(order, dim);
+   ParFiniteElementSpace fes(pmesh, &fec, dim);
+
+   // All of these Quadrature function variables are needed to instantiate our material model
+   // We can just ignore this marked section
+   /////////////////////////////////////////////////////////////////////////////////////////
+   int intOrder = 2 * order + 1;
+   QuadratureSpace qspace(pmesh, intOrder);
+   QuadratureFunction q_matVars0(&qspace, 1);
+   QuadratureFunction q_matVars1(&qspace, 1);
+   QuadratureFunction q_sigma0(&qspace, 1);
+   QuadratureFunction q_sigma1(&qspace, 1);
+   QuadratureFunction q_matGrad(&qspace, 36);
+   QuadratureFunction q_kinVars0(&qspace, 9);
+   QuadratureFunction q_vonMises(&qspace, 1);
+   ParGridFunction beg_crds(&fes);
+   ParGridFunction end_crds(&fes);
+   Vector matProps(1);
+   end_crds = 1.0;
+   q_sigma1 = 0.0;
+
+   ExaModel *model;
+   model = new AbaqusUmatModel(&q_sigma0, &q_sigma1, &q_matGrad, &q_matVars0, &q_matVars1, &q_kinVars0,
+                               &beg_crds, &end_crds, &matProps, 1, 1, &fes, Assembly::PA);
+   // Model time needs to be set.
+   model->SetModelDt(1.0);
+   /////////////////////////////////////////////////////////////////////////////
+   q_matGrad = 0.0;
+   setCMat<false>(q_matGrad);
+
+   // The nonlinear forms own the integrators
+   ParNonlinearForm nlf_fa(&fes);
+   ParNonlinearForm nlf_pa(&fes);
+   ExaNLFIntegrator *nlf_int;
+   if (bbar) {
+      nlf_fa.AddDomainIntegrator(new ICExaNLFIntegrator(model));
+      nlf_int = new ICExaNLFIntegrator(model);
+   }
+   else {
+      nlf_fa.AddDomainIntegrator(new ExaNLFIntegrator(model));
+      nlf_int = new ExaNLFIntegrator(model);
+   }
+   nlf_pa.AddDomainIntegrator(nlf_int);
+   nlf_int->AssemblePA(fes);
+
+   Vector xtrue(fes.GetTrueVSize());
+   xtrue = 0.0;
+   HypreParMatrix &grad_fa = dynamic_cast<HypreParMatrix&>(nlf_fa.GetGradient(xtrue));
+   SparseMatrix grad_diag;
+   grad_fa.GetDiag(grad_diag);
+
+   Array<int> ess_tdofs;
+   Vector diag(fes.GetTrueVSize());
+   diag = 1.0;
+   MechOperatorBlockJacobi block_jacobi(&nlf_pa, ess_tdofs);
+   block_jacobi.Update(grad_fa, diag);
+
+   Vector x(fes.GetTrueVSize());
+   Vector y(fes.GetTrueVSize());
+   Vector z(fes.GetTrueVSize());
+   for (int i = 0; i < x.Size(); i++) {
+      x(i) = i + 1;
+   }
+   block_jacobi.Mult(x, y);
+
+   // Apply the nodal blocks of our assembled matrix to y which should give us back x
+   const int ntnodes = fes.GetTrueVSize() / dim;
+   const bool by_nodes = (fes.GetOrdering() == Ordering::byNODES);
+   z = 0.0;
+   for (int n = 0; n < ntnodes; n++) {
+      for (int a = 0; a < dim; a++) {
+         const int ia = by_nodes ? n + a * ntnodes : a + dim * n;
+         for (int b = 0; b < dim; b++) {
+            const int ib = by_nodes ? n + b * ntnodes : b + dim * n;
+            z(ia) += grad_diag.Elem(ia, ib) * y(ib);
+         }
+      }
+   }
+
+   double mag = x.Norml2();
+   std::cout << "x mag: " << mag << std::endl;
+   z -= x;
+   double difference = z.Norml2();
+   // Free up memory now.
+   delete model;
+   delete pmesh;
+
+   return difference / mag;
+}
+
+template<bool cmat_ones>
+void setCMat(QuadratureFunction &cmat_data)
+{
+   int npts = cmat_data.Size() / cmat_data.GetVDim();
+   const int dim2 = 6;
+
+   if (cmat_ones) {
+      cmat_data = 1.0;
+   }
+   else {
+      const int DIM3 = 3;
+      std::array<RAJA::idx_t, DIM3> perm3 {{ 2, 1, 0 } };
+      // bunch of helper RAJA views to make dealing with data easier down below in our kernel.
+      RAJA::Layout<DIM3> layout_2Dtensor = RAJA::make_permuted_layout({{ dim2, dim2, npts } }, perm3);
+      RAJA::View<double, RAJA::Layout<DIM3, RAJA::Index_type, 0> > cmat(cmat_data.HostReadWrite(), layout_2Dtensor);
+      for (int i = 0; i < npts; i++) {
+         cmat(0, 0, i) = 100.;
+         cmat(1, 1, i) = 100.;
+         cmat(2, 2, i) = 100.;
+         cmat(0, 1, i) = 75.;
+         cmat(1, 0, i) = 75.;
+         cmat(0, 2, i) = 75.;
+         cmat(2, 0, i) = 75.;
+         cmat(1, 2, i) = 75.;
+         cmat(2, 1, i) = 75.;
+         cmat(3, 3, i) = 50.;
+         cmat(4, 4, i) = 50.;
+         cmat(5, 5, i) = 50.;
+      } // end of pa style set ups
+   } // end of cmat set 1 or as cubic material
+}
+
+// This function solves a few nonsymmetric convection-diffusion like systems with our GCRO
+// solver, where the operator of the last one is slightly perturbed from the others so that
+// our recycled subspace has to be formed again. It returns the largest relative residual of
+// the solves along with the size of the recycled subspace at the end of them.
+double GCRORecycleTest(int &rec_dim)
+{
+   const int n = 100;
+   SparseMatrix A(n);
+   for (int i = 0; i < n; i++) {
+      A.Add(i, i, 2.0);
+      if (i > 0) { A.Add(i, i - 1, -0.7); }
+      if (i < n - 1) { A.Add(i, i + 1, -1.3); }
+   }
+   A.Finalize();
+
+   ExaGCROSolver gcro(MPI_COMM_WORLD);
+   gcro.SetRelTol(1.0e-10);
+   gcro.SetAbsTol(0.0);
+   gcro.SetMaxIter(2000);
+   gcro.SetKDim(10);
+   gcro.SetRecycleDim(5);
+   gcro.SetPrintLevel(-1);
+   gcro.SetOperator(A);
+
+   Vector b(n), x(n), r(n);
+   double max_resid = 0.0;
+   for (int isolve = 0; isolve < 3; isolve++) {
+      if (isolve == 2) {
+         for (int i = 0; i < n; i++) {
+            A.Add(i, i, 1.0e-3);
+         }
+         gcro.SetOperator(A);
+      }
+      b.HostWrite();
+      for (int i = 0; i < n; i++) {
+         b(i) = sin(0.1 * (i + 1) * (isolve + 1));
+      }
+      x = 0.0;
+      gcro.Mult(b, x);
+      A.Mult(x, r);
+      r -= b;
+      max_resid = std::max(max_resid, r.Norml2() / b.Norml2());
+   }
+   rec_dim = gcro.GetRecycledDim();
+   return max_resid;
+}
+
+// This function solves a sequence of nearby shifted 2D Laplacian systems, which resemble the
+// linear systems of successive Newton iterations, with our GCRO solver using a recycled subspace
+// of dimension rdim. It returns the total number of iterations taken by all but the first solve,
+// which should be noticeably less with recycling than without it.
+int GCRORecycleIters(const int rdim)
+{
+   const int m = 20;
+   const int n = m * m;
+   SparseMatrix A(n);
+   for (int iy = 0; iy < m; iy++) {
+      for (int ix = 0; ix < m; ix++) {
+         const int i = ix + m * iy;
+         A.Add(i, i, 4.0);
+         if (ix > 0) { A.Add(i, i - 1, -1.0); }
+         if (ix < m - 1) { A.Add(i, i + 1, -1.0); }
+         if (iy > 0) { A.Add(i, i - m, -1.0); }
+         if (iy < m - 1) { A.Add(i, i + m, -1.0); }
+      }
+   }
+   A.Finalize();
+
+   ExaGCROSolver gcro(MPI_COMM_WORLD);
+   gcro.SetRelTol(1.0e-10);
+   gcro.SetAbsTol(0.0);
+   gcro.SetMaxIter(2000);
+   gcro.SetKDim(10);
+   gcro.SetRecycleDim(rdim);
+   gcro.SetPrintLevel(-1);
+
+   Vector b(n), x(n);
+   int iters = 0;
+   for (int isolve = 0; isolve < 5; isolve++) {
+      if (isolve > 0) {
+         for (int i = 0; i < n; i++) {
+            A.Add(i, i, 1.0e-3);
+         }
+      }
+      gcro.SetOperator(A);
+      b.HostWrite();
+      for (int i = 0; i < n; i++) {
+         b(i) = sin(0.1 * (i + 1) * (1.0 + 0.05 * isolve));
+      }
+      x = 0.0;
+      gcro.Mult(b, x);
+      MFEM_VERIFY(gcro.GetConverged(), "GCRO did not converge");
+      if (isolve > 0) {
+         iters += gcro.GetNumIterations();
+      }
+   }
+   return iters;
+}
+
+// Assembles a shifted Laplacian on our finite element space. Each call returns a new matrix
+// just as each Newton iteration hands our preconditioner a freshly assembled Jacobian.
+HypreParMatrix *AssembleShiftedLaplacian(ParFiniteElementSpace &fes, const double shift)
+{
+   ParBilinearForm a(&fes);
+   ConstantCoefficient shift_coeff(shift);
+   a.AddDomainIntegrator(new DiffusionIntegrator);
+   a.AddDomainIntegrator(new MassIntegrator(shift_coeff));
+   a.Assemble();
+   a.Finalize();
+   return a.ParallelAssemble();
+}
+
+// Our AMG hierarchy is reused across a few freshly assembled operators, where the operator
+// it was set up with is freed before the next one comes in. It returns the largest relative
+// residual of PCG preconditioned by our AMG over all of the solves, and sets nreuse to the
+// number of operators the hierarchy was reused for.
+double ExaBoomerAMGReuseTest(int &nreuse)
+{
+   int dim = 3;
+   mfem::ParMesh *pmesh = nullptr;
+   {
+      mfem::Mesh mesh = Mesh::MakeCartesian3D(4, 4, 4, Element::HEXAHEDRON, 1.0, 1.0, 1.0, false);
+      pmesh = new mfem::ParMesh(MPI_COMM_WORLD, mesh);
+   }
+   H1_FECollection fec(1, dim);
+   ParFiniteElementSpace fes(pmesh, &fec);
+
+   ExaBoomerAMG amg;
+   amg.SetReuse(2, 100.0);
+   amg.SetPrintLevel(0);
+
+   CGSolver pcg(MPI_COMM_WORLD);
+   pcg.SetRelTol(1.0e-10);
+   pcg.SetAbsTol(0.0);
+   pcg.SetMaxIter(500);
+   pcg.SetPrintLevel(-1);
+   pcg.SetPreconditioner(amg);
+
+   Vector b(fes.GetTrueVSize()), x(fes.GetTrueVSize()), r(fes.GetTrueVSize());
+   b = 1.0;
+   double max_resid = 0.0;
+   nreuse = 0;
+   HypreParMatrix *A = nullptr;
+   for (int isolve = 0; isolve < 3; isolve++) {
+      // Our last operator is gone before the new one is handed to our AMG
+      delete A;
+      A = AssembleShiftedLaplacian(fes, 1.0 + 0.01 * isolve);
+      pcg.SetOperator(*A);
+      x = 0.0;
+      pcg.Mult(b, x);
+      A->Mult(x, r);
+      r -= b;
+      max_resid = std::max(max_resid, ParNormlp(r, 2, MPI_COMM_WORLD) / ParNormlp(b, 2, MPI_COMM_WORLD));
+      nreuse = amg.GetNumReuses();
+   }
+   delete A;
+   delete pmesh;
+
+   return max_resid;
+}
+
+// Fills in our per grain state variables at every quadrature point the same way as
+// setStateVarData does, where the grain of each element is its attribute.
+void setGrainStateVars(QuadratureFunction &qf, const Vector &grain_data)
+{
+   QuadratureSpace *qspace = qf.GetSpace();
+   const int vdim = qf.GetVDim();
+   double *qf_data = qf.HostReadWrite();
+   for (int i = 0; i < qspace->GetMesh()->GetNE(); i++) {
+      const IntegrationRule *ir = &(qspace->GetIntRule(i));
+      const int elem_offset = vdim * ir->GetNPoints();
+      const int elem_atr = qspace->GetMesh()->GetAttribute(i) - 1;
+      for (int j = 0; j < ir->GetNPoints(); j++) {
+         for (int k = 0; k < vdim; k++) {
+            qf_data[(elem_offset * i) + vdim * j + k] = grain_data(vdim * elem_atr + k);
+         }
+      }
+   }
+}
+
+// Reordering our mesh along a space-filling curve should only permute our elements. Every element
+// has to keep its grain id, which is its attribute, and with it the state variables that are set
+// from its grain. The elements of the reordered mesh are matched up with the original ones through
+// their centers. The number of elements whose grain id or state variables didn't follow them is
+// returned, and permuted is set to whether the ordering of our elements changed at all.
+int MeshReorderTest(const ElementOrdering ordering, bool &permuted)
+{
+   const int nxyz = 4;
+   const int ngrains = 11;
+   const int nsvars = 3;
+   mfem::Mesh mesh = Mesh::MakeCartesian3D(nxyz, nxyz, nxyz, Element::HEXAHEDRON, 1.0, 1.0, 1.0, false);
+   const int nelems = mesh.GetNE();
+   // Our grain ids are set just as setElementGrainIDs does from a grain map
+   for (int i = 0; i < nelems; i++) {
+      mesh.SetAttribute(i, (7 * i) % ngrains + 1);
+   }
+   mesh.SetAttributes();
+   mfem::Mesh mesh_orig(mesh);
+   reorderMeshLocality(&mesh, ordering);
+
+   mfem::ParMesh *pmesh = new mfem::ParMesh(MPI_COMM_WORLD, mesh);
+   mfem::ParMesh *pmesh_orig = new mfem::ParMesh(MPI_COMM_WORLD, mesh_orig);
+
+   Vector grain_data(nsvars * ngrains);
+   for (int i = 0; i < grain_data.Size(); i++) {
+      grain_data(i) = 0.5 * (i + 1);
+   }
+   QuadratureSpace qspace(pmesh, 3);
+   QuadratureSpace qspace_orig(pmesh_orig, 3);
+   QuadratureFunction q_matVars(&qspace, nsvars);
+   QuadratureFunction q_matVars_orig(&qspace_orig, nsvars);
+   setGrainStateVars(q_matVars, grain_data);
+   setGrainStateVars(q_matVars_orig, grain_data);
+
+   // Our element centers all lie at the middle of a cell of our nxyz^3 grid
+   auto center_key = [nxyz](mfem::Mesh &m, const int ie) {
+      Vector center(3);
+      m.GetElementCenter(ie, center);
+      int key = 0;
+      for (int d = 2; d >= 0; d--) {
+         key = nxyz * key + (int) (nxyz * center(d));
+      }
+      return key;
+   };
+   std::vector<int> key_to_orig(nelems, -1);
+   for (int ie = 0; ie < nelems; ie++) {
+      key_to_orig[center_key(*pmesh_orig, ie)] = ie;
+   }
+
+   int nbad = (pmesh->GetNE() == nelems) ? 0 : nelems;
+   std::vector<int> found(nelems, 0);
+   permuted = false;
+   const int npts = q_matVars.Size() / (nsvars * nelems);
+   const double *mv = q_matVars.HostRead();
+   const double *mv_orig = q_matVars_orig.HostRead();
+   for (int ie = 0; ie < pmesh->GetNE(); ie++) {
+      const int ie_orig = key_to_orig[center_key(*pmesh, ie)];
+      if (ie_orig < 0 || found[ie_orig]) {
+         nbad++;
+         continue;
+      }
+      found[ie_orig] = 1;
+      permuted = permuted || (ie_orig != ie);
+      bool same = (pmesh->GetAttribute(ie) == pmesh_orig->GetAttribute(ie_orig));
+      for (int k = 0; k < npts * nsvars; k++) {
+         same = same && (mv[npts * nsvars * ie + k] == mv_orig[npts * nsvars * ie_orig + k]);
+      }
+      if (!same) {
+         nbad++;
+      }
+   }
+   // Free up memory now.
+   delete pmesh;
+   delete pmesh_orig;
+
+   return nbad;
+}
+
+// When a step fails to converge our auto time stepping rolls everything the step touched
+// back to where it was at the start of the step and retries it with a smaller dt. Here a
+// failed attempt is forced by moving our end coordinates and overwriting our end step stress
+// and state variables, and then the step is rolled back just as SystemDriver::Solve does it.
+// This is repeated so that dt is cut several times in a row. The largest difference between
+// the rolled back and saved states is returned, which should be exactly 0.0, along with how far
+// off the model's dt is from the expected cut dt, and how far the end time of any attempt
+// drifted from the start time of the step plus the dt of that attempt.
+double AutoDtRollbackTest(double &dt_diff, double &time_diff)
+{
+   int dim = 3;
+   int order = 1;
+   mfem::ParMesh *pmesh = nullptr;
+   {
+      mfem::Mesh mesh = Mesh::MakeCartesian3D(2, 2, 2, Element::HEXAHEDRON, 1.0, 1.0, 1.0, false);
+      mesh.SetCurvature(order);
+      pmesh = new mfem::ParMesh(MPI_COMM_WORLD, mesh);
+   }
+
+   H1_FECollection fec(order, dim);
+   ParFiniteElementSpace fes(pmesh, &fec, dim);
+
+   QuadratureSpace qspace(pmesh, 2 * order + 1);
+   QuadratureFunction q_matVars0(&qspace, 4);
+   QuadratureFunction q_matVars1(&qspace, 4);
+   QuadratureFunction q_sigma0(&qspace, 6);
+   QuadratureFunction q_sigma1(&qspace, 6);
+   QuadratureFunction q_matGrad(&qspace, 36);
+   ParGridFunction beg_crds(&fes);
+   ParGridFunction end_crds(&fes);
+   Vector matProps(1);
+
+   VectorFunctionCoefficient crds_coeff(dim, [](const Vector &x, Vector &y) { y = x; });
+   beg_crds.ProjectCoefficient(crds_coeff);
+   end_crds.ProjectCoefficient(crds_coeff);
+   {
+      double *sig = q_sigma1.HostReadWrite();
+      for (int i = 0; i < q_sigma1.Size(); i++) {
+         sig[i] = 0.1 * (i + 1);
+      }
+      double *mv = q_matVars1.HostReadWrite();
+      for (int i = 0; i < q_matVars1.Size(); i++) {
+         mv[i] = -0.2 * (i + 1);
+      }
+   }
+
+   test_model model(&q_sigma0, &q_sigma1, &q_matGrad, &q_matVars0, &q_matVars1,
+                    &beg_crds, &end_crds, &matProps, 1, 4, Assembly::FULL);
+   const double dt = 0.1;
+   const double dt_scale = 0.25;
+   const double dt_min = 1.0e-4;
+   const double t_start = 2.0;
+   const int ncuts = 3;
+   model.SetModelDt(dt);
+
+   Vector sigma_saved(q_sigma1);
+   Vector matVars_saved(q_matVars1);
+   Vector crds_saved(end_crds);
+   model.SaveEndState();
+
+   Vector vel(fes.GetTrueVSize());
+   double dt_step = dt;
+   double t = t_start + dt;
+   time_diff = 0.0;
+   for (int icut = 0; icut < ncuts; icut++) {
+      // Our failed attempt at the step
+      vel = 1.0 + icut;
+      model.UpdateEndCoords(vel);
+      q_sigma1 = 5.0 + icut;
+      q_matVars1 = 3.0 + icut;
+
+      // Our rollback
+      if (!SystemDriver::CutTimeStep(t_start, dt_scale, dt_min, dt_step, t)) {
+         break;
+      }
+      model.RestoreEndState();
+      model.SetModelDt(dt_step);
+      time_diff = std::max(time_diff, fabs(t - (t_start + dt_step)));
+   }
+
+   dt_diff = fabs(model.GetModelDt() - dt * dt_scale * dt_scale * dt_scale);
+
+   double difference = 0.0;
+   sigma_saved -= q_sigma1;
+   difference = std::max(difference, sigma_saved.Normlinf());
+   matVars_saved -= q_matVars1;
+   difference = std::max(difference, matVars_saved.Normlinf());
+   crds_saved -= end_crds;
+   difference = std::max(difference, crds_saved.Normlinf());
+
+   delete pmesh;
+
+   return difference;
+}
+
+TEST(exaconstit, partial_assembly)
+{
+   double difference = ExaNLFIntegratorPATest<false>();
+   std::cout << difference << std::endl;
+   EXPECT_LT(fabs(difference), 1.0e-14) << "Did not get expected value for pa false";
+   difference = ExaNLFIntegratorPATest<true>();
+   std::cout << difference << std::endl;
+   EXPECT_LT(fabs(difference), 1.0e-14) << "Did not get expected value for pa true";
+   // Symmetric material tangents only store the unique entries of the PA tangent
+   difference = ExaNLFIntegratorPATest<false, true>();
+   std::cout << difference << std::endl;
+   EXPECT_LT(fabs(difference), 1.0e-14) << "Did not get expected value for pa sym";
+   difference = ExaNLFIntegratorPAVecTest(6);
+   std::cout << difference << std::endl;
+   EXPECT_LT(fabs(difference), 2e-14) << "Did not get expected value for pa vec";
+   // Lower orders make use of the sum-factorized tensor-product kernels
+   difference = ExaNLFIntegratorPAVecTest(2);
+   std::cout << difference << std::endl;
+   EXPECT_LT(fabs(difference), 2e-14) << "Did not get expected value for pa vec tensor";
+   difference = ExaNLFIntegratorPADiagTest<false>();
+   std::cout << difference << std::endl;
+   EXPECT_LT(fabs(difference), 1.0e-14) << "Did not get expected value for pa diag false";
+   difference = ExaNLFIntegratorPADiagTest<true>();
+   std::cout << difference << std::endl;
+   EXPECT_LT(fabs(difference), 1.0e-14) << "Did not get expected value for pa diag true";
+   difference = ExaNLFIntegratorPADiagTest<false, true>();
+   std::cout << difference << std::endl;
+   EXPECT_LT(fabs(difference), 1.0e-14) << "Did not get expected value for pa diag sym";
+   difference = ExaNLFIntegratorPADiagTest<false, false, true>();
+   std::cout << difference << std::endl;
+   EXPECT_LT(fabs(difference), 1.0e-14) << "Did not get expected value for pa diag fused";
+   difference = ExaNLFIntegratorPADiagTest<false, true, true>();
+   std::cout << difference << std::endl;
+   EXPECT_LT(fabs(difference), 1.0e-14) << "Did not get expected value for pa diag fused sym";
+}
+
+TEST(exaconstit, ea_assembly)
+{
+   double difference = ExaNLFIntegratorEATest<false>();
+   std::cout << difference << std::endl;
+   EXPECT_LT(fabs(difference), 1.0e-14) << "Did not get expected value for ea false";
+   difference = ExaNLFIntegratorEATest<true>();
+   std::cout << difference << std::endl;
+   EXPECT_LT(fabs(difference), 1.0e-14) << "Did not get expected value for ea true";
+}
+
+TEST(exaconstit, ea_sym_assembly)
+{
+   double diag_diff = 0.0;
+   bool packed = false;
+   double difference = EASymmetricTest<false>(diag_diff, packed);
+   std::cout << difference << " " << diag_diff << std::endl;
+   EXPECT_TRUE(packed) << "EA operator did not make use of its packed storage";
+   EXPECT_LT(fabs(difference), 1.0e-14) << "Did not get expected value for ea sym false";
+   EXPECT_LT(fabs(diag_diff), 1.0e-14) << "Did not get expected value for ea sym diag false";
+   difference = EASymmetricTest<true>(diag_diff, packed);
+   std::cout << difference << " " << diag_diff << std::endl;
+   EXPECT_LT(fabs(difference), 1.0e-14) << "Did not get expected value for ea sym true";
+   EXPECT_LT(fabs(diag_diff), 1.0e-14) << "Did not get expected value for ea sym diag true";
+}
+
+TEST(exaconstit, ic_ea_assembly)
+{
+   double difference = ICExaNLFIntegratorEATest<false>();
+   std::cout << difference << std::endl;
+   EXPECT_LT(fabs(difference), 1.0e-14) << "Did not get expected value for ea false";
+   difference = ICExaNLFIntegratorEATest<true>();
+   std::cout << difference << std::endl;
+   EXPECT_LT(fabs(difference), 1.0e-14) << "Did not get expected value for ea true";
+   difference = ICExaNLFIntegratorPAVecTest();
+   std::cout << difference << std::endl;
+   EXPECT_LT(fabs(difference), 2e-14) << "Did not get expected value for pa vec";
+   difference = ExaNLFIntegratorPATest<false, false, true>();
+   std::cout << difference << std::endl;
+   EXPECT_LT(fabs(difference), 1.0e-14) << "Did not get expected value for pa bbar false";
+   difference = ExaNLFIntegratorPATest<true, false, true>();
+   std::cout << difference << std::endl;
+   EXPECT_LT(fabs(difference), 1.0e-14) << "Did not get expected value for pa bbar true";
+}
+
+TEST(exaconstit, lor_amg)
+{
+   double difference = LORAMGTest<false>();
+   std::cout << difference << std::endl;
+   EXPECT_LT(fabs(difference), 1.0e-14) << "Did not get expected value for lor false";
+   difference = LORAMGTest<true>();
+   std::cout << difference << std::endl;
+   EXPECT_LT(fabs(difference), 1.0e-14) << "Did not get expected value for lor true";
+   // Higher orders make use of our sub-element assembly and GLL node mapping
+   difference = LORAMGRefinedTest<false>();
+   std::cout << difference << std::endl;
+   EXPECT_LT(fabs(difference), 1.0e-13) << "Did not get expected value for lor order 2 false";
+   difference = LORAMGRefinedTest<true>();
+   std::cout << difference << std::endl;
+   EXPECT_LT(fabs(difference), 1.0e-13) << "Did not get expected value for lor order 2 true";
+}
+
+TEST(exaconstit, gmg_coarse_operator)
+{
+   double difference = GMGCoarseTest<false>();
+   std::cout << difference << std::endl;
+   EXPECT_LT(fabs(difference), 1.0e-14) << "Did not get expected value for gmg false";
+   difference = GMGCoarseTest<true>();
+   std::cout << difference << std::endl;
+   EXPECT_LT(fabs(difference), 1.0e-14) << "Did not get expected value for gmg true";
+}
+
+TEST(exaconstit, pmg_level_operators)
+{
+   double difference = PMGLevelTest<false>();
+   std::cout << difference << std::endl;
+   EXPECT_LT(fabs(difference), 1.0e-13) << "Did not get expected value for pmg false";
+   difference = PMGLevelTest<true>();
+   std::cout << difference << std::endl;
+   EXPECT_LT(fabs(difference), 1.0e-13) << "Did not get expected value for pmg true";
+}
+
+TEST(exaconstit, chebyshev_eig_estimate)
+{
+   int reuse_iters = 0;
+   double difference = ChebyshevEigTest(reuse_iters);
+   std::cout << difference << std::endl;
+   EXPECT_LT(fabs(difference), 5.0e-2) << "Did not get expected value for chebyshev eig estimate";
+   EXPECT_LE(reuse_iters, 2) << "Chebyshev eig estimate did not reuse its previous eigenvector";
+}
+
+TEST(exaconstit, block_jacobi)
+{
+   double difference = BlockJacobiTest<false>();
+   std::cout << difference << std::endl;
+   EXPECT_LT(fabs(difference), 1.0e-12) << "Did not get expected value for block jacobi false";
+   difference = BlockJacobiTest<true>();
+   std::cout << difference << std::endl;
+   EXPECT_LT(fabs(difference), 1.0e-12) << "Did not get expected value for block jacobi bbar";
+}
+
+TEST(exaconstit, full_ea_assembly)
+{
+   double difference = FullEAAssemblyTest<false, false>();
+   std::cout << difference << std::endl;
+   EXPECT_LT(fabs(difference), 1.0e-14) << "Did not get expected value for full ea false";
+   difference = FullEAAssemblyTest<true, false>();
+   std::cout << difference << std::endl;
+   EXPECT_LT(fabs(difference), 1.0e-14) << "Did not get expected value for full ea true";
+   difference = FullEAAssemblyTest<false, true>();
+   std::cout << difference << std::endl;
+   EXPECT_LT(fabs(difference), 1.0e-14) << "Did not get expected value for full ea bbar";
+}
+
+TEST(exaconstit, gcro_recycling)
+{
+   int rec_dim = 0;
+   double difference = GCRORecycleTest(rec_dim);
+   std::cout << difference << std::endl;
+   EXPECT_LT(fabs(difference), 1.0e-9) << "GCRO did not converge to the expected tolerance";
+   EXPECT_EQ(rec_dim, 5) << "GCRO did not fill its recycled subspace";
+   // Recycling should pay off over a sequence of nearby systems
+   const int iters_rec = GCRORecycleIters(5);
+   const int iters_norec = GCRORecycleIters(0);
+   std::cout << iters_rec << " " << iters_norec << std::endl;
+   EXPECT_LT(iters_rec, iters_norec) << "GCRO recycling did not reduce our iteration counts";
+}
+
+TEST(exaconstit, amg_reuse)
+{
+   int nreuse = 0;
+   double difference = ExaBoomerAMGReuseTest(nreuse);
+   std::cout << difference << std::endl;
+   EXPECT_LT(fabs(difference), 1.0e-9) << "PCG with our reused AMG hierarchy did not converge";
+   EXPECT_EQ(nreuse, 2) << "Our AMG hierarchy was not reused for the later operators";
+}
+
+TEST(exaconstit, mesh_reorder)
+{
+   bool permuted = false;
+   int nbad = MeshReorderTest(ElementOrdering::MORTON, permuted);
+   EXPECT_TRUE(permuted) << "Morton ordering did not reorder our elements";
+   EXPECT_EQ(nbad, 0) << "Grain ids or state variables did not follow the Morton reordered elements";
+   nbad = MeshReorderTest(ElementOrdering::HILBERT, permuted);
+   EXPECT_TRUE(permuted) << "Hilbert ordering did not reorder our elements";
+   EXPECT_EQ(nbad, 0) << "Grain ids or state variables did not follow the Hilbert reordered elements";
+}
+
+TEST(exaconstit, auto_dt_rollback)
+{
+   double dt_diff = 1.0;
+   double time_diff = 1.0;
+   double difference = AutoDtRollbackTest(dt_diff, time_diff);
+   std::cout << difference << std::endl;
+   EXPECT_EQ(difference, 0.0) << "Rolling back a failed step did not restore the saved state";
+   EXPECT_LT(dt_diff, 1.0e-15) << "Rolling back failed steps did not cut dt";
+   EXPECT_LT(time_diff, 1.0e-15) << "Our time drifted over consecutive cuts of a step";
+   // Once we're at dt_min there's nothing left to cut, and the step is accepted as is
+   double dt = 0.04;
+   double t = 1.04;
+   EXPECT_TRUE(SystemDriver::CutTimeStep(1.0, 0.25, 0.02, dt, t)) << "dt was not cut";
+   EXPECT_EQ(dt, 0.02) << "dt was cut below dt_min";
+   EXPECT_EQ(t, 1.0 + 0.02) << "Our time does not follow the cut dt";
+   EXPECT_FALSE(SystemDriver::CutTimeStep(1.0, 0.25, 0.02, dt, t)) << "dt was cut below dt_min";
+   EXPECT_EQ(t, 1.0 + 0.02) << "Our time changed without a cut";
 }
 
 int main(int argc, char *argv[])
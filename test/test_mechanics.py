@@ -8,7 +8,7 @@ import numpy as np
 import unittest
 from sys import platform
 
-def check_stress(ans_pwd, test_pwd, test_case):
+def check_stress(ans_pwd, test_pwd, test_case, tol=1.0e-10):
     answers = []
     tests = []
     with open(ans_pwd) as csvfile:
@@ -26,7 +26,7 @@ def check_stress(ans_pwd, test_pwd, test_case):
         for a, t in zip(ans, test):
             err += abs(float(a) - float(t))
     err = err / i
-    if (err > 1.0e-10):
+    if (err > tol):
         raise ValueError("The following test case failed: ", test_case)
     return True
 
@@ -40,18 +40,26 @@ def runSystemCommands(params):
     ans_pwd = pwd.rstrip() + '/' + ans
     tresult = test.split(".")[0]
     test_pwd = pwd.rstrip() + '/test_'+tresult+'_stress.txt'
-    check_stress(ans_pwd, test_pwd, test)
+    check_stress(ans_pwd, test_pwd, test, test_tols.get(test, 1.0e-10))
     cmd = 'rm ' + pwd.rstrip() + '/test_'+tresult+'_stress.txt'
     subprocess.run(cmd.rstrip(), stdout=subprocess.PIPE, shell=True)
     return True
 
+# Cases that are compared against the answers of another case rather than their own.
+# Reordering our elements changes the order of our floating point sums, so the Newton
+# iterates differ by round-off and the stresses are only expected to agree to about
+# 1e-6 of their magnitudes, which are ~1e-2 here.
+test_tols = {"voce_full_morton.toml" : 1.0e-8}
+
 def run():
     test_cases = ["voce_pa.toml", "voce_full.toml", "voce_nl_full.toml",
-                "voce_bcc.toml", "voce_full_cyclic.toml", "mtsdd_bcc.toml", "mtsdd_full.toml", "mtsdd_full_auto.toml"]
+                "voce_bcc.toml", "voce_full_cyclic.toml", "mtsdd_bcc.toml", "mtsdd_full.toml", "mtsdd_full_auto.toml",
+                "voce_full_morton.toml"]
 
     test_results = ["voce_pa_stress.txt", "voce_full_stress.txt",
                     "voce_full_stress.txt", "voce_bcc_stress.txt", "voce_full_cyclic_stress.txt",
-                    "mtsdd_bcc_stress.txt", "mtsdd_full_stress.txt", "mtsdd_full_auto_stress.txt"]
+                    "mtsdd_bcc_stress.txt", "mtsdd_full_stress.txt", "mtsdd_full_auto_stress.txt",
+                    "voce_full_stress.txt"]
 
     result = subprocess.run('pwd', stdout=subprocess.PIPE)
 